@@ -0,0 +1,120 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchIoUtils.h"
+#include "../util/ioutils.h"
+#include <QElapsedTimer>
+#include <QRegExp>
+#include <QStringList>
+#include <cstdio>
+
+namespace bench {
+
+Transcript generateMwc713Output( int sizeBytes ) {
+    const QByteArray header = "\x1b[1m\x1b[36mTransaction Log - Account 'default' - Block Height: 117749\x1b[0m\n"
+            "--------------------------------------------------------------------------------------------------------------\n"
+            " Id  Type         Shared Transaction Id               Address  Creation Time        Confirmed?  Amount    \n"
+            "==============================================================================================================\n";
+    QByteArray res = header;
+    int idx = 0;
+    while (res.size() < sizeBytes) {
+        QByteArray id = QByteArray::number(idx++);
+        res += " \x1b[1m\x1b[37m" + id + "\x1b[0m   Received Tx  \x1b[32mb2822262-4760-4907-923f-e2459ed5d554\x1b[0m  "
+               "xmgEvZ4MCCGMJnRnNXKHBbHmSGWQchNr9uZpY5J1XXnsCFS45fsU  2019-10-16 23:46:09  \x1b[32myes\x1b[0m  1.000000000\r\n"
+               "------------------------------------------------------------------------------------------------------------\n";
+        if (idx % 50 == 0)
+            res += "wallet713> <<+)mwc713(+>>";
+    }
+    return Transcript{"generated mwc713", res};
+}
+
+Transcript generateMwcNodeOutput( int sizeBytes ) {
+    QByteArray res;
+    int height = 117000;
+    while (res.size() < sizeBytes) {
+        QByteArray h = QByteArray::number(height++);
+        res += "20191011 17:58:38.254 \x1b[32mINFO\x1b[0m grin_servers::common::adapters - Received 32 block headers from 3.226.135.253:13414, height " + h + "\n"
+               "20191011 17:58:38.301 \x1b[34mDEBUG\x1b[0m grin_chain::chain - process_block_single: " + h + " at 2019-10-11 17:58:38 UTC\n"
+               "20191011 17:58:38.388 \x1b[33mWARN\x1b[0m grin_servers::grin::sync::syncer - sync: total_difficulty 365479725, peer_difficulty 365481100\n";
+    }
+    return Transcript{"generated mwc-node", res, SOURCE::MWC_NODE};
+}
+
+// The way mwc713 output was processed before OutputReader
+static int legacyProcess( const QByteArray & chunk ) {
+    QByteArray filtered;
+    bool inEsc = false;
+    for (char d : chunk) {
+        if (d==27)
+            inEsc = true;
+        if (!inEsc)
+            filtered.append( d );
+        if (d=='m')
+            inEsc=false;
+    }
+
+    QString str(filtered);
+    auto lns = str.split(QRegExp("[\r\n]"),QString::SkipEmptyParts);
+    return lns.size();
+}
+
+static void report( const char * name, int64_t bytes, qint64 nsec, int64_t lines ) {
+    double sec = double(std::max(nsec, qint64(1))) / 1e9;
+    printf( "    %-16s %10.1f MB/s   lines: %lld\n", name, double(bytes)/sec/1e6, (long long)lines );
+}
+
+void benchOutputFilter( const QVector<Transcript> & transcripts, int chunkSize ) {
+    using namespace ioutils;
+    const SIMD_LEVEL bestLevel = getSimdLevel();
+    const int repeat = 5;
+
+    printf("Output filter, chunk size %d bytes\n", chunkSize);
+
+    for ( const auto & tr : transcripts ) {
+        printf("  %s, %d bytes\n", tr.name.toUtf8().constData(), tr.data.size());
+        const int64_t bytes = int64_t(tr.data.size()) * repeat;
+
+        {
+            QElapsedTimer timer;
+            timer.start();
+            int64_t lines = 0;
+            for ( int r=0; r<repeat; r++ ) {
+                for ( int pos=0; pos<tr.data.size(); pos+=chunkSize )
+                    lines += legacyProcess( tr.data.mid(pos, chunkSize) );
+            }
+            report( "original", bytes, timer.nsecsElapsed(), lines );
+        }
+
+        const char * levelNames[] = {"scalar", "sse2", "avx2"};
+        for ( int lvl = int(SIMD_LEVEL::SCALAR); lvl <= int(bestLevel); lvl++ ) {
+            setSimdLevel( SIMD_LEVEL(lvl) );
+            OutputReader reader("wallet713>");
+
+            QElapsedTimer timer;
+            timer.start();
+            int64_t lines = 0;
+            for ( int r=0; r<repeat; r++ ) {
+                for ( int pos=0; pos<tr.data.size(); pos+=chunkSize ) {
+                    reader.process( tr.data.constData()+pos, std::min(chunkSize, tr.data.size()-pos) );
+                    lines += reader.getLineEnds().size();
+                }
+            }
+            report( levelNames[lvl], bytes, timer.nsecsElapsed(), lines );
+        }
+    }
+
+    setSimdLevel(bestLevel);
+}
+
+}
@@ -0,0 +1,45 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_BENCHIOUTILS_H
+#define MWC_QT_WALLET_BENCHIOUTILS_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+namespace bench {
+
+// Process that printed the output
+enum class SOURCE { MWC713, MWC_NODE };
+
+// Recorded or generated process output
+struct Transcript {
+    QString    name;
+    QByteArray data;
+    SOURCE     source = SOURCE::MWC713;
+};
+
+// Generate output that looks like mwc713 (colored txs/outputs tables, prompts) and mwc-node logs.
+// Used when no recorded output was provided
+Transcript generateMwc713Output( int sizeBytes );
+Transcript generateMwcNodeOutput( int sizeBytes );
+
+// Compare stdout processing: original FilterEscSymbols + QString + regex split with
+// ioutils::OutputReader at every supported SIMD level.
+void benchOutputFilter( const QVector<Transcript> & transcripts, int chunkSize );
+
+}
+
+#endif //MWC_QT_WALLET_BENCHIOUTILS_H
@@ -0,0 +1,26 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Parsers are logging the results. Benchmarks are measuring parsing, so the logs are dropped.
+// util/Log.cpp can't be used here, it depends on GUI.
+
+#include "../util/Log.h"
+
+namespace logger {
+
+void logParsingEvent(wallet::WALLET_EVENTS event, QString message ) { Q_UNUSED(event); Q_UNUSED(message); }
+void logNodeEvent( tries::NODE_OUTPUT_EVENT event, QString message ) { Q_UNUSED(event); Q_UNUSED(message); }
+void logInfo(QString who, QString message) { Q_UNUSED(who); Q_UNUSED(message); }
+
+}
@@ -0,0 +1,250 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchParsers.h"
+#include "../util/ioutils.h"
+#include "../tries/mwc713inputparser.h"
+#include "../tries/NodeOutputParser.h"
+#include "../tries/baseparser.h"
+#include <QElapsedTimer>
+#include <cstdio>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace bench {
+
+// Prompt that wallet configure for mwc713
+static const QByteArray MWC713_PROMPT = "<<+)mwc713(+>>wallet713> ";
+
+Transcript generateMwc713Session( int txRows ) {
+    QByteArray res;
+
+    // login
+    res += "\x1b[1mWelcome to wallet713 for MWC v2.2.0\x1b[0m\n"
+           "\n"
+           "Unlock your existing wallet or type `init` to initiate a new one\n"
+           "Use `help` to see available commands\n"
+           "\n" + MWC713_PROMPT + "\n";
+    res += "starting mwcmqs listener...\n"
+           "\x1b[33mmwcmqs listener started for: [xmgEvZ4MCCGMJnRnNXKHBbHmSGWQchNr9uZpY5J1XXnsCFS45fsU] tid=[2dTRLSNewAbWkHbJJm7Ay]\x1b[0m\n"
+           "Your mwcmq address: xmgEvZ4MCCGMJnRnNXKHBbHmSGWQchNr9uZpY5J1XXnsCFS45fsU\n"
+           + MWC713_PROMPT + "\n";
+
+    // accounts
+    res += "\n"
+           "____ Wallet Accounts ____\n"
+           "\n"
+           " Name     | Parent BIP-32 Derivation Path \n"
+           "----------+-------------------------------\n"
+           " default  | m/0/0 \n"
+           " savings  | m/1/0 \n"
+           " mining   | m/2/0 \n"
+           "\n" + MWC713_PROMPT + "\n";
+
+    // info
+    res += "\n"
+           "____ Wallet Summary Info - Account 'default' as of height 117749 ____\n"
+           "\n"
+           " Total                            | 1254.200000000 \n"
+           " Awaiting Confirmation (< 10)     | 0.000000000 \n"
+           " Immature Coinbase (< 1440)       | 0.000000000 \n"
+           " Locked by previous transaction   | 12.000000000 \n"
+           " -------------------------------- | ------------- \n"
+           " Currently Spendable              | 1242.200000000 \n"
+           "\n" + MWC713_PROMPT + "\n";
+
+    // txs
+    res += "\n"
+           "\x1b[1m\x1b[36mTransaction Log - Account 'default' - Block Height: 117749\x1b[0m\n"
+           "-------------------------------------------------------------------------------------------------------------------------------------\n"
+           " Id  Type         Shared Transaction Id               Address                                              Creation Time        Confirmed?  Confirmation Time    Net Difference  Proof \n"
+           "=====================================================================================================================================\n";
+    for ( int i=0; i<txRows; i++ ) {
+        const QByteArray id = QByteArray::number(i);
+        const char * type = (i%7==0) ? "Sent Tx     " : ((i%31==0) ? "Cancelled   " : "Received Tx ");
+        res += " \x1b[1m\x1b[37m" + id + "\x1b[0m   " + type + " \x1b[32mb2822262-4760-4907-923f-e2459ed5d554\x1b[0m  "
+               "xmgEvZ4MCCGMJnRnNXKHBbHmSGWQchNr9uZpY5J1XXnsCFS45fsU  2019-10-16 23:46:09  \x1b[32myes\x1b[0m         2019-10-16 23:48:12  "
+               + QByteArray(i%7==0 ? "-1.008000000" : "1.000000000") + "     no \r\n"
+               "-------------------------------------------------------------------------------------------------------------------------------------\n";
+    }
+    res += "\n" + MWC713_PROMPT + "\n";
+
+    return Transcript{"mwc713 session, txs " + QString::number(txRows) + " rows", res, SOURCE::MWC713};
+}
+
+Transcript generateMwcNodeSync( int blocks ) {
+    QByteArray res;
+    const int archiveHeight = 117000;
+
+    res += "20191011 17:33:27.495 \x1b[33mWARN\x1b[0m grin_servers::grin::server - MWC server started.\n"
+           "20191011 17:33:27.501 \x1b[32mINFO\x1b[0m grin_servers::grin::sync::syncer - Waiting for the peers\n"
+           "20191011 17:33:27.502 \x1b[34mDEBUG\x1b[0m grin_chain::chain - init: sync_head: 1 @ 0 [0099c40fb902]\n";
+
+    // Headers come by 32
+    for ( int h=32; h <= archiveHeight+blocks; h+=32 ) {
+        res += "20191011 17:58:38.254 \x1b[32mINFO\x1b[0m grin_servers::common::adapters - Received 32 block headers from 3.226.135.253:13414, height " + QByteArray::number(h) + "\n"
+               "20191011 17:58:38.301 \x1b[34mDEBUG\x1b[0m grin_chain::txhashset::txhashset - sync_head: " + QByteArray::number(h) + ", 0a78e3f9d6c5\n";
+    }
+
+    res += "20191011 17:59:10.411 \x1b[32mINFO\x1b[0m grin_p2p::peer - Asking 3.226.135.253:13414 for txhashset archive at 117000 0a78e3f9d6c5.\n"
+           "20191011 17:59:14.101 \x1b[32mINFO\x1b[0m grin_p2p::protocol - handle_payload: txhashset archive for 0a78e3f9d6c5 at 117000. size=128918334\n";
+    for ( int v=1000; v<=72000; v+=1000 )
+        res += "20191011 18:05:07.045 \x1b[32mINFO\x1b[0m grin_chain::txhashset::txhashset - txhashset: verify_rangeproofs: verified " + QByteArray::number(v) + " rangeproofs\n";
+    for ( int v=1000; v<=61000; v+=1000 )
+        res += "20191011 18:07:37.377 \x1b[32mINFO\x1b[0m grin_chain::txhashset::txhashset - txhashset: verify_kernel_signatures: verified " + QByteArray::number(v) + " signatures\n";
+    res += "20191012 10:27:49.337 \x1b[32mINFO\x1b[0m grin_p2p::protocol - handle_payload: txhashset archive for 0a78e3f9d6c5 at 117000, DONE. Data Ok: true\n";
+
+    for ( int b=1; b<=blocks; b++ ) {
+        const QByteArray h = QByteArray::number(archiveHeight+b);
+        res += "20191011 18:09:52.536 \x1b[32mINFO\x1b[0m grin_servers::common::adapters - Received block 140e019e22d0 at " + h + " from 52.13.204.202:13414 [in/out/kern: 0/1/1] going to process.\n"
+               "20191011 18:09:52.601 \x1b[34mDEBUG\x1b[0m grin_chain::chain - process_block_single: " + h + " at 2019-10-11 17:58:38 UTC\n"
+               "20191011 18:09:52.622 \x1b[34mDEBUG\x1b[0m grin_chain::pipe - pipe: process_block 140e019e22d0 at " + h + " [in/out/kern: 0/1/1]\n";
+    }
+
+    res += "20191011 18:15:44.002 \x1b[32mINFO\x1b[0m grin_servers::grin::sync::syncer - synchronized at 365444412 @ " +
+           QByteArray::number(archiveHeight+blocks) + " [0d4879faafaa]\n";
+
+    return Transcript{"mwc-node fast sync, " + QString::number(blocks) + " blocks", res, SOURCE::MWC_NODE};
+}
+
+// Process peak RSS in KB
+static int64_t getPeakRssKb() {
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return -1;
+    return int64_t(pmc.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+#ifdef Q_OS_DARWIN
+    return int64_t(usage.ru_maxrss / 1024); // bytes at mac
+#else
+    return int64_t(usage.ru_maxrss);
+#endif
+#endif
+}
+
+// Mwc713InputParser without events delivery, only the InputParser work
+class Mwc713ParserEngine : public tries::Mwc713InputParser {
+public:
+    int process(const char * utf8, int size) { return parser.processInput(utf8, size).size(); }
+};
+
+class NodeParserEngine : public tries::NodeOutputParser {
+public:
+    int process(const char * utf8, int size) { return parser.processInput(utf8, size).size(); }
+};
+
+struct ParserRun {
+    int64_t bytes = 0;
+    int64_t events = 0;
+    int64_t allocations = 0;
+    qint64  nsec = 0;
+};
+
+static void report( const char * name, const ParserRun & run ) {
+    double sec = double(std::max(run.nsec, qint64(1))) / 1e9;
+    double kb = double(std::max(run.bytes, int64_t(1))) / 1024.0;
+    printf( "    %-8s %8.1f MB/s  %10.0f events/s  %7.2f allocations/KB  events: %lld\n", name,
+            double(run.bytes)/sec/1e6, double(run.events)/sec, double(run.allocations)/kb, (long long)run.events );
+}
+
+// Feed the transcript by chunks into OutputReader, pass the filtered data to 'parse'. Parsers are created
+// by the caller, so the time to build the automaton is not included.
+template <class PARSE>
+static ParserRun replay( const Transcript & tr, int chunkSize, const QByteArray & linePrefix, PARSE parse ) {
+    ioutils::OutputReader reader(linePrefix);
+    ParserRun run;
+    run.bytes = tr.data.size();
+
+    const int64_t allocations = tries::getAllocationCounter();
+    QElapsedTimer timer;
+    timer.start();
+    for ( int pos=0; pos<tr.data.size(); pos+=chunkSize ) {
+        int size = reader.process( tr.data.constData()+pos, std::min(chunkSize, tr.data.size()-pos) );
+        if (size>0)
+            run.events += parse( reader.getData(), size );
+    }
+    run.nsec = timer.nsecsElapsed();
+    run.allocations = tries::getAllocationCounter() - allocations;
+    return run;
+}
+
+static void benchMwc713( const Transcript & tr, int chunkSize ) {
+    {
+        Mwc713ParserEngine engine;
+        engine.process("\n", 1); // Build the automaton
+        report( "engine", replay( tr, chunkSize, "wallet713>", [&engine](const char * data, int size) {
+            return engine.process(data, size);
+        } ) );
+    }
+    {
+        tries::Mwc713InputParser parser;
+        parser.processInput("\n", 1);
+        int64_t events = 0;
+        QObject::connect( &parser, &tries::Mwc713InputParser::sgEvents, [&events](const QVector<wallet::WEvent> & evts) {
+            events += evts.size();
+        } );
+        report( "full", replay( tr, chunkSize, "wallet713>", [&parser, &events](const char * data, int size) {
+            events = 0;
+            parser.processInput(data, size);
+            return events;
+        } ) );
+    }
+}
+
+static void benchNode( const Transcript & tr, int chunkSize ) {
+    {
+        NodeParserEngine engine;
+        engine.process("\n", 1);
+        report( "engine", replay( tr, chunkSize, QByteArray(), [&engine](const char * data, int size) {
+            return engine.process(data, size);
+        } ) );
+    }
+    {
+        tries::NodeOutputParser parser;
+        parser.processInput("\n", 1);
+        int64_t events = 0;
+        QObject::connect( &parser, &tries::NodeOutputParser::nodeOutputGenericEvent, [&events](tries::NODE_OUTPUT_EVENT, QString) {
+            events++;
+        } );
+        report( "full", replay( tr, chunkSize, QByteArray(), [&parser, &events](const char * data, int size) {
+            events = 0;
+            parser.processInput(data, size);
+            return events;
+        } ) );
+    }
+}
+
+void benchParsers( const QVector<Transcript> & transcripts, int chunkSize ) {
+    printf("Parsers, chunk size %d bytes\n", chunkSize);
+
+    for ( const auto & tr : transcripts ) {
+        printf("  %s, %d bytes\n", tr.name.toUtf8().constData(), tr.data.size());
+        if (tr.source == SOURCE::MWC_NODE)
+            benchNode(tr, chunkSize);
+        else
+            benchMwc713(tr, chunkSize);
+        printf("    peak RSS %lld KB\n", (long long)getPeakRssKb());
+    }
+}
+
+}
@@ -0,0 +1,35 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_BENCHPARSERS_H
+#define MWC_QT_WALLET_BENCHPARSERS_H
+
+#include "benchIoUtils.h"
+
+namespace bench {
+
+// mwc713 session as the wallet see it: login with listener start, 'accounts', 'info' and 'txs' with txRows rows
+Transcript generateMwc713Session( int txRows );
+// mwc-node fast sync log: headers download, txhashset archive, blocks processing up to 'blocks' from the archive
+Transcript generateMwcNodeSync( int blocks );
+
+// Replay transcripts through the OutputReader and parser the same way as the wallet does:
+// data is fed by chunks of chunkSize bytes. Reports MB/s, events/s, parsing engine
+// allocations per KB and the process peak RSS.
+// Engine - tries::InputParser only. Full - Mwc713InputParser/NodeOutputParser with events delivery.
+void benchParsers( const QVector<Transcript> & transcripts, int chunkSize );
+
+}
+
+#endif //MWC_QT_WALLET_BENCHPARSERS_H
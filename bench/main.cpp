@@ -0,0 +1,99 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Standalone benchmarks for the wallet internals. No GUI, no running mwc713 or mwc-node needed.
+//
+// Usage: mwc-bench [--chunk <bytes>]... [--rows <txs rows>]... [--blocks <node blocks>]... [[--node] recorded_output_file ...]
+// Recorded output can be taken from the mwc713 or mwc-node stdout, mwc-node output file must follow --node.
+// Without files the generated output is used: mwc713 sessions with 1k/10k/100k txs rows, mwc-node fast sync.
+// --rows and --blocks define the scale of generated output. Multiple --chunk values run the benchmarks for every size.
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QStringList>
+#include <cstdio>
+#include "benchIoUtils.h"
+#include "benchParsers.h"
+
+// Parsers are printing every result with qDebug, it is not a part of the parsing
+static void dropDebugMessages(QtMsgType type, const QMessageLogContext & context, const QString & msg) {
+    Q_UNUSED(context);
+    if (type != QtDebugMsg)
+        fprintf(stderr, "%s\n", msg.toLocal8Bit().constData());
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    qInstallMessageHandler(dropDebugMessages);
+
+    QVector<int> chunkSizes;
+    QVector<int> txRows;
+    QVector<int> nodeBlocks;
+    QVector<bench::Transcript> transcripts;
+
+    QStringList args = app.arguments();
+    for ( int i=1; i<args.size(); i++ ) {
+        if ( args[i] == "--chunk" && i+1<args.size() ) {
+            chunkSizes.push_back( std::max(1, args[++i].toInt()) );
+            continue;
+        }
+        if ( args[i] == "--rows" && i+1<args.size() ) {
+            txRows.push_back( std::max(0, args[++i].toInt()) );
+            continue;
+        }
+        if ( args[i] == "--blocks" && i+1<args.size() ) {
+            nodeBlocks.push_back( std::max(0, args[++i].toInt()) );
+            continue;
+        }
+
+        bench::SOURCE source = bench::SOURCE::MWC713;
+        if ( args[i] == "--node" && i+1<args.size() ) {
+            source = bench::SOURCE::MWC_NODE;
+            i++;
+        }
+
+        QFile file(args[i]);
+        if (!file.open(QIODevice::ReadOnly)) {
+            printf("Unable to read %s\n", args[i].toUtf8().constData());
+            return 1;
+        }
+        transcripts.push_back( bench::Transcript{args[i], file.readAll(), source} );
+    }
+
+    // QProcess delivers stdout by the pipe buffer portions. Typical are 4K and 16K
+    if (chunkSizes.isEmpty())
+        chunkSizes = {4096, 16384};
+
+    if (transcripts.isEmpty() && txRows.isEmpty() && nodeBlocks.isEmpty()) {
+        txRows = {1000, 10000, 100000};
+        nodeBlocks = {20000};
+    }
+
+    QVector<bench::Transcript> filterTranscripts = transcripts;
+    if (filterTranscripts.isEmpty()) {
+        filterTranscripts.push_back( bench::generateMwc713Output(8*1024*1024) );
+        filterTranscripts.push_back( bench::generateMwcNodeOutput(8*1024*1024) );
+    }
+
+    for ( int rows : txRows )
+        transcripts.push_back( bench::generateMwc713Session(rows) );
+    for ( int blocks : nodeBlocks )
+        transcripts.push_back( bench::generateMwcNodeSync(blocks) );
+
+    for ( int chunkSize : chunkSizes ) {
+        bench::benchOutputFilter( filterTranscripts, chunkSize );
+        bench::benchParsers( transcripts, chunkSize );
+    }
+    return 0;
+}
@@ -0,0 +1,30 @@
+# Standalone benchmarks for mwc-qt-wallet internals. Console app, no GUI.
+# Main project mwc-qt-wallet.pro excludes this directory.
+
+QT       += core
+QT       -= gui
+
+TARGET = mwc-bench
+TEMPLATE = app
+CONFIG += console c++14
+CONFIG -= app_bundle
+
+INCLUDEPATH += ..
+
+SOURCES += $$files(*.cpp) \
+    $$files(../tries/*.cpp) \
+    ../util/ioutils.cpp \
+    ../core/mwcexception.cpp \
+    ../core/Config.cpp \
+    ../wallet/mwc713wevent.cpp \
+    ../util/Trace.cpp
+
+# Only parsers need moc. Don't add wallet headers here, they declare classes that are not linked
+HEADERS += $$files(*.h) \
+    $$files(../tries/*.h) \
+    ../util/ioutils.h \
+    ../core/mwcexception.h \
+    ../core/Config.h \
+    ../util/Trace.h
+
+win32: LIBS += -lpsapi
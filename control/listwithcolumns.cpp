@@ -138,6 +138,34 @@ void ListWithColumns::appendRow( const QVector<QString> & rowData, double select
     }
 }
 
+void ListWithColumns::updateRow( int row, const QVector<QString> & rowData ) {
+    Q_ASSERT(rowData.size() == columnCount() );
+    Q_ASSERT(row>=0 && row<rowCount());
+
+    int sz = rowData.size();
+    for ( int i=0; i<sz; i++ ) {
+        QTableWidgetItem * itm = item(row, i);
+        if (itm!=nullptr && itm->text() != rowData[i])
+            itm->setText( rowData[i] );
+    }
+}
+
+void ListWithColumns::removeDataRow( int row ) {
+    Q_ASSERT(row>=0 && row<rowCount());
+    removeRow(row);
+
+    int rows = rowCount();
+    int cols = columnCount();
+    for ( int r=row; r<rows; r++ ) {
+        QBrush brush( r % 2 == 0 ? bkColor1 : bkColor2 );
+        for ( int c=0; c<cols; c++ ) {
+            QTableWidgetItem * itm = item(r, c);
+            if (itm!=nullptr)
+                itm->setBackground( brush );
+        }
+    }
+}
+
 int ListWithColumns::getSelectedRow() const {
     QList<QTableWidgetItem *> selItms = selectedItems();
     if (selItms.size() == 0)
@@ -54,6 +54,11 @@ public:
     // >=1 - highlight a lot
     void appendRow( const QVector<QString> & rowData, double selection = -1.0 );
 
+    // Update the text of the existing row. Colors stay the same
+    void updateRow( int row, const QVector<QString> & rowData );
+    // Remove the row, stripe colors for the rows below are restored
+    void removeDataRow( int row );
+
 protected:
     void setListLook();
 
@@ -18,6 +18,7 @@
 #include <QTextStream>
 #include <QDataStream>
 #include <QDir>
+#include <QDebug>
 #include "../control/messagebox.h"
 #include "../core/global.h"
 #include <QtAlgorithms>
@@ -26,6 +27,7 @@ namespace core {
 
 const static QString settingsFileName("context.dat");
 const static QString airdropRequestsFileName("requests.dat");
+const static QString taskLatencyFileName("latency.dat");
 
 
 void SendCoinsParams::saveData(QDataStream & out) const {
@@ -281,6 +283,35 @@ QVector<state::AirdropRequests> AppContext::loadAirdropRequests() const {
     return res;
 }
 
+void AppContext::saveTaskLatencyStats( const wallet::TaskLatencyStats & stats ) const {
+    QString dataPath = ioutils::getAppDataPath("context");
+
+    // Statistic is not critical, no reasons to bother user with error
+    QFile file(dataPath + "/" + taskLatencyFileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Unable to save task latency statistic to " << file.fileName() << " Error: " << file.errorString();
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_7);
+    stats.saveData(out);
+}
+
+void AppContext::loadTaskLatencyStats( wallet::TaskLatencyStats & stats ) const {
+    QString dataPath = ioutils::getAppDataPath("context");
+
+    QFile file(dataPath + "/" + taskLatencyFileName);
+    if ( !file.open(QIODevice::ReadOnly) ) {
+        // first run, no file exist
+        return;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_7);
+    stats.loadData(in);
+}
+
 
 // -------------- Contacts
 
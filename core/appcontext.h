@@ -19,6 +19,7 @@
 #include "../state/state.h"
 #include "../state/m_airdrop.h"
 #include "../wallet/wallet.h"
+#include "../wallet/tasklatency.h"
 
 class QAction;
 
@@ -116,6 +117,10 @@ public:
     void saveAirdropRequests( const QVector<state::AirdropRequests> & data );
     QVector<state::AirdropRequests> loadAirdropRequests() const;
 
+    // mwc713 commands execution time. Stored separately, it is updated often
+    void saveTaskLatencyStats( const wallet::TaskLatencyStats & stats ) const;
+    void loadTaskLatencyStats( wallet::TaskLatencyStats & stats ) const;
+
     // -------------- Contacts
     // Get the contacts
     QVector<ContactRecord> getContacts() const {return contactList;}
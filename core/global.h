@@ -64,6 +64,7 @@ const QString BLOCK_EXPLORER_URL_FLOONET = "explorer.floonet.mwc.mw";
 //////////////////////////////
 // Page Names
 
+const QString PAGE_A_STARTING       = "Starting";
 const QString PAGE_A_ACCOUNT_LOGIN  = "Login into Wallet";
 const QString PAGE_A_ACCOUNT_UNLOCK = "Unlock Wallet";
 const QString PAGE_A_INIT_ACCOUNT   = "Init a new Wallet";
@@ -21,6 +21,7 @@
 #include "../windows/c_enterseed.h"
 #include "../core/global.h"
 #include "../build_version.h"
+#include "../util/Trace.h"
 
 namespace core {
 
@@ -41,6 +42,10 @@ QWidget * WindowManager::switchToWindowEx( const QString & pageName, QWidget * n
     if (currentWnd==newWindow)
         return newWindow;
 
+    trace::Scope traceScope("window", "switchToWindow");
+    if (traceScope.isActive())
+        traceScope.setArgs( trace::arg("page", pageName) );
+
     if (currentWnd!=nullptr) {
         currentWnd->close();
         currentWnd = nullptr;
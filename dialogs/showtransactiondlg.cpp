@@ -15,7 +15,7 @@ ShowTransactionDlg::ShowTransactionDlg(QWidget *parent,  const wallet::WalletTra
     ui->type->setText( transaction.getTypeAsStr() );
     ui->id->setText( transaction.txid );
     ui->address->setText(transaction.address);
-    ui->time->setText(transaction.confirmationTime);
+    ui->time->setText(transaction.getConfirmationTime());
     ui->mwc->setText( util::nano2one( transaction.coinNano ) );
     ui->confirm->setText( transaction.confirmed ? "Yes" : "No" );
 }
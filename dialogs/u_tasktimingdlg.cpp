@@ -0,0 +1,74 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dialogs/u_tasktimingdlg.h"
+#include "ui_u_tasktimingdlg.h"
+#include "../control/messagebox.h"
+#include <QFileDialog>
+#include <QFontDatabase>
+#include <QJsonDocument>
+#include <QDir>
+#include <QFile>
+
+namespace dlg {
+
+TaskTimingDlg::TaskTimingDlg(QWidget *parent, wallet::Wallet * _wallet) :
+    control::MwcDialog(parent),
+    ui(new Ui::TaskTimingDlg),
+    wallet(_wallet)
+{
+    ui->setupUi(this);
+
+    // Table is aligned with spaces
+    ui->timingEdit->setFont( QFontDatabase::systemFont(QFontDatabase::FixedFont) );
+
+    on_refreshButton_clicked();
+}
+
+TaskTimingDlg::~TaskTimingDlg()
+{
+    delete ui;
+}
+
+void TaskTimingDlg::on_refreshButton_clicked()
+{
+    wallet::TaskTimingStats stats = wallet->getTaskTimingStats();
+    ui->timingEdit->setPlainText( stats.isEmpty() ? "No tasks was executed yet" : stats.toString() );
+}
+
+void TaskTimingDlg::on_saveButton_clicked()
+{
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Save task timing"),
+                                                    QDir::homePath(),
+                                                    tr("JSON (*.json)"));
+    if (fileName.length()==0)
+        return;
+
+    if (!fileName.endsWith(".json"))
+        fileName += ".json";
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        control::MessageBox::messageText(this, "ERROR", "Unable to save task timing to " + fileName + "\nError: " + file.errorString());
+        return;
+    }
+    file.write( QJsonDocument( wallet->getTaskTimingStats().toJson() ).toJson() );
+}
+
+void TaskTimingDlg::on_okButton_clicked()
+{
+    accept();
+}
+
+}
@@ -0,0 +1,49 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef U_TASKTIMINGDLG_H
+#define U_TASKTIMINGDLG_H
+
+#include <QDialog>
+#include "../wallet/wallet.h"
+#include "../control/mwcdialog.h"
+
+namespace Ui {
+class TaskTimingDlg;
+}
+
+namespace dlg {
+
+// Diagnostics: where the time of the wallet tasks goes. Can be saved as JSON
+class TaskTimingDlg : public control::MwcDialog
+{
+    Q_OBJECT
+
+public:
+    explicit TaskTimingDlg(QWidget *parent, wallet::Wallet * wallet );
+    ~TaskTimingDlg();
+
+private slots:
+    void on_refreshButton_clicked();
+    void on_saveButton_clicked();
+    void on_okButton_clicked();
+
+private:
+    Ui::TaskTimingDlg *ui;
+    wallet::Wallet * wallet;
+};
+
+}
+
+#endif // U_TASKTIMINGDLG_H
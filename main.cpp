@@ -29,6 +29,7 @@
 #include "util/Log.h"
 #include "core/Config.h"
 #include "util/ConfigReader.h"
+#include "util/Trace.h"
 #include <QFileDevice>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -51,6 +52,15 @@
 #include "tests/testWordSequenser.h"
 #include "tests/testWordDictionary.h"
 #include "tests/testPasswordAnalyser.h"
+#include "tests/testTries.h"
+#include "tests/testIoUtils.h"
+#include "tests/testSpscQueue.h"
+#include "tests/testTaskLatency.h"
+#include "tests/testEventRouting.h"
+#include "tests/testTxCache.h"
+#include "tests/testUtxoCache.h"
+#include "tests/testWalletColumns.h"
+#include "tests/testTxQuery.h"
 #include "misk/DictionaryInit.h"
 #include "util/stringutils.h"
 #include "build_version.h"
@@ -105,6 +115,10 @@ bool readConfig(QApplication & app) {
                                       "Path to the mwc-gui-wallet config ",
                                       "mwc713 path",
                                       ""},
+                      {{"t", "trace"},
+                                      "Write Chrome trace events into the file at exit",
+                                      "trace file",
+                                      ""},
                       });
 
     parser.process(app);
@@ -134,6 +148,12 @@ bool readConfig(QApplication & app) {
     bool useMwcMqS = reader.getString("useMwcMqS") != "false";  // Default expected to be 'true'
     QString sendTimeoutMsStr = reader.getString("send_online_timeout_ms");
 
+    QString traceFile = parser.value("trace");
+    if (traceFile.isEmpty())
+        traceFile = reader.getString("trace_file");
+    if (!traceFile.isEmpty())
+        trace::enable(traceFile);
+
     int sendTimeoutMs = sendTimeoutMsStr.toInt();
     if (sendTimeoutMs<=0)
         sendTimeoutMs = 60000; // 1 minutes should be good enough
@@ -190,6 +210,16 @@ int main(int argc, char *argv[])
     test::testWordSequences();
     test::testWordDictionary();
     test::testPasswordAnalyser();
+    test::testTrieAutomaton();
+    test::testOutputReader();
+    test::testSpscQueue();
+    test::testTaskLatency();
+    test::testEventRouting();
+    test::testTxCache();
+    test::testTransactionsDecoder();
+    test::testUtxoCache();
+    test::testWalletColumns();
+    test::testTxQuery();
 #endif
 
     int retVal = 0;
@@ -379,6 +409,8 @@ int main(int argc, char *argv[])
         mwc::setApplication(&app, mainWnd);
 
         wallet::MWC713 * wallet = new wallet::MWC713( config::getWallet713path(), config::getMwc713conf(), &appContext );
+        // mwc713 checks the wallet state while UI is constructed. StartWallet state will get the result
+        wallet->checkWalletInitialized();
 
         core::WindowManager * wndManager = new core::WindowManager( mainWnd, mainWnd->getMainWindow() );
 
@@ -407,6 +439,8 @@ int main(int argc, char *argv[])
 
         util::releaseAppGlobalLock();
 
+        trace::flush();
+
         break;
     }
 
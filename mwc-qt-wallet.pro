@@ -39,10 +39,12 @@ macx {
 SOURCES += $$files(*.cpp, true)
 SOURCES -= $$files(out/*.cpp, true)
 SOURCES -= $$files(VS/*.cpp, true)
+SOURCES -= $$files(bench/*.cpp, true)
 
 HEADERS += $$files(*.h, true)
 HEADERS -= $$files(out/*.h, true)
 HEADERS -= $$files(VS/*.h, true)
+HEADERS -= $$files(bench/*.h, true)
 
 FORMS += $$files(*.ui, true)
 
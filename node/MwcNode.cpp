@@ -20,6 +20,7 @@
 #include "../core/appcontext.h"
 #include "../core/global.h"
 #include "../core/Config.h"
+#include "../util/Trace.h"
 #include "../control/messagebox.h"
 #include "../core/Notification.h"
 #include "../util/Log.h"
@@ -46,12 +47,15 @@ MwcNode::MwcNode(const QString & _nodePath, core::AppContext * _appContext) :
 
     nwManager = new QNetworkAccessManager();
     connect( nwManager, &QNetworkAccessManager::finished, this, &MwcNode::replyFinished, Qt::QueuedConnection );
+
+    outputReader = new ioutils::OutputReader();
 }
 
 MwcNode::~MwcNode() {
     if (isRunning()) {
         stop();
     }
+    delete outputReader;
 }
 
 QString MwcNode::getLogsLocation() const {
@@ -65,7 +69,8 @@ void MwcNode::start(const QString & dataPath, const QString & network ) {
     lastUsedNetwork = network;
     nodeSecret = "";
     nodeWorkDir = "";
-    nonEmittedOutput = "";
+    nonEmittedOutput.clear();
+    outputReader->reset();
     lastProcessedEvent = tries::NODE_OUTPUT_EVENT::NONE;
     nodeStatusString = "Waiting";
 
@@ -293,33 +298,36 @@ void MwcNode::mwcNodeReadyReadStandardError() {
 
 void MwcNode::mwcNodeReadyReadStandardOutput() {
     if (nodeProcess) {
-        QString str( ioutils::FilterEscSymbols( nodeProcess->readAllStandardOutput() ) );
-        qDebug() << "Get output:" << str;
-        logger::logMwcNodeOut(str);
-        nodeOutputParser->processInput(str);
-
-        nonEmittedOutput += str;
-
-        QString ln;
-
-        for (int t=0; t<nonEmittedOutput.length(); t++) {
-            QChar ch = nonEmittedOutput[t];
-            if ( ch=='\r' || ch=='\n' ) {
-                if (!ln.isEmpty()) {
-                    emit onMwcOutputLine(ln);
-                    outputLines.push_front(ln);
-                    while( outputLines.size() > 10000 ) // List should be OK with that. It is optimized for head/tail ops.
-                        outputLines.pop_back();
-
-                    ln = "";
-                }
+        // Escapes are filtered out, new lines are normalized to '\n', empty lines are skipped.
+        int size = outputReader->read(nodeProcess);
+        if (size==0)
+            return;
+
+        const char * data = outputReader->getData();
+        qDebug() << "Get output:" << QByteArray::fromRawData(data, size);
+        logger::logMwcNodeOut( QString::fromUtf8(data, size) );
+        nodeOutputParser->processInput(data, size);
+
+        int lineStart = 0;
+        for ( int lineEnd : outputReader->getLineEnds() ) {
+            QString ln;
+            if (nonEmittedOutput.isEmpty()) {
+                ln = QString::fromUtf8( data + lineStart, lineEnd - lineStart );
             }
             else {
-                ln += ch;
+                nonEmittedOutput.append( data + lineStart, lineEnd - lineStart );
+                ln = QString::fromUtf8( nonEmittedOutput );
+                nonEmittedOutput.resize(0);
             }
+            lineStart = lineEnd + 1;
+
+            emit onMwcOutputLine(ln);
+            outputLines.push_front(ln);
+            while( outputLines.size() > 10000 ) // List should be OK with that. It is optimized for head/tail ops.
+                outputLines.pop_back();
         }
 
-        nonEmittedOutput = ln;
+        nonEmittedOutput.append( data + lineStart, size - lineStart );
     }
 }
 
@@ -711,6 +719,8 @@ void MwcNode::sendRequest( const QString & tag, QString secret,
 
     if (reply) {
         reply->setProperty("tag", QVariant(tag));
+        if (trace::isEnabled())
+            reply->setProperty("traceStart", QVariant(qlonglong(trace::now())));
         // Respond will be send back async
     }
 }
@@ -719,6 +729,13 @@ void MwcNode::replyFinished(QNetworkReply* reply) {
     // processing reply object first
     QNetworkReply::NetworkError errCode = reply->error();
     QString tag = reply->property("tag").toString();
+    trace::Scope traceScope("node", "reply");
+    if (traceScope.isActive()) {
+        traceScope.setArgs( trace::arg("tag", tag) );
+        const int64_t start = reply->property("traceStart").toLongLong();
+        if (start>0)
+            trace::asyncSpan("node", "REST " + tag, int64_t(reinterpret_cast<quintptr>(reply)), start, trace::now());
+    }
     QString strReply (reply->readAll().trimmed());
     reply->deleteLater();
     reply = nullptr;
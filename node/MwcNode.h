@@ -31,6 +31,10 @@ namespace tries{
 class NodeOutputParser;
 }
 
+namespace ioutils {
+class OutputReader;
+}
+
 namespace node {
 
 // Node management timeouts.
@@ -121,6 +125,7 @@ private:
     QString nodePath; // path to the backed binary
     QProcess *nodeProcess = nullptr;
     tries::NodeOutputParser *nodeOutputParser = nullptr; // logs will come from stdout
+    ioutils::OutputReader *outputReader = nullptr; // stdout stream filter. Owner
 
     QString lastUsedNetwork;
     PeerConnectionInfo peers; // connected peers. Polling with API
@@ -142,7 +147,7 @@ private:
 
     tries::NODE_OUTPUT_EVENT lastProcessedEvent = tries::NODE_OUTPUT_EVENT::NONE;
 
-    QString nonEmittedOutput;
+    QByteArray nonEmittedOutput; // Not finished line from the output, UTF-8
 
     QString nodeStatusString= "Waiting";
     int     txhashsetHeight = 0;
@@ -18,6 +18,7 @@
 #include "../state/statemachine.h"
 #include "../windows/a_waitingwnd.h"
 #include "../util/Log.h"
+#include "../core/global.h"
 
 namespace state {
 
@@ -25,19 +26,38 @@ namespace state {
 StartWallet::StartWallet(StateContext * context) :
         State(context, STATE::START_WALLET)
 {
+    QObject::connect( context->wallet, &wallet::Wallet::onWalletInitialized, this, &StartWallet::onWalletInitialized, Qt::QueuedConnection );
 }
 
 StartWallet::~StartWallet() {
 }
 
+void StartWallet::deleteWaitingWnd(wnd::WaitingWnd * w) {
+    Q_UNUSED(w); // Nothing to update, the window is replaced by the next state
+}
+
 NextStateRespond StartWallet::execute() {
-    if ( !context->wallet->isRunning() ) {
-        // Just update the wallet with a status. Then continue
-        context->appContext->pushCookie<QString>("checkWalletInitialized",
-                context->wallet->checkWalletInitialized() ? "OK" : "FAILED" );
-    }
+    if ( context->wallet->isRunning() )
+        return NextStateRespond(NextStateRespond::RESULT::DONE);
+
+    // Check might be already started at app start, the result will come the same way
+    checking = true;
+    context->wallet->checkWalletInitialized();
+
+    context->wndManager->switchToWindowEx( mwc::PAGE_A_STARTING,
+            new wnd::WaitingWnd( context->wndManager->getInWndParent(), this, "Starting", "Checking the wallet..." ) );
+
+    return NextStateRespond(NextStateRespond::RESULT::WAIT_FOR_ACTION);
+}
+
+void StartWallet::onWalletInitialized(bool initialized) {
+    if (!checking)
+        return;
 
-    return NextStateRespond(NextStateRespond::RESULT::DONE);
+    checking = false;
+    // Just update the wallet with a status. Then continue
+    context->appContext->pushCookie<QString>("checkWalletInitialized", initialized ? "OK" : "FAILED" );
+    context->stateMachine->executeFrom(STATE::STATE_INIT);
 }
 
 
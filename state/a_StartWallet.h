@@ -16,6 +16,7 @@
 #define GUI_WALLET_STARTWALLET_H
 
 #include "state.h"
+#include <QObject>
 #include "../wallet/wallet.h"
 #include "../windows/a_waitingwnd.h"
 
@@ -24,16 +25,23 @@
 namespace state {
 
 // Init the wallet. Then check how it is started. If it needs to have password or something
-class StartWallet : public State {
+// mwc713 is checking the wallet in the background, the state is waiting for onWalletInitialized
+class StartWallet : public QObject, public State, public wnd::WaitingWndState {
+    Q_OBJECT
 public:
     StartWallet(StateContext * context);
     virtual ~StartWallet() override;
 
+    virtual void deleteWaitingWnd(wnd::WaitingWnd * w) override;
+
 protected:
     virtual NextStateRespond execute() override;
 
+private slots:
+    void onWalletInitialized(bool initialized);
 
 private:
+    bool checking = false; // waiting for the checkWalletInitialized result
 };
 
 }
@@ -30,6 +30,7 @@ Outputs::Outputs(StateContext * context) :
     QObject::connect( context->wallet, &wallet::Wallet::onWalletBalanceUpdated, this, &Outputs::onWalletBalanceUpdated, Qt::QueuedConnection );
 
     QObject::connect( context->wallet, &wallet::Wallet::onOutputs, this, &Outputs::onOutputs );
+    QObject::connect( context->wallet, &wallet::Wallet::onOutputsChanged, this, &Outputs::onOutputsChanged );
     QObject::connect( context->wallet, &wallet::Wallet::onOutputCount, this, &Outputs::onOutputCount );
 
 }
@@ -48,13 +49,26 @@ NextStateRespond Outputs::execute() {
     return NextStateRespond( NextStateRespond::RESULT::WAIT_FOR_ACTION );
 }
 
+void Outputs::deleteWnd(wnd::Outputs * w) {
+    if (w!=wnd)
+        return;
+    wnd = nullptr;
+
+    // Nobody is waiting for the data any more
+    context->wallet->cancelRequest(outputCountRequest);
+    context->wallet->cancelRequest(outputsRequest);
+    outputCountRequest = outputsRequest = -1;
+    // Stop the outputs refresh on the slate events
+    context->wallet->releaseOutputs();
+}
+
 void Outputs::requestOutputCount(QString account) {
-    context->wallet->getOutputCount(account);
+    outputCountRequest = context->wallet->getOutputCount(account);
 }
 
 // request wallet for outputs
 void Outputs::requestOutputs(QString account, int offset, int number) {
-    context->wallet->getOutputs(account, offset, number);
+    outputsRequest = context->wallet->getOutputs(account, offset, number);
     // Respond:  onOutputs(...)
     // Balance need to be updated as well to match outputs state
     context->wallet->updateWalletBalance();
@@ -66,13 +80,19 @@ void Outputs::onOutputCount(QString account, int count) {
     }
 }
 
-void Outputs::onOutputs( QString account, int64_t height, QVector<wallet::WalletOutput> outputs) {
+void Outputs::onOutputs( QString account, int64_t height, wallet::OutputColumns outputs) {
     qDebug() << "state onOutputs call for wnd=" << wnd;
     if (wnd) {
         wnd->setOutputsData(account,height, outputs);
     }
 }
 
+void Outputs::onOutputsChanged( wallet::WalletOutputsDiff diff ) {
+    if (wnd) {
+        wnd->applyOutputsDiff(diff);
+    }
+}
+
 void Outputs::switchCurrentAccount(const wallet::AccountInfo & account) {
     // Switching without expected feedback.   Possible error will be cought by requestTransactions.
     context->wallet->switchAccount( account.accountName );
@@ -32,7 +32,7 @@ public:
     Outputs( StateContext * context);
     virtual ~Outputs() override;
 
-    void deleteWnd(wnd::Outputs * w) { if(w==wnd) wnd = nullptr;}
+    void deleteWnd(wnd::Outputs * w);
 
     // request wallet for outputs
     void requestOutputCount(QString account);
@@ -49,7 +49,8 @@ public:
 
 private slots:
     void onOutputCount(QString account, int count);
-    void onOutputs( QString account, int64_t height, QVector<wallet::WalletOutput> outputs);
+    void onOutputs( QString account, int64_t height, wallet::OutputColumns outputs);
+    void onOutputsChanged( wallet::WalletOutputsDiff diff );
 
     void onWalletBalanceUpdated();
 
@@ -60,6 +61,9 @@ protected:
 
 private:
     wnd::Outputs * wnd = nullptr;
+    // Requests that the window is waiting for. Cancelled when window is closed
+    int64_t outputCountRequest = -1;
+    int64_t outputsRequest = -1;
 };
 
 }
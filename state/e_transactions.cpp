@@ -34,6 +34,7 @@ Transactions::Transactions( StateContext * context) :
 
     QObject::connect( context->wallet, &wallet::Wallet::onTransactionCount, this, &Transactions::updateTransactionCount, Qt::QueuedConnection );
     QObject::connect( context->wallet, &wallet::Wallet::onTransactions, this, &Transactions::updateTransactions, Qt::QueuedConnection );
+    QObject::connect( context->wallet, &wallet::Wallet::onTransactionQueryResult, this, &Transactions::updateTransactionQueryResult, Qt::QueuedConnection );
 
 }
 
@@ -68,17 +69,35 @@ void Transactions::switchCurrentAccount(const wallet::AccountInfo & account) {
     context->wallet->switchAccount( account.accountName );
 }
 
+void Transactions::resetWnd(wnd::Transactions * w) {
+    if (w!=wnd)
+        return;
+    wnd = nullptr;
+
+    // Nobody is waiting for the data any more
+    context->wallet->cancelRequest(transactionCountRequest);
+    context->wallet->cancelRequest(transactionsRequest);
+    context->wallet->cancelRequest(transactionQueryRequest);
+    transactionCountRequest = transactionsRequest = transactionQueryRequest = -1;
+}
+
 void Transactions::requestTransactionCount(QString account) {
-    context->wallet->getTransactionCount(account);
+    transactionCountRequest = context->wallet->getTransactionCount(account);
 }
 
 // Current transactions that wallet has
 void Transactions::requestTransactions(QString account, int offset, int number) {
 
-    context->wallet->getTransactions(account, offset, number);
+    transactionsRequest = context->wallet->getTransactions(account, offset, number);
     context->wallet->updateWalletBalance(); // With transactions refresh, need to update the balance
 }
 
+int64_t Transactions::queryTransactions(QString account, const wallet::TransactionQuery & query) {
+    transactionQueryRequest = context->wallet->queryTransactions(account, query);
+    context->wallet->updateWalletBalance(); // The same as for the page request
+    return transactionQueryRequest;
+}
+
 void Transactions::updateTransactionCount(QString account, int number) {
     if (wnd) {
         wnd->setTransactionCount(account, number);
@@ -86,12 +105,18 @@ void Transactions::updateTransactionCount(QString account, int number) {
 }
 
 
-void Transactions::updateTransactions( QString account, int64_t height, QVector<wallet::WalletTransaction> transactions) {
+void Transactions::updateTransactions( QString account, int64_t height, wallet::TransactionColumns transactions) {
     if (wnd) {
         wnd->setTransactionData(account, height, transactions);
     }
 }
 
+void Transactions::updateTransactionQueryResult( int64_t requestId, QString account, int total, int offset, wallet::TransactionColumns transactions, bool last ) {
+    if (wnd) {
+        wnd->setTransactionQueryData(requestId, account, total, offset, transactions, last);
+    }
+}
+
 // Proofs
 void Transactions::generateMwcBoxTransactionProof( int64_t transactionId, QString resultingFileName ) {
     context->wallet->generateMwcBoxTransactionProof(transactionId, resultingFileName);
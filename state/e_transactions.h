@@ -31,11 +31,13 @@ public:
     Transactions( StateContext * context );
     virtual ~Transactions() override;
 
-    void resetWnd(wnd::Transactions * w) { if(w==wnd) wnd = nullptr;}
+    void resetWnd(wnd::Transactions * w);
 
     // Current transactions that wallet has
     void requestTransactionCount(QString account);
     void requestTransactions(QString account, int offset, int number);
+    // Search at the account history. Return the request Id, results come by chunks with it
+    int64_t queryTransactions(QString account, const wallet::TransactionQuery & query);
 
     void switchCurrentAccount(const wallet::AccountInfo & account);
 
@@ -63,7 +65,8 @@ protected:
 
 private slots:
     void updateTransactionCount(QString account, int number);
-    void updateTransactions( QString account, int64_t height, QVector<wallet::WalletTransaction> Transactions);
+    void updateTransactions( QString account, int64_t height, wallet::TransactionColumns Transactions);
+    void updateTransactionQueryResult( int64_t requestId, QString account, int total, int offset, wallet::TransactionColumns transactions, bool last );
 
     void onCancelTransacton( bool success, int64_t trIdx, QString errMessage );
     void onWalletBalanceUpdated();
@@ -74,6 +77,10 @@ private slots:
 private:
     wnd::Transactions * wnd = nullptr;
     QMetaObject::Connection slotConn;
+    // Requests that the window is waiting for. Cancelled when window is closed
+    int64_t transactionCountRequest = -1;
+    int64_t transactionsRequest = -1;
+    int64_t transactionQueryRequest = -1;
 };
 
 }
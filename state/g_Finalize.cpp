@@ -78,9 +78,10 @@ void Finalize::fileTransactionUploaded( const QString & fileName, const util::Fi
 
     /*  No need to get any transaction info
     if (!transInfo.transactionId.isEmpty()) {
-        for (auto &tr : allTransactions) {
-            if (!tr.txid.isEmpty() && transInfo.transactionId.startsWith(tr.txid) ) {
-                transaction = tr;
+        for (int i=0; i<allTransactions.size(); i++) {
+            QString txid = allTransactions[i].txid();
+            if (!txid.isEmpty() && transInfo.transactionId.startsWith(txid) ) {
+                transaction = allTransactions.at(i);
                 break;
             }
         }
@@ -121,7 +122,7 @@ state::StateContext * Finalize::getContext() {
 }
 
 
-void Finalize::onAllTransactions( QVector<wallet::WalletTransaction> transactions) {
+void Finalize::onAllTransactions( wallet::TransactionColumns transactions) {
     allTransactions = transactions;
 }
 
@@ -59,14 +59,14 @@ protected:
 
 private slots:
     void onFinalizeFile( bool success, QStringList errors, QString fileName );
-    void onAllTransactions( QVector<wallet::WalletTransaction> Transactions);
+    void onAllTransactions( wallet::TransactionColumns Transactions);
     void onNodeStatus( bool online, QString errMsg, int nodeHeight, int peerHeight, int64_t totalDifficulty, int connections );
 private:
     wnd::FinalizeUpload * uploadWnd = nullptr;
     wnd::FileTransaction * fileTransWnd = nullptr;
 
     // We can use transactions to obtain additional data about send to address, transaction Date
-    QVector<wallet::WalletTransaction> allTransactions;
+    wallet::TransactionColumns allTransactions;
     int lastNodeHeight = 0;
 };
 
@@ -33,6 +33,7 @@
 #include "x_ShowSeed.h"
 #include "x_Resync.h"
 #include "../core/Config.h"
+#include "../util/Trace.h"
 #include "u_nodeinfo.h"
 #include "g_Finalize.h"
 
@@ -99,6 +100,9 @@ void StateMachine::start() {
 }
 
 void StateMachine::executeFrom( STATE nextState ) {
+    trace::Scope traceScope("state", "executeFrom");
+    if (traceScope.isActive())
+        traceScope.setArgs( trace::arg("from", int(currentState)) + "," + trace::arg("next", int(nextState)) );
 
     // notify current state
     State* prevState = states.value(currentState, nullptr);
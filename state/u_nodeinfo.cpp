@@ -83,6 +83,10 @@ node::MwcNode * NodeInfo::getMwcNode() const {
     return context->mwcNode;
 }
 
+wallet::Wallet * NodeInfo::getWallet() const {
+    return context->wallet;
+}
+
 
 // After login - let's check the node status
 void NodeInfo::onLoginResult(bool ok) {
@@ -61,6 +61,7 @@ public:
     QString getMwcNodeStatus();
 
     node::MwcNode * getMwcNode() const;
+    wallet::Wallet * getWallet() const;
 protected:
     virtual NextStateRespond execute() override;
     virtual QString getHelpDocName() override {return "node_overview.html";}
@@ -0,0 +1,100 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "testEventRouting.h"
+#include "../wallet/mwc713events.h"
+
+namespace test {
+
+using namespace wallet;
+
+// Tasks queue with a listener that adds a task when it sees a slate
+class TestRouter : public WEventRouter {
+public:
+    struct Task {
+        int id;
+        QVector<WALLET_EVENTS> events;
+    };
+
+    QVector<Task> queue;
+    QVector<Task> done;
+    QVector<WALLET_EVENTS> listened;
+    int lastId = 0;
+
+    void addTask() { queue.push_back( Task{++lastId, {}} ); }
+
+    virtual bool getTaskReadyEvents(WEventSet & ready) override {
+        if (queue.isEmpty())
+            return false;
+        ready = WEventSet();
+        ready.insert(WALLET_EVENTS::S_READY);
+        return true;
+    }
+
+    virtual void listenEvents(WEventSpan evts) override {
+        for (const WEvent & e : evts) {
+            listened.push_back(e.event);
+            if (e.event == WALLET_EVENTS::S_SLATE_WAS_RECEIVED_FROM)
+                addTask(); // Like a balance refresh on the incoming slate
+        }
+    }
+
+    virtual void taskEvent(const WEvent & evt, bool ready) override {
+        Q_ASSERT(!queue.isEmpty());
+        queue.front().events.push_back(evt.event);
+        if (ready)
+            done.push_back( queue.takeFirst() );
+    }
+};
+
+static QVector<WEvent> makeEvents(const QVector<WALLET_EVENTS> & codes) {
+    QVector<WEvent> res;
+    for (WALLET_EVENTS e : codes)
+        res.push_back( WEvent(e) );
+    return res;
+}
+
+void testEventRouting() {
+    const WALLET_EVENTS LINE  = WALLET_EVENTS::S_LINE;
+    const WALLET_EVENTS READY = WALLET_EVENTS::S_READY;
+    const WALLET_EVENTS SLATE = WALLET_EVENTS::S_SLATE_WAS_RECEIVED_FROM;
+
+    // No task. Listener adds one in the middle of the batch, the prompt after the slate
+    // was printed before the task command, it must not complete the task
+    {
+        TestRouter router;
+        QVector<WEvent> batch = makeEvents({LINE, SLATE, READY, LINE});
+        routeEvents(batch, router);
+        Q_ASSERT( router.listened == (QVector<WALLET_EVENTS>{LINE, SLATE, READY, LINE}) );
+        Q_ASSERT( router.done.isEmpty() && router.queue.size()==1 && router.queue[0].events.isEmpty() );
+
+        batch = makeEvents({LINE, READY});
+        routeEvents(batch, router);
+        Q_ASSERT( router.queue.isEmpty() && router.done.size()==1 );
+        Q_ASSERT( router.done[0].events == (QVector<WALLET_EVENTS>{LINE, READY}) );
+    }
+
+    // Running task gets events until its ready one, the task that listener added gets the rest
+    {
+        TestRouter router;
+        router.addTask();
+        QVector<WEvent> batch = makeEvents({LINE, SLATE, READY, LINE, LINE, READY, LINE});
+        routeEvents(batch, router);
+        Q_ASSERT( router.listened.size() == batch.size() );
+        Q_ASSERT( router.done.size()==2 && router.queue.isEmpty() );
+        Q_ASSERT( router.done[0].id==1 && router.done[0].events == (QVector<WALLET_EVENTS>{LINE, SLATE, READY}) );
+        Q_ASSERT( router.done[1].id==2 && router.done[1].events == (QVector<WALLET_EVENTS>{LINE, LINE, READY}) );
+    }
+}
+
+}
@@ -0,0 +1,99 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "testIoUtils.h"
+#include "../util/ioutils.h"
+#include <QPair>
+
+namespace test {
+
+// Byte by byte filter, how it was implemented originally
+static QByteArray filterEscSymbolsReference( const QByteArray & data ) {
+    QByteArray res;
+    bool inEsc = false;
+    for (char d : data) {
+        if (d==27)
+            inEsc = true;
+        if (!inEsc)
+            res.append( d );
+        if (d=='m')
+            inEsc=false;
+    }
+    return res;
+}
+
+// Filter input split by chunks of the size
+static QByteArray filterByChunks( const QByteArray & input, int chunk ) {
+    ioutils::OutputReader reader("wallet713>");
+    QByteArray res;
+    for ( int pos = 0; pos < input.size(); pos += chunk ) {
+        int sz = reader.process( input.constData() + pos, std::min(chunk, input.size()-pos) );
+        // Every ready piece must be a valid UTF-8
+        Q_ASSERT( QString::fromUtf8( reader.getData(), sz ).toUtf8() == QByteArray(reader.getData(), sz) );
+        for ( int lineEnd : reader.getLineEnds() )
+            Q_ASSERT( lineEnd < sz && reader.getData()[lineEnd] == '\n' );
+        res.append( reader.getData(), sz );
+    }
+    return res;
+}
+
+void testOutputReader() {
+    using namespace ioutils;
+
+    // Escapes, mixed new lines, editor prompts and 2,3 bytes UTF-8 chars
+    const QByteArray input = "\x1b[1mWelcome\x1b[0m to wallet713\r\n\r\n"
+                             "wallet713>   info\n"
+                             "wallet71\n"
+                             "Caf\xc3\xa9 \xe2\x82\xac\n"
+                             "Long line to cross SIMD blocks boundaries \x1b[32mwith a color\x1b[0m in the middle\n"
+                             "<<+)mwc713(+>>";
+    const QByteArray expected = "Welcome to wallet713\n"
+                                "info\n"
+                                "wallet71\n"
+                                "Caf\xc3\xa9 \xe2\x82\xac\n"
+                                "Long line to cross SIMD blocks boundaries with a color in the middle\n"
+                                "<<+)mwc713(+>>";
+
+    const SIMD_LEVEL bestLevel = getSimdLevel();
+
+    for ( int lvl = int(SIMD_LEVEL::SCALAR); lvl <= int(bestLevel); lvl++ ) {
+        setSimdLevel( SIMD_LEVEL(lvl) );
+
+        Q_ASSERT( FilterEscSymbols(input) == filterEscSymbolsReference(input) );
+        Q_ASSERT( FilterEscSymbols(input.left(20)) == filterEscSymbolsReference(input.left(20)) );
+
+        for ( int chunk = 1; chunk <= input.size(); chunk++ )
+            Q_ASSERT( filterByChunks(input, chunk) == expected );
+    }
+
+    // Differences from the old per chunk filtering, see OutputReader. Must be the same for any chunks
+    const QVector<QPair<QByteArray,QByteArray>> cases = {
+        // Leading new lines are dropped, empty lines that span the chunks are collapsed
+        { "\n\r\nERROR: first\n\n\nsecond\n", "ERROR: first\nsecond\n" },
+        // Only the spaces after the prompt are removed
+        { "wallet713>  info  \n", "info  \n" },
+        // Prompt without data is not a line
+        { "wallet713>   \r\nnext\n", "next\n" },
+        // Prompt only at the line start
+        { "a wallet713> b\nwallet71\n", "a wallet713> b\nwallet71\n" },
+    };
+    for ( const auto & c : cases ) {
+        for ( int chunk = 1; chunk <= c.first.size(); chunk++ )
+            Q_ASSERT( filterByChunks(c.first, chunk) == c.second );
+    }
+
+    setSimdLevel(bestLevel);
+}
+
+}
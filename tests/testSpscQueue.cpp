@@ -0,0 +1,51 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "testSpscQueue.h"
+#include "../util/SpscQueue.h"
+#include <QString>
+#include <thread>
+
+namespace test {
+
+void testSpscQueue() {
+    util::SpscQueue<QString> queue;
+    const int itemsNum = 100000;
+
+    std::thread producer( [&queue, itemsNum]() {
+        for ( int i=0; i<itemsNum; i++ ) {
+            queue.push( QString::number(i) );
+            if (i % 1000 == 0)
+                std::this_thread::yield();
+        }
+    });
+
+    int expected = 0;
+    QString item;
+    while (expected < itemsNum) {
+        if (queue.pop(item)) {
+            Q_ASSERT( item == QString::number(expected) );
+            expected++;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    Q_ASSERT( queue.isEmpty() );
+    Q_ASSERT( !queue.pop(item) );
+}
+
+}
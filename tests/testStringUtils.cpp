@@ -14,6 +14,7 @@
 
 #include "testStringUtils.h"
 #include "../util/stringutils.h"
+#include <QDateTime>
 
 namespace test {
 
@@ -56,6 +57,27 @@ void testUtils() {
     Q_ASSERT( util::urlEncode("abc") == "abc");
     Q_ASSERT( util::urlEncode("а") == "%D0%B0");
     Q_ASSERT( util::urlEncode("%abcа") == "%25abc%D0%B0");
+
+    // mwc713 times are UTC
+    QString t1 = "2019-06-22 05:44:53";
+    Q_ASSERT( util::mwc713time2ms(QStringRef(&t1)) == 1561182293000L );
+    QString t2 = " 1970-01-01 00:00:01 ";
+    Q_ASSERT( util::mwc713time2ms(QStringRef(&t2)) == 1000L );
+    QString t3 = "2020-02-29 23:59:59";
+    Q_ASSERT( util::mwc713time2ms(QStringRef(&t3)) == 1583020799000L );
+    QString bad1 = "2019-13-22 05:44:53";
+    QString bad2 = "2019/06/22 05:44:53";
+    QString bad3 = "";
+    Q_ASSERT( util::mwc713time2ms(QStringRef(&bad1)) == 0 );
+    Q_ASSERT( util::mwc713time2ms(QStringRef(&bad2)) == 0 );
+    Q_ASSERT( util::mwc713time2ms(QStringRef(&bad3)) == 0 );
+
+    // Display is shifted by the current UTC offset, the same way as mwc713time2ThisTime always did
+    int64_t ms = 1561182293000L;
+    int64_t offsetMs = int64_t(QDateTime::currentDateTime().offsetFromUtc()) * 1000;
+    Q_ASSERT( util::ms2ThisTime(ms) == QDateTime::fromMSecsSinceEpoch(ms + offsetMs, Qt::UTC).toString("hh:mm:ss dd-MM-yyyy") );
+    Q_ASSERT( util::mwc713time2ThisTime(t1) == util::ms2ThisTime(ms) );
+    Q_ASSERT( util::ms2ThisTime(0).isEmpty() );
 }
 
 }
@@ -0,0 +1,56 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "testTaskLatency.h"
+#include "../wallet/tasklatency.h"
+#include <QDataStream>
+#include <QByteArray>
+
+namespace test {
+
+void testTaskLatency() {
+    wallet::TaskLatencyStats stats;
+
+    // Not enough data, default is used
+    Q_ASSERT( stats.getTimeout("txs", 60000) == 60000 );
+    for (int i=0; i<4; i++)
+        stats.addSample("txs", 100);
+    Q_ASSERT( stats.getPercentile("txs", 95) == -1 );
+    Q_ASSERT( stats.getTimeout("txs", 60000) == 60000 );
+
+    // Fast machine, timeout is limited by the default/10
+    stats.addSample("txs", 100);
+    Q_ASSERT( stats.getPercentile("txs", 95) == 100 );
+    Q_ASSERT( stats.getTimeout("txs", 60000) == 6000 );
+
+    // Slow machine, timeout goes above the default
+    for (int i=0; i<100; i++)
+        stats.addSample("nodeinfo", 20000 + i);
+    Q_ASSERT( stats.getPercentile("nodeinfo", 95) > 20090 );
+    Q_ASSERT( stats.getTimeout("nodeinfo", 30000) > 60000 );
+    Q_ASSERT( stats.getTimeout("nodeinfo", 3000) == 30000 );
+
+    QByteArray data;
+    {
+        QDataStream out(&data, QIODevice::WriteOnly);
+        stats.saveData(out);
+    }
+    wallet::TaskLatencyStats loaded;
+    QDataStream in(data);
+    Q_ASSERT( loaded.loadData(in) );
+    Q_ASSERT( loaded.getTimeout("txs", 60000) == stats.getTimeout("txs", 60000) );
+    Q_ASSERT( loaded.getPercentile("nodeinfo", 95) == stats.getPercentile("nodeinfo", 95) );
+}
+
+}
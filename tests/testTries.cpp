@@ -0,0 +1,165 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "testTries.h"
+#include "../tries/inputparser.h"
+#include "../tries/simpletriesection.h"
+
+namespace test {
+
+using namespace tries;
+
+// Subset of mwc713 parsers that cover all sections types and topologies
+static void initParsers(InputParser & parser) {
+    parser.appendLineParser( new TrieLineParser( 1, QVector<BaseTrieSection*>{
+                                   new TriePhraseSection("<<+)mwc713(+>>") } ));
+
+    parser.appendLineParser( new TrieLineParser( 2, QVector<BaseTrieSection*>{
+                                   new TriePhraseSection("Welcome to wallet713 for MWC v"),
+                                   new TrieVersionSection(1),
+                                   new TrieNewLineSection()} ));
+
+    parser.appendLineParser( new TrieLineParser( 7, QVector<BaseTrieSection*>{
+                                   new TrieNewLineSection(),
+                                   new TriePhraseSection("ERROR: "),
+                                   new TrieAnySection(100, TrieAnySection::NOT_NEW_LINE,"","", 1) } ));
+
+    parser.appendLineParser( new TrieLineParser( 10, QVector<BaseTrieSection*>{
+                                   new TriePhraseSection("error: "),
+                                   new TrieAnySection(100, TrieAnySection::NOT_NEW_LINE, "","", 1) } ));
+
+    parser.appendLineParser( new TrieLineParser( 20, QVector<BaseTrieSection*>{
+                                   new TriePhraseSection("starting mwcmqs listener...") } ));
+
+    parser.appendLineParser( new TrieLineParser( 22, QVector<BaseTrieSection*>{
+                                   new TriePhraseSection("listener started for ["),
+                                   new TriePhraseSection("keybase]", 1) } ));
+
+    parser.appendLineParser( new TrieLineParser( 22, QVector<BaseTrieSection*>{
+                                   new TriePhraseSection("mwcmqs listener started for: ["),
+                                   new TrieAnySection(100, TrieAnySection::NUMBERS | TrieAnySection::LOW_CASE | TrieAnySection::UPPER_CASE, "", "", 1),
+                                   new TriePhraseSection("] tid=["),
+                                   new TrieAnySection(100, TrieAnySection::NOT_SPACES, "", "]", 3),
+                                   new TriePhraseSection("]") } ));
+
+    parser.appendLineParser( new TrieLineParser( 37, QVector<BaseTrieSection*>{
+                                   new TriePhraseSection("Checking "),
+                                   new TrieAnySection(100, TrieAnySection::NUMBERS,"",""),
+                                   new TriePhraseSection(" outputs, up to index "),
+                                   new TrieAnySection(100, TrieAnySection::NUMBERS,"","", 1),
+                                   new TriePhraseSection(". (Highest index: "),
+                                   new TrieAnySection(100, TrieAnySection::NUMBERS,"","", 2),
+                                   new TriePhraseSection(")") } ));
+
+    parser.appendLineParser( new TrieLineParser( 44, QVector<BaseTrieSection*>{
+                                   new TrieNewLineSection(),
+                                   new TriePhraseSection("____ Wallet Summary Info - Account '"),
+                                   new TrieAnySection(100, TrieAnySection::NOT_NEW_LINE | TrieAnySection::START_NEXT_EVERY_TRY, "","", 1),
+                                   new TriePhraseSection("' as of height "),
+                                   new TrieAnySection(100, TrieAnySection::NUMBERS, "","", 2 ),
+                                   new TrieAnySection(100, TrieAnySection::NOT_NEW_LINE, "","") } ));
+
+    parser.appendLineParser( new TrieLineParser( 58, QVector<BaseTrieSection*>{
+                                   new TriePhraseSection("slate ["),
+                                   new TrieAnySection(100, TrieAnySection::NOT_NEW_LINE|TrieAnySection::NOT_SPACES, "","]", 1),
+                                   new TriePhraseSection("] received from ["),
+                                   new TrieAnySection(100, TrieAnySection::NOT_NEW_LINE, "","]", 2),
+                                   new TriePhraseSection("] for ["),
+                                   new TrieAnySection(100, TrieAnySection::NUMBERS, ".","]", 3),
+                                   new TriePhraseSection("] MWCs."),
+                                   new TrieNewLineSection() } ));
+
+    // Starts with capture section, can't be compiled
+    parser.appendLineParser( new TrieLineParser( 80, QVector<BaseTrieSection*>{
+                                   new TrieAnySection(10, TrieAnySection::NUMBERS, "","", 1),
+                                   new TriePhraseSection(" rangeproofs") } ));
+
+    parser.appendLineParser( new TrieLineParser( 17, QVector<BaseTrieSection*>{
+                                   new TrieNewLineSection(),
+                                   new TrieAnySection(512, TrieAnySection::NOT_NEW_LINE, "", "", 1),
+                                   new TrieNewLineSection() } ));
+}
+
+static bool isEqual( const QVector<ParsingResult> & r1, const QVector<ParsingResult> & r2 ) {
+    if (r1.size() != r2.size())
+        return false;
+
+    for ( int i=0; i<r1.size(); i++ ) {
+        if ( r1[i].parserId != r2[i].parserId )
+            return false;
+
+        const auto & pr1 = r1[i].result.parseResult;
+        const auto & pr2 = r2[i].result.parseResult;
+        if (pr1.size() != pr2.size())
+            return false;
+
+        for ( int j=0; j<pr1.size(); j++ ) {
+            if ( pr1[j].dataId != pr2[j].dataId || pr1[j].strData != pr2[j].strData )
+                return false;
+        }
+    }
+    return true;
+}
+
+void testTrieAutomaton() {
+    const QString input = "Welcome to wallet713 for MWC v2.4.1\n"
+            "<<+)mwc713(+>>\n"
+            "starting mwcmqs listener...\r\n"
+            "mwcmqs listener started for: [xmjJGkX9U75Vo8Ro26gTm2i4k4CD39Q24qvQqAPeQVeWuo36YVFh] tid=[xa5ktaMRCEmj151Rfxr7a]\n"
+            "listener started for [keybase]\n"
+            "ERROR: something went wrong | with pipe\n"
+            "error: keybase not found\n"
+            "Checking 1000 outputs, up to index 13433. (Highest index: 12235)\n"
+            "\n____ Wallet Summary Info - Account 'my' as of height 'acc' as of height 117749 ____\n"
+            "slate [b2822262-4760-4907-923f-e2459ed5d554] received from [jbyrer] for [1.000000000] MWCs.\n"
+            "verified 72000 rangeproofs\n"
+            "slate [slate [x] received from [y] for [2.5] MWCs.\n"
+            "<<+)mwc713(+<<+)mwc713(+>>";
+
+    InputParser reference(InputParser::ENGINE::REFERENCE);
+    InputParser automaton(InputParser::ENGINE::AUTOMATON);
+    initParsers(reference);
+    initParsers(automaton);
+
+    // Whole input at once
+    QVector<ParsingResult> refRes = reference.processInput(input);
+    QVector<ParsingResult> autRes = automaton.processInput(input);
+    Q_ASSERT( refRes.size() > 10 );
+    Q_ASSERT( isEqual(refRes, autRes) );
+    // Most of the line parsers can't start from most of the chars
+    Q_ASSERT( reference.getDispatchStats().skipped > reference.getDispatchStats().attempts );
+    Q_ASSERT( automaton.getDispatchStats().skipped > automaton.getDispatchStats().attempts );
+
+    // Chunks of different size, state must be kept between the calls
+    for ( int chunk = 1; chunk < 40; chunk += 7 ) {
+        refRes.clear();
+        autRes.clear();
+        for ( int pos = 0; pos < input.length(); pos += chunk ) {
+            refRes += reference.processInput( input.mid(pos, chunk) );
+            autRes += automaton.processInput( input.mid(pos, chunk) );
+        }
+        Q_ASSERT( isEqual(refRes, autRes) );
+    }
+
+    // Steady state: contexts and captures pools are warmed up and reused, nothing new is created
+    for ( InputParser * parser : {&reference, &automaton} ) {
+        PoolStats warm = parser->getPoolStats();
+        Q_ASSERT( warm.contexts > 0 && warm.captures > 0 );
+        QVector<ParsingResult> res = parser->processInput(input);
+        Q_ASSERT( res.size() == refRes.size() );
+        Q_ASSERT( parser->getPoolStats() == warm );
+    }
+}
+
+}
@@ -0,0 +1,149 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "testTxCache.h"
+#include "../wallet/txcache.h"
+#include "../wallet/tasks/TaskTransaction.h"
+#include <QDataStream>
+#include <QByteArray>
+
+namespace test {
+
+static wallet::WalletTransaction tx(int64_t idx, bool confirmed) {
+    wallet::WalletTransaction t;
+    t.txIdx = idx;
+    t.transactionType = wallet::WalletTransaction::TRANSACTION_TYPE::SEND;
+    t.txid = "tx" + QString::number(idx);
+    t.confirmed = confirmed;
+    return t;
+}
+
+void testTxCache() {
+    // Wallet is not set, nothing goes to the disk
+    wallet::TransactionCache cache;
+
+    // Count is unknown, everything is requested
+    Q_ASSERT( cache.getRefreshStart("default", 0, 10) == 0 );
+    Q_ASSERT( !cache.hasRange("default", 0, 10) );
+
+    QVector<wallet::WalletTransaction> trans;
+    for (int i=0; i<10; i++)
+        trans.push_back( tx(i, i<7) );
+    cache.update("default", 100, trans);
+    cache.setCount("default", 10);
+
+    // 7,8,9 are not confirmed
+    Q_ASSERT( cache.hasRange("default", 0, 10) );
+    Q_ASSERT( cache.getRefreshStart("default", 0, 5) == -1 );
+    Q_ASSERT( cache.getRefreshStart("default", 5, 5) == 7 );
+    Q_ASSERT( cache.getAllRefreshStart("default") == 7 );
+
+    // Cancelled is final too
+    trans[7].cancelled();
+    cache.update("default", 101, {trans[7]});
+    Q_ASSERT( cache.getRefreshStart("default", 5, 5) == 8 );
+    Q_ASSERT( cache.getHeight("default") == 101 );
+
+    // New transactions
+    cache.setCount("default", 12);
+    trans[8].confirmed = true;
+    trans[9].confirmed = true;
+    cache.update("default", 102, {trans[8], trans[9]});
+    Q_ASSERT( cache.getRefreshStart("default", 5, 10) == 10 );
+    Q_ASSERT( !cache.hasRange("default", 5, 10) );
+    Q_ASSERT( cache.getRange("default", 5, 10).size() == 5 );
+
+    QByteArray data;
+    {
+        QDataStream out(&data, QIODevice::WriteOnly);
+        cache.saveData(out, "default");
+    }
+    wallet::TransactionCache loaded;
+    QDataStream in(data);
+    Q_ASSERT( loaded.loadData(in, "default") );
+    Q_ASSERT( loaded.getAll("default").size() == 10 );
+    Q_ASSERT( loaded.getAllRefreshStart("default") == 10 );
+    Q_ASSERT( loaded.getHeight("default") == 102 );
+    Q_ASSERT( loaded.getCount("default") == -1 ); // count is not stored
+
+    // History follows the renamed account, the old data for the reused name is gone
+    cache.update("acc2", 100, {tx(0, true)});
+    const int64_t revision = cache.getRevision("acc2");
+    cache.renameAccount("default", "acc2");
+    Q_ASSERT( cache.getAll("acc2").size() == 10 );
+    Q_ASSERT( cache.getHeight("acc2") == 102 );
+    Q_ASSERT( cache.getRevision("acc2") != revision );
+    Q_ASSERT( cache.getAll("default").isEmpty() );
+    Q_ASSERT( cache.getCount("default") == -1 );
+
+    // mwc713 rows that don't match txIdx disable the ranges for the account, data is still collected
+    Q_ASSERT( wallet::TransactionCache::isOffsetIndexed(5, {tx(5, true), tx(6, true)}) );
+    Q_ASSERT( !wallet::TransactionCache::isOffsetIndexed(5, {tx(6, true)}) );
+    cache.dropIndex("acc2");
+    Q_ASSERT( !cache.isIndexed("acc2") );
+    Q_ASSERT( !cache.hasRange("acc2", 0, 5) );
+    Q_ASSERT( cache.getRefreshStart("acc2", 5, 5) == 5 );
+    Q_ASSERT( cache.getAllRefreshStart("acc2") == 0 );
+    Q_ASSERT( cache.getAll("acc2").size() == 10 );
+}
+
+// Table line with the columns at the same positions as the header
+static QString txsLine(const QStringList & fields) {
+    QString res;
+    for (const QString & f : fields)
+        res += f.leftJustified(24, ' ');
+    return res;
+}
+
+static QString txsRow(int id, const QString & type, const QString & net) {
+    return txsLine({ QString::number(id), type, "tx" + QString::number(id), "address",
+                     "2019-06-22 05:44:53", "no", "", "", net, "no" });
+}
+
+void testTransactionsDecoder() {
+    using wallet::WEvent;
+    using wallet::WALLET_EVENTS;
+
+    QVector<WEvent> evts;
+    WEvent title(WALLET_EVENTS::S_TRANSACTION_LOG, "default");
+    title.addParam("100");
+    evts.push_back(title);
+    evts.push_back( WEvent(WALLET_EVENTS::S_LINE, txsLine({"Id", "Type", "TXID", "Address", "Creation Time", "Confirmed?",
+                                                             "Height", "Confirmation Time", "Net Difference", "Proof?"})) );
+    evts.push_back( WEvent(WALLET_EVENTS::S_LINE, "==============================") );
+    evts.push_back( WEvent(WALLET_EVENTS::S_LINE, txsRow(2, "Received Tx", "1.5")) );
+    evts.push_back( WEvent(WALLET_EVENTS::S_LINE, "--------------------------------") );
+    evts.push_back( WEvent(WALLET_EVENTS::S_LINE, txsRow(0, "Sent Tx", "-1")) );
+    evts.push_back( WEvent(WALLET_EVENTS::S_LINE, txsRow(3, "Sent Tx", "-2")) );
+    evts.push_back( WEvent(WALLET_EVENTS::S_LINE, "    - Cancelled") );
+    evts.push_back( WEvent(WALLET_EVENTS::S_LINE, txsRow(2, "Received Tx", "2.5")) ); // replaces the first one
+
+    wallet::TransactionsDecoder decoder;
+    for (const WEvent & e : evts)
+        Q_ASSERT( decoder.processEvent(e) );
+    Q_ASSERT( decoder.getAccount() == "default" && decoder.getHeight() == 100 );
+
+    // The last row is held, it can be cancelled by the next line
+    Q_ASSERT( decoder.getReadyNumber() == 2 );
+    QVector<wallet::WalletTransaction> ready = decoder.takeReady();
+    Q_ASSERT( ready.size() == 2 && ready[0].txIdx == 0 && ready[1].txIdx == 3 );
+    Q_ASSERT( ready[1].transactionType & wallet::WalletTransaction::TRANSACTION_TYPE::CANCELLED );
+
+    Q_ASSERT( decoder.processEvent( WEvent(WALLET_EVENTS::S_LINE, txsRow(1, "Sent Tx", "-3")) ) );
+    QVector<wallet::WalletTransaction> rest = decoder.takeAll();
+    Q_ASSERT( rest.size() == 2 && rest[0].txIdx == 1 && rest[1].txIdx == 2 );
+    Q_ASSERT( rest[1].coinNano == 2500000000L );
+    Q_ASSERT( decoder.getReadyNumber() == 0 && decoder.takeAll().isEmpty() );
+}
+
+}
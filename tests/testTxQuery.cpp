@@ -0,0 +1,97 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "testTxQuery.h"
+#include "../wallet/txquery.h"
+
+namespace test {
+
+using wallet::TransactionQuery;
+using wallet::WalletTransaction;
+
+static QVector<int> selectIdx(const wallet::TransactionIndex & index, const TransactionQuery & query) {
+    QVector<int> res;
+    for (int row : index.select(query))
+        res.push_back( int(index.getTransactions()[row].txIdx()) );
+    return res;
+}
+
+void testTxQuery() {
+    // Search text
+    TransactionQuery q = TransactionQuery::fromSearchText("  receive Unconfirmed >1.5 from:2019-06-01  ");
+    Q_ASSERT( q.typeMask == WalletTransaction::TRANSACTION_TYPE::RECEIVE );
+    Q_ASSERT( q.confirmed == TransactionQuery::CONFIRMED::NO );
+    Q_ASSERT( q.minAmountNano == 1500000000L && q.maxAmountNano < 0 );
+    Q_ASSERT( q.fromTimeMs > 0 && q.toTimeMs == 0 );
+    Q_ASSERT( q.address.isEmpty() && q.txidPrefix.isEmpty() );
+
+    q = TransactionQuery::fromSearchText("3-1 4F1A xmgEvZ4MCCGMJnRnNXKHBbHmSGWQchJ9");
+    Q_ASSERT( q.minAmountNano == 1000000000L && q.maxAmountNano == 3000000000L );
+    Q_ASSERT( q.txidPrefix == "4f1a" );
+    Q_ASSERT( q.address == "xmgEvZ4MCCGMJnRnNXKHBbHmSGWQchJ9" );
+    Q_ASSERT( !TransactionQuery::fromSearchText("").hasFilters() );
+
+    // 10 transactions: even are sends from address A, odd are receives from B. Only first 6 are confirmed.
+    QVector<WalletTransaction> trans;
+    for (int i=0; i<10; i++) {
+        WalletTransaction tx;
+        tx.txIdx = i;
+        tx.transactionType = i%2==0 ? WalletTransaction::TRANSACTION_TYPE::SEND : WalletTransaction::TRANSACTION_TYPE::RECEIVE;
+        tx.txid = QString("%1a6b2c-8d3e-4f5a-9b6c-7d8e9f0a1b2%2").arg(i%3==0 ? "4f1" : "9e2").arg(i);
+        tx.address = i%2==0 ? "A" : "B";
+        tx.creationTimeMs = 1561182293000L - i*1000; // older for greater index
+        tx.confirmed = i<6;
+        tx.coinNano = (i%2==0 ? -1 : 1) * 1000000000L * ((i*7)%10 + 1);
+        trans.push_back(tx);
+    }
+    wallet::TransactionIndex index( wallet::TransactionColumns::fromVector(trans) );
+
+    TransactionQuery all;
+    Q_ASSERT( selectIdx(index, all) == (QVector<int>{9,8,7,6,5,4,3,2,1,0}) );
+    all.descending = false;
+    Q_ASSERT( selectIdx(index, all).first() == 0 && selectIdx(index, all).size() == 10 );
+
+    // Compound filter
+    TransactionQuery f;
+    f.address = "B";
+    f.confirmed = TransactionQuery::CONFIRMED::YES;
+    Q_ASSERT( selectIdx(index, f) == (QVector<int>{5,3,1}) );
+    f.typeMask = WalletTransaction::TRANSACTION_TYPE::SEND;
+    Q_ASSERT( selectIdx(index, f).isEmpty() );
+
+    // Txid prefix, the case is ignored
+    TransactionQuery p = TransactionQuery::fromSearchText("4F1A");
+    Q_ASSERT( selectIdx(index, p) == (QVector<int>{9,6,3,0}) );
+
+    // Amount is absolute, range is inclusive. Amounts: 1,8,5,2,9,6,3,10,7,4
+    TransactionQuery a;
+    a.minAmountNano = 2000000000L;
+    a.maxAmountNano = 4000000000L;
+    a.sort = TransactionQuery::SORT::AMOUNT;
+    Q_ASSERT( selectIdx(index, a) == (QVector<int>{9,6,3}) );
+
+    // Time range [from,to)
+    TransactionQuery t;
+    t.fromTimeMs = 1561182293000L - 3000;
+    t.toTimeMs = 1561182293000L;
+    t.sort = TransactionQuery::SORT::TIME;
+    t.descending = false;
+    Q_ASSERT( selectIdx(index, t) == (QVector<int>{3,2,1}) );
+
+    // Empty index
+    wallet::TransactionIndex empty;
+    Q_ASSERT( empty.select(all).isEmpty() );
+    Q_ASSERT( wallet::TransactionIndex( wallet::TransactionColumns() ).select(f).isEmpty() );
+}
+
+}
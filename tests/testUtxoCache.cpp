@@ -0,0 +1,70 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "testUtxoCache.h"
+#include "../wallet/utxocache.h"
+
+namespace test {
+
+static wallet::WalletOutput output(QString commit, wallet::WalletOutput::STATUS status, int64_t confirms) {
+    wallet::WalletOutput out;
+    out.setData(commit, -1, 100, 0, status, false, confirms, 1000000000, 1);
+    return out;
+}
+
+void testUtxoCache() {
+    using STATUS = wallet::WalletOutput::STATUS;
+    wallet::UtxoCache cache;
+
+    QString acc;
+    int offset = 0, number = 0;
+    Q_ASSERT( !cache.getLastPage(acc, offset, number) );
+
+    // First read, everything is new
+    QVector<wallet::WalletOutput> page{ output("c1", STATUS::UNSPENT, 10), output("c2", STATUS::UNCONFIRMED, 0), output("c3", STATUS::LOCKED, 0) };
+    wallet::WalletOutputsDiff diff = cache.applyPage("default", 100, 0, 10, page);
+    Q_ASSERT( diff.added.size() == 3 && diff.removed.isEmpty() && diff.changed.isEmpty() );
+    Q_ASSERT( cache.getSize("default") == 3 );
+
+    // The same data, no diff
+    diff = cache.applyPage("default", 100, 0, 10, page);
+    Q_ASSERT( diff.isEmpty() );
+
+    // c2 is confirmed, c3 is spent, c4 is a change output
+    page = { output("c1", STATUS::UNSPENT, 11), output("c2", STATUS::UNSPENT, 1), output("c4", STATUS::UNCONFIRMED, 0) };
+    diff = cache.applyPage("default", 101, 0, 10, page);
+    Q_ASSERT( diff.added.size() == 1 && diff.added[0].outputCommitment == "c4" );
+    Q_ASSERT( diff.removed == QStringList{"c3"} );
+    Q_ASSERT( diff.changed.size() == 2 );
+    Q_ASSERT( cache.getOutput("default", "c3") == nullptr );
+    Q_ASSERT( cache.getOutput("default", "c2")->status == STATUS::UNSPENT );
+
+    // Another page doesn't remove outputs that was not there
+    diff = cache.applyPage("default", 101, 10, 10, {});
+    Q_ASSERT( diff.isEmpty() );
+    Q_ASSERT( cache.getSize("default") == 3 );
+
+    // Accounts are independent
+    diff = cache.applyPage("acc2", 101, 0, 10, {});
+    Q_ASSERT( diff.isEmpty() );
+    Q_ASSERT( cache.getSize("default") == 3 );
+
+    cache.setLastPage("default", 0, 10);
+    Q_ASSERT( cache.getLastPage(acc, offset, number) && acc == "default" && offset == 0 && number == 10 );
+
+    cache.clear();
+    Q_ASSERT( cache.getSize("default") == 0 );
+    Q_ASSERT( !cache.getLastPage(acc, offset, number) );
+}
+
+}
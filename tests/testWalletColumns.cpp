@@ -0,0 +1,75 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "testWalletColumns.h"
+#include "../wallet/wallet.h"
+
+namespace test {
+
+void testWalletColumns() {
+    QVector<wallet::WalletTransaction> trans;
+    for (int i=0; i<5; i++) {
+        wallet::WalletTransaction tx;
+        tx.txIdx = i;
+        tx.transactionType = i%2==0 ? wallet::WalletTransaction::TRANSACTION_TYPE::SEND : wallet::WalletTransaction::TRANSACTION_TYPE::RECEIVE;
+        tx.txid = QString("4f1a6b2c-8d3e-4f5a-9b6c-7d8e9f0a1b%1").arg(i, 2, 10, QChar('0'));
+        tx.address = i<3 ? "xmgEvZ4MCCGMJnRnNXKHBbHmSGWQchJ9" : "http://10.0.0.1:13415";
+        tx.creationTimeMs = 1561182293000L; // 2019-06-22 05:44:53 UTC
+        tx.confirmed = i<3;
+        tx.height = i<3 ? 1000+i : 0;
+        tx.confirmationTimeMs = i<3 ? 1561182293000L + (15*60+7)*1000 : 0;
+        tx.coinNano = 1000000000L * (i+1);
+        tx.proof = i==0;
+        trans.push_back(tx);
+    }
+    // Coinbase doesn't have uuid
+    trans[4].txid = "";
+
+    wallet::TransactionColumns columns = wallet::TransactionColumns::fromVector(trans);
+    Q_ASSERT( columns.size() == 5 );
+    Q_ASSERT( columns.getAddressCount() == 2 );
+
+    QVector<wallet::WalletTransaction> back = columns.toVector();
+    for (int i=0; i<trans.size(); i++) {
+        const auto & a = trans[i];
+        const auto & b = back[i];
+        Q_ASSERT( a.txIdx==b.txIdx && a.transactionType==b.transactionType && a.txid==b.txid && a.address==b.address );
+        Q_ASSERT( a.creationTimeMs==b.creationTimeMs && a.confirmed==b.confirmed && a.height==b.height );
+        Q_ASSERT( a.confirmationTimeMs==b.confirmationTimeMs && a.coinNano==b.coinNano && a.proof==b.proof );
+    }
+    Q_ASSERT( columns[3].confirmationTimeMs() == 0 );
+    Q_ASSERT( columns[0].confirmationTimeMs() - columns[0].creationTimeMs() == (15*60+7)*1000 );
+    Q_ASSERT( columns[3].confirmationTime().isEmpty() && columns[0].creationTime() == trans[0].getCreationTime() );
+
+    // Copy is shared, append to the copy doesn't change the snapshot
+    wallet::TransactionColumns copy = columns;
+    copy.append(trans[0]);
+    Q_ASSERT( copy.size() == 6 && columns.size() == 5 );
+
+    QVector<wallet::WalletOutput> outputs;
+    wallet::WalletOutput out;
+    out.setData("08a7f4c1c62e6a1b1b0e5f3d8c2a9e4b7d6c5f1e2a3b4c5d6e7f8091a2b3c4d5e6", 12345, 1000, 0,
+                wallet::WalletOutput::STATUS::UNSPENT, true, 10, 2000000000L, 3);
+    outputs.push_back(out);
+    out.setData("not a commitment", -1, -1, 0, wallet::WalletOutput::STATUS::UNCONFIRMED, false, 0, 1, -1);
+    outputs.push_back(out);
+
+    QVector<wallet::WalletOutput> outBack = wallet::OutputColumns::fromVector(outputs).toVector();
+    Q_ASSERT( outBack.size() == 2 );
+    for (int i=0; i<outputs.size(); i++) {
+        Q_ASSERT( outputs[i].outputCommitment == outBack[i].outputCommitment );
+        Q_ASSERT( outputs[i].isSameState(outBack[i]) && outputs[i].coinbase == outBack[i].coinbase );
+    }
+}
+
+}
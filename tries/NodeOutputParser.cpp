@@ -152,15 +152,24 @@ NodeOutputParser::NodeOutputParser() {
 }
 
 NodeOutputParser::~NodeOutputParser() {
+    const DispatchStats & stats = parser.getDispatchStats();
+    logger::logInfo("NodeOutputParser", "Line parsers attempts: " + QString::number(stats.attempts) +
+                    ", skipped: " + QString::number(stats.skipped) );
 }
 
 // Main routine processing with backed wallet printed
 // Results will be delieved async through signals
 void NodeOutputParser::processInput(QString message) {
     qDebug() << "Processing wallet input: '" << message << "'";
+    emitResults( parser.processInput(message) );
+}
 
-    QVector<ParsingResult> results = parser.processInput(message);
+void NodeOutputParser::processInput(const char * utf8, int size) {
+    qDebug() << "Processing wallet input: '" << QByteArray::fromRawData(utf8, size) << "'";
+    emitResults( parser.processInput(utf8, size) );
+}
 
+void NodeOutputParser::emitResults(const QVector<ParsingResult> & results) {
     for (auto &res : results) {
         qDebug() << "Getting results: " << res;
 
@@ -55,8 +55,11 @@ public:
     // Main routine processing with backed wallet printed
     // Results will be delieved async through signals
     void processInput(QString message);
+    // The same for UTF-8 data. Data must end with a complete char.
+    void processInput(const char * utf8, int size);
 
 private:
+    void emitResults(const QVector<ParsingResult> & results);
 signals:
      void nodeOutputGenericEvent( NODE_OUTPUT_EVENT event, QString message);
 
@@ -13,16 +13,11 @@
 // limitations under the License.
 
 #include "tries/baseparser.h"
+#include <atomic>
+#include <algorithm>
 
 namespace tries {
 
-LineResult::LineResult(const LineResult & other, SectionResult && next ) :
-    parseResult(other.parseResult)
-{
-    parseResult.append(next);
-}
-
-
 QDebug operator<<(QDebug dbg, const LineResult& res) {
     dbg << "LineResult(";
     for (auto & r: res.parseResult) {
@@ -44,12 +39,23 @@ void BaseTrieSection::appendNextParsers(BaseTrieSection * _nextParser) {
     nextParser.push_back(_nextParser);
 }
 
+static std::atomic<int64_t> allocationCounter(0);
+
+int64_t getAllocationCounter() {
+    return allocationCounter.load(std::memory_order_relaxed);
+}
+
+void countAllocation() {
+    allocationCounter.fetch_add(1, std::memory_order_relaxed);
+}
+
 // Current section context
-TrieSectionContext::TrieSectionContext(BaseTrieSection * const _section, const LineResult & prevResult) :
-    prevParseResults(prevResult),
-    section(_section)
-{
+void TrieSectionContext::init( BaseTrieSection * _section, int _captures ) {
+    section = _section;
+    captures = _captures;
     accId = section->getAccumulateId();
+    accStr.resize(0);
+    sectionContext = TrieContext();
 }
 
 // return PROCESS_RESULT flags
@@ -58,42 +64,136 @@ uint32_t TrieSectionContext::processChar( QChar ch )
     uint32_t res = section->processChar(sectionContext, ch);
 
     // Note, last symbol need to be excluded
-    if (accId>=0)
+    if (accId>=0) {
+        if (accStr.size() >= accStr.capacity())
+            countAllocation();
         accStr += ch;
+    }
 
     return res;
 }
 
-LineResult TrieSectionContext::calcResult() const {
-    if (accId<0)
-        return prevParseResults;
-
-    return LineResult(prevParseResults, SectionResult(accStr.left( std::max(accStr.size()-1,0) ) ,accId) );
-}
-
 
 // Context from the whole line
 TrieLineContext::TrieLineContext() {}
 
 TrieLineContext::~TrieLineContext() {
     releaseData();
+    for (auto cnt : pool) {
+        delete cnt;
+    }
+    pool.clear();
+    freeContexts.clear();
 }
 
 void TrieLineContext::releaseData() {
     for (auto cnt : contexts) {
-        delete cnt;
+        releaseContext(cnt);
     }
-    contexts.clear();
+    contexts.resize(0);
 }
 
 void TrieLineContext::reset() {
     releaseData();
 }
 
+TrieSectionContext * TrieLineContext::allocContext( BaseTrieSection * section, int captures ) {
+    TrieSectionContext * cnt = nullptr;
+    if (freeContexts.isEmpty()) {
+        countAllocation();
+        cnt = new TrieSectionContext();
+        pool.push_back(cnt);
+    }
+    else {
+        cnt = freeContexts.takeLast();
+    }
+
+    if (captures>=0)
+        captureNodes[captures].refs++;
+
+    cnt->init(section, captures);
+    return cnt;
+}
+
+void TrieLineContext::releaseContext( TrieSectionContext * context ) {
+    releaseCapture(context->captures);
+    context->captures = -1;
+    freeContexts.push_back(context);
+}
+
+// Captures for the next sections: context captures plus accumulated data if any
+int TrieLineContext::acquireResult( const TrieSectionContext * context ) {
+    if (context->accId<0) {
+        if (context->captures>=0)
+            captureNodes[context->captures].refs++;
+        return context->captures;
+    }
+
+    int idx;
+    if (freeCaptures.isEmpty()) {
+        countAllocation();
+        idx = captureNodes.size();
+        captureNodes.push_back( CaptureNode() );
+    }
+    else {
+        idx = freeCaptures.takeLast();
+    }
+
+    CaptureNode & node = captureNodes[idx];
+    node.prev = context->captures;
+    node.refs = 1;
+    if (node.prev>=0)
+        captureNodes[node.prev].refs++;
+
+    // Note, last symbol need to be excluded
+    const int len = std::max(context->accStr.size()-1, 0);
+    QString & str = node.res.strData;
+    if ( len>0 && (!str.isDetached() || str.capacity()<len) )
+        countAllocation(); // previous value was shared with a result or buffer is too small
+    str.resize(0);
+    str.append( context->accStr.constData(), len );
+    node.res.dataId = context->accId;
+    return idx;
+}
+
+void TrieLineContext::releaseCapture( int captures ) {
+    while (captures>=0) {
+        CaptureNode & node = captureNodes[captures];
+        Q_ASSERT(node.refs>0);
+        if (--node.refs > 0)
+            return;
+
+        freeCaptures.push_back(captures);
+        captures = node.prev;
+    }
+}
+
+void TrieLineContext::pushReadyResult( int captures ) {
+    int len = 0;
+    for ( int c = captures; c>=0; c = captureNodes[c].prev )
+        len++;
+
+    readyResult.push_back( LineResult() );
+    if (len==0)
+        return;
+
+    countAllocation();
+    QVector<SectionResult> & parseResult = readyResult.last().parseResult;
+    parseResult.resize(len);
+    for ( int c = captures; c>=0; c = captureNodes[c].prev )
+        parseResult[--len] = captureNodes[c].res;
+}
+
 // Process char against whole context
 void TrieLineContext::processChar( BaseTrieSection * headSection, QChar ch ) {
     // Process what we already have
+    processContexts(ch);
 
+    // Every iteration try to start a new parser
+    startNewSectionAndProcess( headSection, -1, ch );
+}
+
+void TrieLineContext::processContexts( QChar ch ) {
     int sz = contexts.size();
     for ( int i=sz-1; i>=0; i-- ) {
         TrieSectionContext* cont = contexts[i];
@@ -110,12 +210,15 @@ void TrieLineContext::processChar( BaseTrieSection * headSection, QChar ch ) {
         }
 
         // FAIL, DONE(not Keep) should be here
-        delete cont;
+        releaseContext(cont);
         contexts.remove(i);
     }
+}
 
-    // Every iteration try to start a new parser
-    startNewSectionAndProcess( headSection, LineResult(), ch );
+void TrieLineContext::appendSections( const QVector<BaseTrieSection*> & sections ) {
+    for (auto s : sections) {
+        contexts.push_back( allocContext(s, -1) );
+    }
 }
 
 void TrieLineContext::processContext(TrieSectionContext* context, bool done, bool startNext, QChar ch) {
@@ -123,25 +226,30 @@ void TrieLineContext::processContext(TrieSectionContext* context, bool done, boo
     const QVector<BaseTrieSection*> & next = context->getNextSections();
 
     if (next.empty()) { // last in the chain - mean we can get results, but we can't spawn new sections
-        if ( done )
-            readyResult.push_back( context->calcResult() );
+        if ( done ) {
+            int captures = acquireResult(context);
+            pushReadyResult(captures);
+            releaseCapture(captures);
+        }
         return;
     }
 
+    int captures = acquireResult(context);
     if (startNext) {
         for (auto ns : next) {
-            startNewSectionAndProcess( ns, context->calcResult(), ch );
+            startNewSectionAndProcess( ns, captures, ch );
         }
     }
     else {
         // Just append new sections
         for (auto ns : next) {
-            contexts.push_back( new TrieSectionContext(ns, context->calcResult()) );
+            contexts.push_back( allocContext(ns, captures) );
         }
     }
+    releaseCapture(captures);
 }
 
-void TrieLineContext::startNewSectionAndProcess( BaseTrieSection * newSection, LineResult && prevResult, QChar ch ) {
+void TrieLineContext::startNewSectionAndProcess( BaseTrieSection * newSection, int captures, QChar ch ) {
 
     { // preliminary test. Just test a symbol and discard if no match
         TrieContext tc;
@@ -154,7 +262,7 @@ void TrieLineContext::startNewSectionAndProcess( BaseTrieSection * newSection, L
             return;
     }
 
-    TrieSectionContext * newContext = new TrieSectionContext(newSection, prevResult );
+    TrieSectionContext * newContext = allocContext(newSection, captures );
     uint32_t res = newContext->processChar(ch);
 
     if ( res & (BaseTrieSection::PROCESS_RESULT::DONE | BaseTrieSection::PROCESS_RESULT::START_NEXT) ) {
@@ -169,8 +277,8 @@ void TrieLineContext::startNewSectionAndProcess( BaseTrieSection * newSection, L
         return;
     }
 
-    // Seems like nobody need that. Deleting the context
-    delete newContext;
+    // Seems like nobody need that. Returning the context to the pool
+    releaseContext(newContext);
 }
 
 
@@ -178,11 +286,14 @@ void TrieLineContext::startNewSectionAndProcess( BaseTrieSection * newSection, L
 //
 TrieLineParser::TrieLineParser(int _parserId) :
     parserId(_parserId)
-{}
+{
+    std::fill( firstChars, firstChars+256, true );
+}
 
 TrieLineParser::TrieLineParser(int _parserId, QVector<BaseTrieSection*> && ss)  :
     parserId(_parserId), sections(ss)
 {
+    std::fill( firstChars, firstChars+256, true );
     connectLineSections( sections.size() - ss.size() );
 }
 
@@ -217,12 +328,27 @@ void TrieLineParser::connectLineSections( int lastAddIdx ) {
         s2->setParentParsers(s1);
         s1->appendNextParsers(s2);
     }
+
+    if ( lastAddIdx==0 && !sections.isEmpty() )
+        updateFirstChars(); // head was just added
+}
+
+void TrieLineParser::updateFirstChars() {
+    // Sections are checking the first char with a clean context, so the result for every char is final
+    BaseTrieSection * head = sections.front();
+    for ( int ch=0; ch<256; ch++ ) {
+        TrieContext tc;
+        firstChars[ch] = head->processChar(tc, QChar((ushort)ch)) != BaseTrieSection::PROCESS_RESULT::FAIL;
+    }
 }
 
 // return true if TrieLineContext has some result;
 bool TrieLineParser::process( QChar ch, TrieLineContext * context ) {
     Q_ASSERT( sections.size()>0 );
-    context->processChar( sections.front(), ch );
+    if (canStartWith(ch))
+        context->processChar( sections.front(), ch );
+    else
+        context->processContexts( ch ); // head will fail anyway
     return context->hasResults();
 }
 
@@ -38,8 +38,6 @@ public:
     ~LineResult() = default;
     LineResult(const LineResult &) = default;
 
-    LineResult(const LineResult & other, SectionResult && next );
-
     LineResult & operator=(const LineResult &) = default;
 
     void AddResult(const SectionResult & res) {parseResult.push_back(res);}
@@ -83,29 +81,67 @@ public:
     BaseTrieSection * getPrevParser() const { return prevParser; }
     const QVector<BaseTrieSection*> & getNextParser() const { return nextParser; }
 
+    // Fixed string that this section matches, used by TrieAutomaton to compile the section.
+    // New line is presented as QChar::LineFeed.
+    // Return false if section can't be presented as a fixed string.
+    virtual bool getLiteral(QString & literal) const { Q_UNUSED(literal); return false; }
+
 protected:
     int accumulateId;
     BaseTrieSection * prevParser = nullptr; // Parent parser in the chain, can be only one
     QVector<BaseTrieSection*> nextParser; // Next parsers in the chain. Can be many
 };
 
-// Current section context
+// Number of the heap allocations that was made by the parsing engine: contexts pool,
+// captures, accumulation buffers and ready results. Steady state parsing expected to
+// allocate for ready results only.
+int64_t getAllocationCounter();
+void countAllocation();
+
+// Line parsers head sections start attempts. Skipped - attempts that was avoided because
+// the head section can't start from the char (see TrieLineParser::canStartWith)
+struct DispatchStats {
+    int64_t attempts = 0;
+    int64_t skipped  = 0;
+};
+
+// Sizes of the parser own pools. They grow while warming up and must stay the same for the steady state parsing
+struct PoolStats {
+    int contexts = 0; // Section contexts that was ever created
+    int captures = 0; // Capture nodes that was ever created
+
+    bool operator == (const PoolStats & other) const { return contexts==other.contexts && captures==other.captures; }
+};
+
+// Captured value. Captures from a single line make a persistent list from the last to
+// the first one. Contexts spawned from the same predecessor share the list tail.
+struct CaptureNode {
+    SectionResult res;
+    int prev = -1; // previous capture index, -1 for the first one
+    int refs = 0;  // Number of contexts and captures that reference this node
+};
+
+// Current section context. Instances are pooled by TrieLineContext and reused.
 class TrieSectionContext {
+    friend class TrieLineContext;
 public:
-    TrieSectionContext(BaseTrieSection * const section, const LineResult & prevResult );
+    TrieSectionContext() = default;
+
+    TrieSectionContext(const TrieSectionContext&) = delete;
+    TrieSectionContext & operator=(const TrieSectionContext&) = delete;
+
+    // Prepare context for processing of a new section. Accumulation buffer keeps its memory.
+    void init( BaseTrieSection * section, int captures );
 
     // return PROCESS_RESULT flags
     uint32_t processChar( QChar ch );
 
-    // Calculate results for current state
-    LineResult calcResult() const;
-
     const QVector<BaseTrieSection*> & getNextSections() const { return section->getNextParser(); }
 
 protected:
-    LineResult        prevParseResults;
-    BaseTrieSection * const section; // section related to the context.
-    int               accId;      // Accumulator ID. If negative - no accumulation need to be made.
+    BaseTrieSection * section = nullptr; // section related to the context.
+    int               captures = -1; // Head of the captures list from previous sections. Context holds the reference
+    int               accId = -1;    // Accumulator ID. If negative - no accumulation need to be made.
     QString           accStr;     // Accumulated String.
     TrieContext       sectionContext;
 };
@@ -122,18 +158,47 @@ public:
     // Process char against whole context
     void processChar( BaseTrieSection * headSection, QChar ch );
 
+    // Process char with already started sections only. Head section is not started.
+    void processContexts( QChar ch );
+
+    // Start sections that will process the input from the next char. Used when the previous
+    // sections without captures was matched outside of this context (see TrieAutomaton)
+    void appendSections( const QVector<BaseTrieSection*> & sections );
+    // Add result that was matched outside of this context (see TrieAutomaton)
+    void appendReadyResult( const LineResult & result ) { readyResult.push_back(result); }
+
+    // true if some sections are in progress
+    bool isActive() const {return !contexts.isEmpty();}
+
     void reset(); // Reset whole context
 
+    PoolStats getPoolStats() const { PoolStats st; st.contexts = pool.size(); st.captures = captureNodes.size(); return st; }
+
     bool hasResults() const {return !readyResult.empty();}
     const QVector<LineResult> & getReadyResult() const {return readyResult;}
     // Clean up the result that we get from ready
-    void resetResults() {readyResult.clear();}
+    void resetResults() {readyResult.resize(0);}
 private:
     void releaseData();
     void processContext(TrieSectionContext* context, bool done, bool startNext, QChar ch);
-    void startNewSectionAndProcess( BaseTrieSection * newSection, LineResult && prevResult, QChar ch );
+    void startNewSectionAndProcess( BaseTrieSection * newSection, int captures, QChar ch );
+
+    // Contexts pool
+    TrieSectionContext * allocContext( BaseTrieSection * section, int captures );
+    void releaseContext( TrieSectionContext * context );
+
+    // Captures pool. Returned index has a reference that caller need to release
+    int  acquireResult( const TrieSectionContext * context );
+    void releaseCapture( int captures );
+    void pushReadyResult( int captures );
 protected:
-    QVector< TrieSectionContext* > contexts; // owners those objects
+    QVector< TrieSectionContext* > contexts; // Active contexts, pointers from the pool
+    QVector< TrieSectionContext* > pool; // owners those objects
+    QVector< TrieSectionContext* > freeContexts;
+
+    QVector< CaptureNode > captureNodes;
+    QVector< int >         freeCaptures;
+
     QVector<LineResult> readyResult;
 };
 
@@ -151,6 +216,12 @@ public:
 
     int getParserId() const {return parserId;}
 
+    // First section in the chain
+    BaseTrieSection * getHeadSection() const { Q_ASSERT(sections.size()>0); return sections.front(); }
+
+    // true if head section can start from this char. Chars outside of Latin1 are not indexed and always can start.
+    bool canStartWith( QChar ch ) const { ushort ucs = ch.unicode(); return ucs>=256 || firstChars[ucs]; }
+
     // Adding section/line for parsing and pair them in chain
     TrieLineParser & addSection( BaseTrieSection* s );
     TrieLineParser & addLine( QVector<BaseTrieSection*> ss );
@@ -161,9 +232,12 @@ public:
 private:
     // Put sections in line
     void connectLineSections( int lastAddIdx );
+    // Probe head section with all Latin1 chars
+    void updateFirstChars();
 protected:
     const int parserId;
     QVector< BaseTrieSection* > sections; // Owns section instances
+    bool firstChars[256]; // Latin1 chars that head section accepts
 };
 
 }
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "tries/inputparser.h"
+#include "tries/trieautomaton.h"
+#include "util/Trace.h"
 
 namespace tries {
 
@@ -29,10 +31,13 @@ QDebug operator<<(QDebug dbg, const ParsingResult& res)
 }
 
 
-InputParser::InputParser() {
+InputParser::InputParser(ENGINE _engine) :
+    engine(_engine)
+{
 }
 
 InputParser::~InputParser() {
+    resetAutomaton();
     for ( const auto & p : lines) {
         delete p.parser;
         delete p.context;
@@ -40,13 +45,27 @@ InputParser::~InputParser() {
     lines.clear();
 }
 
+void InputParser::resetAutomaton() {
+    if (automaton == nullptr)
+        return;
+
+    delete automaton;
+    automaton = nullptr;
+
+    // Automaton keeps started sections at the contexts, they are not valid any more
+    for ( const auto & p : lines)
+        p.context->reset();
+}
+
 // append a new line parser.
 // parser must be on the heap and pnership will be transferred to this
 void InputParser::appendLineParser( TrieLineParser* parser ) {
+    resetAutomaton();
     lines.push_back( LineInfo( parser, new TrieLineContext() ) );
 }
 
 bool InputParser::deleteLineParser(int parserId) {
+    resetAutomaton();
     int sz = lines.size();
     for (int t=sz-1; t>=0; t--) {
         if (lines[t].parser->getParserId() == parserId) {
@@ -58,31 +77,102 @@ bool InputParser::deleteLineParser(int parserId) {
     return lines.size() < sz;
 }
 
+PoolStats InputParser::getPoolStats() const {
+    PoolStats res;
+    for ( const auto & p : lines) {
+        PoolStats st = p.context->getPoolStats();
+        res.contexts += st.contexts;
+        res.captures += st.captures;
+    }
+    return res;
+}
+
 QVector<ParsingResult> InputParser::processInput(QString input) {
+    trace::Scope traceScope("parser", "processInput");
     // processing input symbol by symbol
     int len = input.length();
 
     QVector<ParsingResult> result;
-
     for ( int l=0; l<len; l++ ) {
-        QChar ch = input[l];
-
-        for ( LineInfo & p : lines ) {
-            if (p.parser->process(ch, p.context))
-            { // get a result...
-                const QVector<LineResult> & res = p.context->getReadyResult();
-                for ( auto & r : res ) {
-                    result.push_back( ParsingResult(p.parser->getParserId(), r ) );
-                }
-                p.context->resetResults();
-
-                // not resetting statuses for the rest.
-                // Naturally reset should be atchieved.
-            }
+        processChar( input[l], result );
+    }
+    if (traceScope.isActive())
+        traceScope.setArgs( trace::arg("chars", len) + "," + trace::arg("results", result.size()) );
+    return result;
+}
+
+QVector<ParsingResult> InputParser::processInput(const char * utf8, int size) {
+    trace::Scope traceScope("parser", "processInput");
+    QVector<ParsingResult> result;
+    const uchar * data = reinterpret_cast<const uchar *>(utf8);
+
+    for ( int i=0; i<size; ) {
+        uint ch = data[i];
+        if ( ch < 0x80 ) { // ascii, most common case
+            processChar( QChar(ushort(ch)), result );
+            i++;
+            continue;
+        }
+
+        int len = 0;
+        if ( (ch & 0xE0) == 0xC0 ) { len = 2; ch &= 0x1F; }
+        else if ( (ch & 0xF0) == 0xE0 ) { len = 3; ch &= 0x0F; }
+        else if ( (ch & 0xF8) == 0xF0 ) { len = 4; ch &= 0x07; }
+
+        bool ok = len>0 && i+len<=size;
+        for ( int k=1; ok && k<len; k++ ) {
+            ok = (data[i+k] & 0xC0) == 0x80;
+            ch = (ch<<6) | (data[i+k] & 0x3F);
+        }
+
+        if (!ok) {
+            processChar( QChar(QChar::ReplacementCharacter), result );
+            i++;
+            continue;
+        }
+        i += len;
+
+        if ( ch >= 0x10000 ) { // surrogate pair, the same as QString has
+            processChar( QChar( ushort(0xD800 + ((ch-0x10000)>>10)) ), result );
+            processChar( QChar( ushort(0xDC00 + ((ch-0x10000) & 0x3FF)) ), result );
+        }
+        else {
+            processChar( QChar(ushort(ch)), result );
         }
     }
+    if (traceScope.isActive())
+        traceScope.setArgs( trace::arg("bytes", size) + "," + trace::arg("results", result.size()) );
     return result;
 }
 
+void InputParser::processChar(QChar ch, QVector<ParsingResult> & result) {
+    if (engine == ENGINE::AUTOMATON) {
+        if (automaton == nullptr)
+            automaton = new TrieAutomaton(lines);
+
+        automaton->processChar( ch, lines, result, dispatchStats );
+        return;
+    }
+
+    for ( LineInfo & p : lines ) {
+        if (p.parser->canStartWith(ch))
+            dispatchStats.attempts++;
+        else
+            dispatchStats.skipped++;
+
+        if (p.parser->process(ch, p.context))
+        { // get a result...
+            const QVector<LineResult> & res = p.context->getReadyResult();
+            for ( auto & r : res ) {
+                result.push_back( ParsingResult(p.parser->getParserId(), r ) );
+            }
+            p.context->resetResults();
+
+            // not resetting statuses for the rest.
+            // Naturally reset should be atchieved.
+        }
+    }
+}
+
 
 }
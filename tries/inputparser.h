@@ -22,6 +22,7 @@
 namespace tries {
 
 class TrieLineParser;
+class TrieAutomaton;
 
 struct ParsingResult {
     const int parserId;
@@ -51,7 +52,11 @@ struct LineInfo {
 class InputParser
 {
 public:
-    InputParser();
+    // AUTOMATON - line parsers are compiled into the single TrieAutomaton, see trieautomaton.h
+    // REFERENCE - every char is processed by every line parser. Slow, but simple. Used to validate AUTOMATON
+    enum class ENGINE { AUTOMATON, REFERENCE };
+
+    InputParser(ENGINE engine = ENGINE::AUTOMATON);
     ~InputParser();
 
     InputParser(const InputParser & other) = delete;
@@ -65,9 +70,22 @@ public:
     bool deleteLineParser(int parserId);
 
     QVector<ParsingResult> processInput(QString input);
+    // Process UTF-8 data without conversion to QString. Data must end with a complete char.
+    QVector<ParsingResult> processInput(const char * utf8, int size);
+
+    const DispatchStats & getDispatchStats() const {return dispatchStats;}
+    // Pools of all line contexts
+    PoolStats getPoolStats() const;
+
+private:
+    void resetAutomaton();
+    void processChar(QChar ch, QVector<ParsingResult> & result);
 
 protected:
+    const ENGINE engine;
     QVector< LineInfo > lines;
+    TrieAutomaton * automaton = nullptr; // Compiled from lines on first input. Owner
+    DispatchStats dispatchStats;
 };
 
 }
@@ -40,31 +40,47 @@ Mwc713InputParser::Mwc713InputParser() {
     initRecovery();
 }
 
-Mwc713InputParser::~Mwc713InputParser() {}
+Mwc713InputParser::~Mwc713InputParser() {
+    const DispatchStats & stats = parser.getDispatchStats();
+    logger::logInfo("Mwc713InputParser", "Line parsers attempts: " + QString::number(stats.attempts) +
+                    ", skipped: " + QString::number(stats.skipped) );
+}
 
 // Main routine processing with backed wallet printed
 // Resilting will be delieved async through signals
 void Mwc713InputParser::processInput(QString message) {
     qDebug() << "Processing wallet input: '" << message << "'";
+    emitResults( parser.processInput(message) );
+}
+
+void Mwc713InputParser::processInput(const char * utf8, int size, int64_t outputTime) {
+    qDebug() << "Processing wallet input: '" << QByteArray::fromRawData(utf8, size) << "'";
+    emitResults( parser.processInput(utf8, size), outputTime );
+}
 
-    QVector<ParsingResult> results = parser.processInput(message);
+void Mwc713InputParser::emitResults(const QVector<ParsingResult> & results, int64_t outputTime) {
+    if (results.isEmpty())
+        return;
+
+    // All events from the chunk are delivered with a single signal
+    QVector<wallet::WEvent> events;
+    events.reserve(results.size());
 
     for (auto & res : results) {
         qDebug() << "Getting results: " << res;
 
-        QString message;
-        for (auto & pr : res.result.parseResult) {
-            if (message.length()>0)
-                message += "|";
-            message += pr.strData;
-        }
-
-        wallet::WALLET_EVENTS evt = (wallet::WALLET_EVENTS) res.parserId;
+        // Captured sections are passed as they are, no need to join and split them back
+        wallet::WEvent evt( (wallet::WALLET_EVENTS) res.parserId );
+        evt.outputTime = outputTime;
+        for (auto & pr : res.result.parseResult)
+            evt.addParam(pr.strData);
 
-        logger::logParsingEvent( evt, message );
+        logger::logParsingEvent( evt.event, evt.printParams() );
 
-        emit sgGenericEvent( evt, message);
+        events.push_back(evt);
     }
+
+    emit sgEvents(events);
 }
 
 void Mwc713InputParser::initWalletReady() {
@@ -37,8 +37,11 @@ public:
     Mwc713InputParser & operator=(const Mwc713InputParser & other) = delete;
 
     // Main routine processing with backed wallet printed
-    // Resilting will be delieved async through signals
+    // Resilting will be delieved as a single sgEvents signal
     void processInput(QString message);
+    // The same for UTF-8 data. Data must end with a complete char.
+    // outputTime - when the data was read from mwc713, it is set to every event (WEvent::outputTime)
+    void processInput(const char * utf8, int size, int64_t outputTime = 0);
 
 private:
 
@@ -60,8 +63,11 @@ private:
 
     void initGenericError(); // All error messages
 
+    void emitResults(const QVector<ParsingResult> & results, int64_t outputTime = 0);
+
 signals:
-    void sgGenericEvent( wallet::WALLET_EVENTS event, QString message);
+    // Events that are parsed from a single processInput call, in order as mwc713 printed them
+    void sgEvents( const QVector<wallet::WEvent> & events );
 
 protected:
     InputParser parser; // Work horse thet is parsing all inputs
@@ -42,6 +42,16 @@ uint32_t TriePhraseSection::processChar(TrieContext & context, QChar ch) {
     return res;
 }
 
+bool TriePhraseSection::getLiteral(QString & literal) const {
+    // Phrase with new line symbols is matched by exact symbol, literal can't express that
+    for (QChar ch : phrase) {
+        if ( ch==QChar::LineSeparator || ch==QChar::LineFeed || ch==QChar::CarriageReturn )
+            return false;
+    }
+    literal = phrase;
+    return !literal.isEmpty();
+}
+
 // Parsing the version like: '2.0.0'
 TrieVersionSection::TrieVersionSection(int accumulateId) :
     BaseTrieSection(accumulateId)
@@ -76,6 +86,11 @@ uint32_t TrieNewLineSection::processChar(TrieContext & context, QChar ch) {
         return PROCESS_RESULT::FAIL;
 }
 
+bool TrieNewLineSection::getLiteral(QString & literal) const {
+    literal = QString(QChar::LineFeed);
+    return true;
+}
+
 TrieAnySection::TrieAnySection(int _lenLimit, uint32_t _processMask,
         QString _acceptSymbols, QString _stopSymbols,
         int accumulateId ) :
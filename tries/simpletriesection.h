@@ -25,6 +25,7 @@ public:
     TriePhraseSection(QString phrase, int accumulateId=-1);
 
     virtual uint32_t processChar(TrieContext & context, QChar ch) override;
+    virtual bool getLiteral(QString & literal) const override;
 protected:
     QString phrase;
 };
@@ -43,6 +44,7 @@ class TrieNewLineSection : public BaseTrieSection {
 public:
     TrieNewLineSection();
     virtual uint32_t processChar(TrieContext & context, QChar ch) override;
+    virtual bool getLiteral(QString & literal) const override;
 };
 
 // Anything that match the set of letters
@@ -0,0 +1,242 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tries/trieautomaton.h"
+#include "tries/inputparser.h"
+#include <climits>
+
+namespace tries {
+
+// Merge two sorted vectors, skipping the duplicates
+static QVector<int> mergeSorted( const QVector<int> & a, const QVector<int> & b ) {
+    QVector<int> res;
+    res.reserve( a.size() + b.size() );
+    int i=0, j=0;
+    while ( i<a.size() || j<b.size() ) {
+        int v;
+        if ( j>=b.size() || (i<a.size() && a[i]<=b[j]) )
+            v = a[i++];
+        else
+            v = b[j++];
+
+        if (res.isEmpty() || res.last()!=v)
+            res.push_back(v);
+    }
+    return res;
+}
+
+TrieAutomaton::TrieAutomaton(const QVector<LineInfo> & lines) {
+    for ( int i=0; i<256; i++ )
+        latin1Classes[i] = 0;
+    // All new line symbols are the same for TrieNewLineSection
+    latin1Classes[QChar::LineFeed] = 1;
+    latin1Classes[QChar::CarriageReturn] = 1;
+    otherClasses[QChar::LineSeparator] = 1;
+
+    QVector< QVector<int> > prefixes;
+
+    for ( int idx=0; idx<lines.size(); idx++ ) {
+        // Collecting the fixed sections from the head. Sections with accumulators are
+        // not compiled because they need to deliver the data.
+        QString prefix;
+        QVector<BaseTrieSection*> tail{ lines[idx].parser->getHeadSection() };
+        while (tail.size()==1) {
+            QString literal;
+            if ( tail[0]->getAccumulateId()>=0 || !tail[0]->getLiteral(literal) )
+                break;
+            prefix += literal;
+            tail = tail[0]->getNextParser();
+        }
+
+        LinePlan plan;
+        if (prefix.isEmpty()) {
+            plan.mode = LINE_MODE::ALWAYS;
+            alwaysLines.push_back(idx);
+            prefixes.push_back( QVector<int>() );
+        }
+        else {
+            plan.mode = tail.isEmpty() ? LINE_MODE::FULL : LINE_MODE::PREFIX;
+            plan.tail = tail;
+            prefixes.push_back( registerLiteral(prefix) );
+        }
+        plans.push_back(plan);
+    }
+
+    for ( int ch=0; ch<256; ch++ ) {
+        for ( int idx : alwaysLines ) {
+            if ( lines[idx].parser->canStartWith( QChar((ushort)ch) ) )
+                alwaysStart[ch].push_back(idx);
+        }
+    }
+
+    compile(prefixes);
+}
+
+QVector<int> TrieAutomaton::registerLiteral( const QString & literal ) {
+    QVector<int> res;
+    for ( QChar ch : literal ) {
+        int cls = getCharClass(ch);
+        if (cls==0) {
+            cls = classNumber++;
+            ushort ucs = ch.unicode();
+            if (ucs<256)
+                latin1Classes[ucs] = cls;
+            else
+                otherClasses[ucs] = cls;
+        }
+        res.push_back(cls);
+    }
+    return res;
+}
+
+void TrieAutomaton::compile( const QVector< QVector<int> > & prefixes ) {
+    transitions.clear();
+    stateOutputs.clear();
+
+    // Root state
+    transitions.fill(-1, classNumber);
+    stateOutputs.push_back( QVector<int>() );
+
+    // Build the trie
+    for ( int idx=0; idx<prefixes.size(); idx++ ) {
+        const QVector<int> & prefix = prefixes[idx];
+        if (prefix.isEmpty())
+            continue;
+
+        int st = 0;
+        for (int cls : prefix) {
+            int next = transitions[st*classNumber + cls];
+            if (next<0) {
+                next = stateOutputs.size();
+                transitions[st*classNumber + cls] = next;
+                transitions.insert( transitions.size(), classNumber, -1 );
+                stateOutputs.push_back( QVector<int>() );
+            }
+            st = next;
+        }
+        stateOutputs[st].push_back(idx); // idx is growing, so outputs are sorted
+    }
+
+    // Aho-Corasick failure links, converting trie into the complete transition table.
+    // States are processed by depth, so failure state is always ready.
+    QVector<int> fail( stateOutputs.size(), 0 );
+    QVector<int> queue;
+
+    for ( int cls=0; cls<classNumber; cls++ ) {
+        int next = transitions[cls];
+        if (next<0) {
+            transitions[cls] = 0;
+        }
+        else {
+            fail[next] = 0;
+            queue.push_back(next);
+        }
+    }
+
+    for ( int i=0; i<queue.size(); i++ ) {
+        int st = queue[i];
+        int fst = fail[st];
+
+        if ( !stateOutputs[fst].isEmpty() )
+            stateOutputs[st] = mergeSorted( stateOutputs[st], stateOutputs[fst] );
+
+        for ( int cls=0; cls<classNumber; cls++ ) {
+            int & next = transitions[st*classNumber + cls];
+            if (next<0) {
+                next = transitions[fst*classNumber + cls];
+            }
+            else {
+                fail[next] = transitions[fst*classNumber + cls];
+                queue.push_back(next);
+            }
+        }
+    }
+
+    state = 0;
+}
+
+void TrieAutomaton::processChar( QChar ch, const QVector<LineInfo> & lines, QVector<ParsingResult> & result, DispatchStats & stats ) {
+    state = transitions[ state*classNumber + getCharClass(ch) ];
+    const QVector<int> & matched = stateOutputs[state];
+
+    ushort ucs = ch.unicode();
+    const QVector<int> & starting = ucs<256 ? alwaysStart[ucs] : alwaysLines;
+    stats.attempts += starting.size();
+    stats.skipped  += lines.size() - starting.size();
+
+    if ( matched.isEmpty() && activeLines.isEmpty() && starting.isEmpty() )
+        return; // Nothing to do, most common case
+
+    // Lines to process in the order of registration: with started sections, starting always and just matched
+    touchedLines.resize(0);
+    {
+        int a = 0, b = 0, c = 0;
+        while (true) {
+            int idx = INT_MAX;
+            if ( a<activeLines.size() )
+                idx = std::min(idx, activeLines[a]);
+            if ( b<starting.size() )
+                idx = std::min(idx, starting[b]);
+            if ( c<matched.size() )
+                idx = std::min(idx, matched[c]);
+            if (idx==INT_MAX)
+                break;
+
+            touchedLines.push_back(idx);
+            if ( a<activeLines.size() && activeLines[a]==idx ) a++;
+            if ( b<starting.size() && starting[b]==idx ) b++;
+            if ( c<matched.size() && matched[c]==idx ) c++;
+        }
+    }
+
+    activeLines.resize(0);
+    int m = 0;
+    for ( int idx : touchedLines ) {
+        while ( m<matched.size() && matched[m]<idx )
+            m++;
+        bool prefixMatched = m<matched.size() && matched[m]==idx;
+
+        const LineInfo & li = lines[idx];
+        const LinePlan & plan = plans[idx];
+
+        switch (plan.mode) {
+            case LINE_MODE::ALWAYS:
+                li.parser->process(ch, li.context);
+                if (li.context->isActive())
+                    activeLines.push_back(idx);
+                break;
+            case LINE_MODE::FULL:
+                if (prefixMatched)
+                    li.context->appendReadyResult( LineResult() );
+                break;
+            case LINE_MODE::PREFIX:
+                // The same order as TrieLineContext::processChar: started sections first, then new one
+                li.context->processContexts(ch);
+                if (prefixMatched)
+                    li.context->appendSections( plan.tail );
+                if (li.context->isActive())
+                    activeLines.push_back(idx);
+                break;
+        }
+
+        if (li.context->hasResults()) {
+            for ( auto & r : li.context->getReadyResult() ) {
+                result.push_back( ParsingResult(li.parser->getParserId(), r ) );
+            }
+            li.context->resetResults();
+        }
+    }
+}
+
+}
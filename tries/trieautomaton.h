@@ -0,0 +1,99 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_TRIEAUTOMATON_H
+#define MWC_QT_WALLET_TRIEAUTOMATON_H
+
+#include <QVector>
+#include <QHash>
+#include "baseparser.h"
+
+namespace tries {
+
+struct LineInfo;
+struct ParsingResult;
+
+// Deterministic automaton compiled from all line parsers of the InputParser.
+//
+// Every line parser starts with a chain of fixed sections (phrases and new lines). Those
+// prefixes are compiled into a single Aho-Corasick table, so every input char costs a single
+// table step no matter how many parsers are registered. When a prefix is matched, the rest of
+// the chain (capture sections) is started at the parser's TrieLineContext and processed until
+// it finishes or fails. Parsers that doesn't start with a fixed section are processed for every
+// char, but only if they can start from that char or have started sections.
+//
+// Results are the same as InputParser produce with ENGINE::REFERENCE.
+class TrieAutomaton {
+public:
+    // lines must stay unchanged while automaton is in use
+    TrieAutomaton(const QVector<LineInfo> & lines);
+
+    TrieAutomaton(const TrieAutomaton & other) = delete;
+    TrieAutomaton & operator=(const TrieAutomaton & other) = delete;
+
+    // Process the single char. Ready results will be appended to result.
+    // stats - head sections start attempts. Compiled prefixes are never attempted
+    void processChar( QChar ch, const QVector<LineInfo> & lines, QVector<ParsingResult> & result, DispatchStats & stats );
+
+    int getStatesNumber() const {return stateOutputs.size();}
+private:
+    // Char class for table lookup
+    int getCharClass( QChar ch ) const {
+        ushort ucs = ch.unicode();
+        if (ucs<256)
+            return latin1Classes[ucs];
+        return otherClasses.value(ucs, 0);
+    }
+
+    // Register chars of the literal. Return literal as a chars classes
+    QVector<int> registerLiteral( const QString & literal );
+
+    // Build the table from the prefixes
+    void compile( const QVector< QVector<int> > & prefixes );
+
+private:
+    enum class LINE_MODE {
+        PREFIX, // Prefix is compiled into the table, the rest is started by the context
+        FULL,   // All sections are compiled into the table. Match is a result
+        ALWAYS  // Can't be compiled, line parser need to process every char
+    };
+
+    struct LinePlan {
+        LINE_MODE mode = LINE_MODE::ALWAYS;
+        QVector<BaseTrieSection*> tail; // Sections to start when prefix is matched
+    };
+
+    QVector<LinePlan> plans; // Index is the same as at lines
+
+    // Chars classes. 0 - any char that is not in the literals, 1 - new line
+    int     classNumber = 2;
+    int     latin1Classes[256];
+    QHash<ushort, int> otherClasses;
+
+    // Table: state*classNumber + charClass => next state. 0 is a root state
+    QVector<int> transitions;
+    // Lines indexes (sorted) with prefixes that are matched at that state
+    QVector< QVector<int> > stateOutputs;
+
+    int state = 0; // Current state
+
+    QVector<int> alwaysLines; // sorted lines in ALWAYS mode
+    QVector<int> alwaysStart[256]; // sorted lines in ALWAYS mode that can start from the Latin1 char
+    QVector<int> activeLines; // sorted lines that has started sections
+    QVector<int> touchedLines; // lines to process with current char. Keeping to reuse the memory
+};
+
+}
+
+#endif //MWC_QT_WALLET_TRIEAUTOMATON_H
@@ -14,10 +14,13 @@
 
 #include "Log.h"
 #include "ioutils.h"
+#include "Trace.h"
 #include <QFileInfo>
 #include <QDir>
 #include <QApplication>
 #include <QDateTime>
+#include <QMutex>
+#include <atomic>
 #include "../wallet/mwc713task.h"
 #include "../control/messagebox.h"
 
@@ -28,13 +31,23 @@ namespace logger {
 
 static LogSender *   logClient = nullptr;
 static LogReceiver * logServer = nullptr;
+// mwc713 output is logged from the parser thread. Protecting logServer and the file writes
+static QMutex logServerMutex;
 
-static bool logMwc713outBlocked = false;
+static std::atomic<bool> logMwc713outBlocked{false};
+
+static void append2logs(bool addDate, const QString & prefix, const QString & line) {
+    QMutexLocker l( &logServerMutex );
+    if (logServer)
+        logServer->onAppend2logs(addDate, prefix, line);
+}
 
 const QString LOG_FILE_NAME = "mwcwallet.log";
 
 void initLogger( bool logsEnabled) {
     logClient = new LogSender(true);
+    // Direct call from any thread, append2logs is synchronized
+    QObject::connect( logClient, &LogSender::doAppend2logs, &append2logs );
 
     enableLogs(logsEnabled);
 
@@ -52,12 +65,12 @@ void cleanUpLogs() {
 
 // enable/disable logs
 void enableLogs( bool enableLogs ) {
+    QMutexLocker l( &logServerMutex );
     if (enableLogs) {
         if (logServer != nullptr )
             return;
 
         logServer = new LogReceiver(LOG_FILE_NAME);
-        QObject::connect( logClient, &LogSender::doAppend2logs, logServer, &LogReceiver::onAppend2logs, Qt::DirectConnection); // Qt::QueuedConnection );
     }
     else {
         if (logServer == nullptr)
@@ -74,7 +87,7 @@ void LogSender::log(bool addDate, const QString & prefix, const QString & line)
         emit doAppend2logs(addDate, prefix, line);
     }
     else {
-        logServer->onAppend2logs(addDate, prefix, line );
+        append2logs(addDate, prefix, line );
     }
 }
 
@@ -107,6 +120,7 @@ LogReceiver::~LogReceiver() {
 }
 
 void LogReceiver::onAppend2logs(bool addDate, QString prefix, QString line ) {
+    trace::Scope traceScope("log", "write");
     QString logLine;
     if (addDate)
         logLine += QDateTime::currentDateTime().toString("dd.MM.yyyy hh:mm:ss.zzz") + " ";
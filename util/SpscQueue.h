@@ -0,0 +1,109 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_SPSCQUEUE_H
+#define MWC_QT_WALLET_SPSCQUEUE_H
+
+#include <atomic>
+#include <utility>
+
+namespace util {
+
+// Unbounded lock-free queue for a single producer thread and a single consumer thread.
+// Items are delivered in the push order. Nodes are recycled by the producer, so
+// in the steady state the queue doesn't allocate.
+template <class T>
+class SpscQueue {
+public:
+    SpscQueue() {
+        Node * n = new Node();
+        head = first = tailCopy = n;
+        tail.store(n, std::memory_order_relaxed);
+    }
+
+    ~SpscQueue() {
+        Node * n = first;
+        while (n) {
+            Node * next = n->next.load(std::memory_order_relaxed);
+            delete n;
+            n = next;
+        }
+    }
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue & operator=(const SpscQueue &) = delete;
+
+    // Producer thread only
+    void push(T && value) {
+        Node * n = allocNode();
+        n->value = std::move(value);
+        n->next.store(nullptr, std::memory_order_relaxed);
+        head->next.store(n, std::memory_order_release);
+        head = n;
+    }
+
+    void push(const T & value) {
+        T v(value);
+        push( std::move(v) );
+    }
+
+    // Consumer thread only. Return false if queue is empty
+    bool pop(T & value) {
+        Node * t = tail.load(std::memory_order_relaxed);
+        Node * n = t->next.load(std::memory_order_acquire);
+        if (n == nullptr)
+            return false;
+
+        value = std::move(n->value);
+        n->value = T(); // Release the data now, node will be reused later
+        tail.store(n, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only
+    bool isEmpty() const {
+        return tail.load(std::memory_order_relaxed)->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    struct Node {
+        T value;
+        std::atomic<Node *> next{nullptr};
+    };
+
+    // Take the node that consumer already passed or allocate a new one
+    Node * allocNode() {
+        if (first == tailCopy) {
+            tailCopy = tail.load(std::memory_order_acquire);
+            if (first == tailCopy)
+                return new Node();
+        }
+        Node * n = first;
+        first = first->next.load(std::memory_order_relaxed);
+        return n;
+    }
+
+private:
+    // Consumer side
+    std::atomic<Node *> tail; // Last consumed node, data starts from tail->next
+
+    // Producer side
+    Node * head;     // Last pushed node
+    Node * first;    // First node that can be reused
+    Node * tailCopy; // Cached tail value
+};
+
+}
+
+#endif //MWC_QT_WALLET_SPSCQUEUE_H
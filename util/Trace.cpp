@@ -0,0 +1,178 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Trace.h"
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QVector>
+#include <QFile>
+#include <QCoreApplication>
+#include <QDebug>
+
+namespace trace {
+
+std::atomic<bool> traceEnabled{false};
+
+struct TraceEvent {
+    const char * category = nullptr;
+    QString name;
+    char    phase = 'X';
+    int64_t ts = 0;
+    int64_t dur = 0;
+    int64_t id = 0;
+    int     tid = 0;
+    QString args;
+};
+
+// Guarded by traceMutex. Touched only when tracing is enabled
+static QMutex traceMutex;
+static QVector<TraceEvent> ring;
+static int ringNext = 0;
+static int64_t ringTotal = 0;
+static QString traceFileName;
+
+// Small thread numbers are easier to read than native ids
+static int threadId() {
+    static std::atomic<int> lastId{0};
+    thread_local int id = ++lastId;
+    return id;
+}
+
+static void addEvent(TraceEvent && evt) {
+    evt.tid = threadId();
+    QMutexLocker l( &traceMutex );
+    if (ring.isEmpty())
+        return;
+    ring[ringNext] = std::move(evt);
+    ringNext = (ringNext+1) % ring.size();
+    ringTotal++;
+}
+
+int64_t now() {
+    static QElapsedTimer timer = [](){ QElapsedTimer t; t.start(); return t; }();
+    return timer.nsecsElapsed()/1000 + 1;
+}
+
+void enable(const QString & fileName, int capacity) {
+    {
+        QMutexLocker l( &traceMutex );
+        traceFileName = fileName;
+        ring = QVector<TraceEvent>( std::max(1, capacity) );
+        ringNext = 0;
+        ringTotal = 0;
+    }
+    traceEnabled = true;
+    qDebug() << "Tracing is enabled, trace file: " << fileName;
+}
+
+static QString escape(const QString & str) {
+    QString res = str;
+    res.replace("\\", "\\\\").replace("\"", "\\\"").replace("\n", "\\n");
+    return res;
+}
+
+bool flush() {
+    QMutexLocker l( &traceMutex );
+    if (traceFileName.isEmpty())
+        return true;
+
+    QFile file(traceFileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        l.unlock();
+        qDebug() << "Unable to write trace file " << file.fileName() << " Error: " << file.errorString();
+        return false;
+    }
+
+    const int pid = int(QCoreApplication::applicationPid());
+    const int sz = ring.size();
+    const int num = int(std::min( ringTotal, int64_t(sz) ));
+    // Oldest first
+    int pos = ringTotal > sz ? ringNext : 0;
+
+    file.write("{\"traceEvents\":[\n");
+    for (int i=0; i<num; i++, pos = (pos+1) % sz) {
+        const TraceEvent & e = ring[pos];
+        QString line = QString("{\"name\":\"%1\",\"cat\":\"%2\",\"ph\":\"%3\",\"ts\":%4,\"pid\":%5,\"tid\":%6")
+                .arg(escape(e.name)).arg(e.category).arg(QChar(e.phase)).arg(e.ts).arg(pid).arg(e.tid);
+        if (e.phase=='X')
+            line += ",\"dur\":" + QString::number(e.dur);
+        else if (e.phase=='b' || e.phase=='e')
+            line += ",\"id\":" + QString::number(e.id);
+        else if (e.phase=='i')
+            line += ",\"s\":\"t\"";
+        if (!e.args.isEmpty())
+            line += ",\"args\":{" + e.args + "}";
+        line += (i+1<num) ? "},\n" : "}\n";
+        file.write(line.toUtf8());
+    }
+    file.write("],\"displayTimeUnit\":\"ms\"}\n");
+    const int64_t total = ringTotal;
+    l.unlock();
+
+    qDebug() << "Trace is saved into " << file.fileName() << ", events: " << num << " of " << total;
+    return true;
+}
+
+void complete(const char * category, const QString & name, int64_t startUs, int64_t durationUs, const QString & args) {
+    if (!isEnabled())
+        return;
+    TraceEvent evt;
+    evt.category = category;
+    evt.name = name;
+    evt.phase = 'X';
+    evt.ts = startUs;
+    evt.dur = durationUs;
+    evt.args = args;
+    addEvent(std::move(evt));
+}
+
+void instant(const char * category, const QString & name, const QString & args) {
+    if (!isEnabled())
+        return;
+    TraceEvent evt;
+    evt.category = category;
+    evt.name = name;
+    evt.phase = 'i';
+    evt.ts = now();
+    evt.args = args;
+    addEvent(std::move(evt));
+}
+
+void asyncSpan(const char * category, const QString & name, int64_t id, int64_t startUs, int64_t endUs, const QString & args) {
+    if (!isEnabled())
+        return;
+    TraceEvent evt;
+    evt.category = category;
+    evt.name = name;
+    evt.phase = 'b';
+    evt.ts = startUs;
+    evt.id = id;
+    evt.args = args;
+    addEvent(TraceEvent(evt));
+
+    evt.phase = 'e';
+    evt.ts = endUs;
+    evt.args = "";
+    addEvent(std::move(evt));
+}
+
+QString arg(const QString & key, const QString & value) {
+    return "\"" + escape(key) + "\":\"" + escape(value) + "\"";
+}
+
+QString arg(const QString & key, int64_t value) {
+    return "\"" + escape(key) + "\":" + QString::number(value);
+}
+
+}
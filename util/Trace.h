@@ -0,0 +1,80 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_TRACE_H
+#define MWC_QT_WALLET_TRACE_H
+
+#include <QString>
+#include <atomic>
+
+// Chrome trace_event collector. Events are stored in a ring buffer and written as JSON at flush.
+// Result can be opened with Perfetto or chrome://tracing
+// When tracing is disabled, every call costs a single relaxed atomic load.
+// Define MWC_NO_TRACE to remove it at compile time.
+namespace trace {
+
+    extern std::atomic<bool> traceEnabled;
+
+    inline bool isEnabled() {
+#ifdef MWC_NO_TRACE
+        return false;
+#else
+        return traceEnabled.load(std::memory_order_relaxed);
+#endif
+    }
+
+    // Monotonic time in microseconds. Never 0
+    int64_t now();
+
+    // Start collecting. capacity - ring buffer size in events, older events are overwritten
+    void enable(const QString & fileName, int capacity = 500000);
+
+    // Write collected events into the file. Return false in case of IO error
+    bool flush();
+
+    // 'X' event, duration on the current thread
+    void complete(const char * category, const QString & name, int64_t startUs, int64_t durationUs, const QString & args = "");
+    // 'i' event
+    void instant(const char * category, const QString & name, const QString & args = "");
+    // 'b'/'e' async event pair, can cross threads and overlap. id must be unique for the category
+    void asyncSpan(const char * category, const QString & name, int64_t id, int64_t startUs, int64_t endUs, const QString & args = "");
+
+    // args for the events: "key":value pairs, JSON object without braces
+    QString arg(const QString & key, const QString & value);
+    QString arg(const QString & key, int64_t value);
+
+    // Complete event for the scope
+    class Scope {
+    public:
+        Scope(const char * _category, const char * _name) : category(_category), name(_name), start(isEnabled() ? now() : 0) {}
+        Scope(const char * _category, const QString & _name) : category(_category), qname(_name), start(isEnabled() ? now() : 0) {}
+        ~Scope() {
+            if (start>0)
+                complete(category, name ? QString(name) : qname, start, now()-start, args);
+        }
+        Scope(const Scope &) = delete;
+        Scope & operator=(const Scope &) = delete;
+
+        bool isActive() const {return start>0;}
+        void setArgs(const QString & _args) {args = _args;}
+    private:
+        const char * category;
+        const char * name = nullptr;
+        QString qname;
+        int64_t start;
+        QString args;
+    };
+}
+
+#endif //MWC_QT_WALLET_TRACE_H
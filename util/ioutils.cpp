@@ -16,6 +16,20 @@
 #include <QStandardPaths>
 #include "../core/mwcexception.h"
 #include <QDir>
+#include <QIODevice>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MWC_IOUTILS_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <immintrin.h>
+#define MWC_IOUTILS_AVX2_TARGET
+#else
+#include <immintrin.h>
+#define MWC_IOUTILS_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
 
 namespace ioutils {
 
@@ -53,21 +67,319 @@ QString getAppDataPath(QString localPath )
 
 QByteArray FilterEscSymbols( const QByteArray & data ) {
     QByteArray res;
+    res.resize(data.size());
+    char * out = res.data();
+    int outPos = 0;
+
+    const char * d = data.constData();
+    const int size = data.size();
+    int pos = 0;
+    while (pos<size) {
+        // Copy everything until the escape
+        int esc = pos + findAnyOf( d+pos, size-pos, 27, 27, 27 );
+        memcpy( out+outPos, d+pos, size_t(esc-pos) );
+        outPos += esc-pos;
+        // Escape continue until 'm'
+        pos = esc + findAnyOf( d+esc, size-esc, 'm', 'm', 'm' ) + 1;
+    }
+
+    res.resize(outPos);
+    return res;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Scanning kernels
+
+static int findAnyOfScalar( const char * data, int size, char a, char b, char c ) {
+    for ( int i=0; i<size; i++ ) {
+        const char ch = data[i];
+        if ( ch==a || ch==b || ch==c )
+            return i;
+    }
+    return size;
+}
+
+#ifdef MWC_IOUTILS_X86
+
+static inline int firstBit( uint mask ) {
+#ifdef _MSC_VER
+    unsigned long idx;
+    _BitScanForward(&idx, mask);
+    return int(idx);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+static int findAnyOfSse2( const char * data, int size, char a, char b, char c ) {
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    const __m128i vc = _mm_set1_epi8(c);
+
+    int pos = 0;
+    for ( ; pos+16<=size; pos+=16 ) {
+        const __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i *>(data+pos) );
+        const __m128i eq = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb) ), _mm_cmpeq_epi8(v, vc) );
+        const uint mask = uint( _mm_movemask_epi8(eq) );
+        if (mask)
+            return pos + firstBit(mask);
+    }
+    return pos + findAnyOfScalar( data+pos, size-pos, a, b, c );
+}
+
+MWC_IOUTILS_AVX2_TARGET
+static int findAnyOfAvx2( const char * data, int size, char a, char b, char c ) {
+    const __m256i va = _mm256_set1_epi8(a);
+    const __m256i vb = _mm256_set1_epi8(b);
+    const __m256i vc = _mm256_set1_epi8(c);
+
+    int pos = 0;
+    for ( ; pos+32<=size; pos+=32 ) {
+        const __m256i v = _mm256_loadu_si256( reinterpret_cast<const __m256i *>(data+pos) );
+        const __m256i eq = _mm256_or_si256( _mm256_or_si256( _mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb) ), _mm256_cmpeq_epi8(v, vc) );
+        const uint mask = uint( _mm256_movemask_epi8(eq) );
+        if (mask)
+            return pos + firstBit(mask);
+    }
+    return pos + findAnyOfSse2( data+pos, size-pos, a, b, c );
+}
+
+static SIMD_LEVEL detectSimdLevel() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] >= 7) {
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1<<27)) != 0;
+        const bool avx = (info[2] & (1<<28)) != 0;
+        __cpuidex(info, 7, 0);
+        const bool avx2 = (info[1] & (1<<5)) != 0;
+        // OS must save AVX registers
+        if ( osxsave && avx && avx2 && (_xgetbv(0) & 6) == 6 )
+            return SIMD_LEVEL::AVX2;
+    }
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return SIMD_LEVEL::AVX2;
+#endif
+    return SIMD_LEVEL::SSE2; // x86_64 always has SSE2
+}
+
+#else
+
+static SIMD_LEVEL detectSimdLevel() {
+    return SIMD_LEVEL::SCALAR;
+}
+
+#endif
+
+typedef int (*FindAnyOfFunc)( const char * data, int size, char a, char b, char c );
+
+// Implementation for the level. Level is updated if it is not supported
+static FindAnyOfFunc selectFindAnyOf(SIMD_LEVEL & level) {
+    switch (level) {
+#ifdef MWC_IOUTILS_X86
+    case SIMD_LEVEL::AVX2:
+        return findAnyOfAvx2;
+    case SIMD_LEVEL::SSE2:
+        return findAnyOfSse2;
+#endif
+    default:
+        level = SIMD_LEVEL::SCALAR;
+        return findAnyOfScalar;
+    }
+}
+
+// Active implementation. Parser and GUI threads call findAnyOf concurrently, so the state is atomic
+// and initialized on the first use in a thread safe way.
+struct SimdDispatch {
+    SIMD_LEVEL supported;
+    std::atomic<SIMD_LEVEL> level;
+    std::atomic<FindAnyOfFunc> findAnyOf;
+
+    SimdDispatch() : supported(detectSimdLevel()) {
+        SIMD_LEVEL lvl = supported;
+        findAnyOf.store( selectFindAnyOf(lvl), std::memory_order_relaxed );
+        level.store( lvl, std::memory_order_relaxed );
+    }
+};
+
+static SimdDispatch & simdDispatch() {
+    static SimdDispatch dispatch;
+    return dispatch;
+}
+
+SIMD_LEVEL getSimdLevel() {
+    return simdDispatch().level.load(std::memory_order_relaxed);
+}
+
+SIMD_LEVEL setSimdLevel(SIMD_LEVEL level) {
+    SimdDispatch & dispatch = simdDispatch();
+    if ( int(level) > int(dispatch.supported) )
+        level = dispatch.supported;
 
-    bool inEsc = false;
-    for (char d : data) {
-        if (d==27)
+    FindAnyOfFunc func = selectFindAnyOf(level);
+    dispatch.findAnyOf.store( func, std::memory_order_relaxed );
+    dispatch.level.store( level, std::memory_order_relaxed );
+    return level;
+}
+
+int findAnyOf( const char * data, int size, char a, char b, char c ) {
+    return simdDispatch().findAnyOf.load(std::memory_order_relaxed)( data, size, a, b, c );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// OutputReader
+
+OutputReader::OutputReader( const QByteArray & _linePrefix ) :
+    linePrefix(_linePrefix)
+{
+    reset();
+}
+
+void OutputReader::reset() {
+    readySize = 0;
+    tailSize = 0;
+    inEsc = false;
+    lineEmpty = true;
+    prefixPos = linePrefix.isEmpty() ? -1 : 0;
+    skipSpaces = false;
+}
+
+int OutputReader::read( QIODevice * device ) {
+    Q_ASSERT(device);
+    qint64 available = device->bytesAvailable();
+    if (available<=0) {
+        filter(nullptr, 0);
+        return readySize;
+    }
+
+    if (input.size() < available)
+        input.resize( int(available) );
+
+    qint64 sz = device->read( input.data(), available );
+    filter( input.constData(), int(std::max(sz, qint64(0))) );
+    return readySize;
+}
+
+int OutputReader::process( const char * data, int size ) {
+    filter(data, size);
+    return readySize;
+}
+
+void OutputReader::filter( const char * data, int size ) {
+    // incomplete char from the previous call is located at [readySize, readySize+tailSize)
+    if (tailSize>0 && readySize>0)
+        memmove( output.data(), output.constData() + readySize, size_t(tailSize) );
+
+    // Output can't be longer than input plus held prefix and tail
+    const int maxSize = tailSize + size + linePrefix.size() + 1;
+    if (output.size() < maxSize)
+        output.resize( maxSize );
+
+    char * out = output.data();
+    int outPos = tailSize;
+
+    lineEnds.resize(0);
+
+    for ( int i=0; i<size; i++ ) {
+        if (inEsc) {
+            // Skipping escape until 'm'
+            i += findAnyOf( data+i, size-i, 'm', 'm', 'm' );
+            if (i<size)
+                inEsc = false;
+            continue;
+        }
+
+        if ( prefixPos<0 && !skipSpaces ) {
+            // Middle of the line, copy everything until the next escape or new line
+            int len = findAnyOf( data+i, size-i, 27, '\r', '\n' );
+            if (len>0) {
+                memcpy( out+outPos, data+i, size_t(len) );
+                outPos += len;
+                lineEmpty = false;
+                i += len;
+                if (i>=size)
+                    break;
+            }
+        }
+
+        const char ch = data[i];
+
+        if (ch==27) {
             inEsc = true;
+            continue;
+        }
 
-        if (!inEsc)
-            res.append( d );
+        if ( ch=='\r' || ch=='\n' ) {
+            if (prefixPos>0) { // Line is a beginning of the prefix, it is data
+                memcpy( out+outPos, linePrefix.constData(), size_t(prefixPos) );
+                outPos += prefixPos;
+                lineEmpty = false;
+            }
+            if (!lineEmpty) {
+                lineEnds.push_back(outPos);
+                out[outPos++] = '\n';
+            }
 
-        if (d=='m')
-            inEsc=false;
+            lineEmpty = true;
+            prefixPos = linePrefix.isEmpty() ? -1 : 0;
+            skipSpaces = false;
+            continue;
+        }
+
+        if (skipSpaces) {
+            if (ch==' ' || ch=='\t')
+                continue;
+            skipSpaces = false;
+        }
+
+        if (prefixPos>=0) {
+            if (ch == linePrefix[prefixPos]) {
+                if (++prefixPos == linePrefix.size()) {
+                    prefixPos = -1;
+                    skipSpaces = true;
+                }
+                continue;
+            }
+            // Not a prefix, matched part is a data
+            memcpy( out+outPos, linePrefix.constData(), size_t(prefixPos) );
+            outPos += prefixPos;
+            prefixPos = -1;
+        }
+
+        out[outPos++] = ch;
+        lineEmpty = false;
     }
 
-    return res;
+    readySize = outPos;
+    tailSize = 0;
+    holdIncompleteTail();
 }
 
+void OutputReader::holdIncompleteTail() {
+    // Looking for the lead byte of the last char
+    const uchar * data = reinterpret_cast<const uchar *>(output.constData());
+    int lead = readySize-1;
+    while ( lead>=0 && readySize-lead<4 && (data[lead] & 0xC0) == 0x80 )
+        lead--;
+
+    if (lead<0)
+        return;
+
+    int len = 1;
+    if ( (data[lead] & 0xE0) == 0xC0 )
+        len = 2;
+    else if ( (data[lead] & 0xF0) == 0xE0 )
+        len = 3;
+    else if ( (data[lead] & 0xF8) == 0xF0 )
+        len = 4;
+
+    if ( lead + len > readySize ) {
+        tailSize = readySize - lead;
+        readySize = lead;
+    }
+}
 
 }
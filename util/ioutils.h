@@ -16,6 +16,10 @@
 #define IOUTILS_H
 
 #include <QString>
+#include <QByteArray>
+#include <QVector>
+
+class QIODevice;
 
 namespace ioutils {
 
@@ -25,6 +29,75 @@ QString getAppDataPath(QString localPath = "");
 
 QByteArray FilterEscSymbols( const QByteArray & data );
 
+// Byte scanning kernels for the process output. Implementation is selected at runtime
+// from the best one that CPU supports.
+enum class SIMD_LEVEL { SCALAR = 0, SSE2 = 1, AVX2 = 2 };
+
+SIMD_LEVEL getSimdLevel();
+// Force the implementation, for tests and benchmarks. Level is limited by CPU support.
+// Return the level that was set.
+SIMD_LEVEL setSimdLevel(SIMD_LEVEL level);
+
+// Position of the first byte that equal to a, b or c. Return size if nothing was found
+int findAnyOf( const char * data, int size, char a, char b, char c );
+
+// Streaming reader for the process output (mwc713, mwc-node).
+// Read data from the device into the reusable buffers, strip ANSI escapes, normalize new lines
+// to '\n' and skip empty lines. Result is available as a UTF-8 view, so the data can be parsed
+// without intermediate QString/QStringList. In the steady state it doesn't allocate.
+//
+// Result doesn't depend on how the stream is split into chunks. Because of that it differs from
+// the old per read() QString filtering in mwc713readyReadStandardOutput:
+//  - empty lines are skipped everywhere, also when they span the chunks, and at the stream start.
+//    The stream never starts with '\n'.
+//  - only spaces after the prompt are removed, the rest of the prompt line is not trimmed.
+class OutputReader {
+public:
+    // linePrefix - prompt that will be removed from the line start together with following spaces.
+    //              Example: 'wallet713>'. Empty - nothing to remove.
+    OutputReader( const QByteArray & linePrefix = QByteArray() );
+
+    OutputReader(const OutputReader & other) = delete;
+    OutputReader & operator=(const OutputReader & other) = delete;
+
+    // Read all available data from the device and filter it.
+    // Return ready data size, data is available with getData(). Data is valid until the next call
+    int read( QIODevice * device );
+    // The same for the data that was already read
+    int process( const char * data, int size );
+
+    // Filtered data. Lines are separated by '\n'. Last line might be not finished, it is not
+    // held, so the prompts are delivered without waiting for the new line.
+    // Data always ends at complete UTF-8 char.
+    const char * getData() const {return output.constData();}
+    int getSize() const {return readySize;}
+    // Positions of '\n' at getData(), sorted
+    const QVector<int> & getLineEnds() const {return lineEnds;}
+
+    // Reset the stream state, keep the buffers
+    void reset();
+
+private:
+    // Filter input[0..size) into output after tailSize bytes
+    void filter( const char * data, int size );
+    // Keep incomplete UTF-8 char at the end of output for the next call
+    void holdIncompleteTail();
+
+private:
+    const QByteArray linePrefix;
+    QByteArray input;  // Raw data from the device, reused
+    QByteArray output; // Filtered data, reused
+    int  readySize = 0; // Size of filtered data at output that is ready to process
+    int  tailSize = 0;  // Incomplete UTF-8 bytes at the output end, will be prepended to the next result
+    QVector<int> lineEnds; // reused
+
+    // Stream state between the chunks
+    bool inEsc = false;     // Inside ANSI escape sequence
+    bool lineEmpty = true;  // Nothing was written into the current line
+    int  prefixPos = 0;     // Matched linePrefix bytes at the line start. -1 if line doesn't start with prefix
+    bool skipSpaces = false; // Skipping spaces after linePrefix
+};
+
 }
 
 #endif // IOUTILS_H
@@ -15,6 +15,10 @@
 #include "../core/global.h"
 #include "stringutils.h"
 #include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <cstdio>
 
 namespace util {
 
@@ -93,6 +97,10 @@ QString zeroDbl2Dbl(QString  dbl) {
 
 // convert string representing double into nano
 QPair<bool,int64_t> one2nano(QString str) {
+    return one2nano( QStringRef(&str) );
+}
+
+QPair<bool,int64_t> one2nano(const QStringRef & str) {
     if (str.length()==0)
         return QPair<bool,int64_t>(false, 0);
 
@@ -206,6 +214,15 @@ QString getSubString(const QString & str, int idx1, int idx2) {
     return str.mid(idx1, idx2-idx1).trimmed();
 }
 
+QStringRef getSubStringRef(const QString & str, int idx1, int idx2) {
+    idx2 = std::min(idx2, str.length());
+
+    if (idx2<=idx1 || idx1>=str.length())
+        return QStringRef();
+
+    return str.midRef(idx1, idx2-idx1).trimmed();
+}
+
 static int calcOffsetFromUTC() {
      return QDateTime::currentDateTime().offsetFromUtc();
 }
@@ -215,12 +232,95 @@ QString mwc713time2ThisTime(QString mwc713TimeStr) {
     if (mwc713TimeStr.isEmpty())
         return mwc713TimeStr;
 
+    return ms2ThisTime( mwc713time2ms( QStringRef(&mwc713TimeStr) ) );
+}
+
+// Days from 1970-01-01 for the civil date. Works for any Gregorian date.
+static int64_t daysFromCivil(int64_t y, int m, int d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y-399) / 400;
+    const int64_t yoe = y - era * 400;
+    const int64_t doy = (153*(m + (m > 2 ? -3 : 9)) + 2)/5 + d-1;
+    const int64_t doe = yoe * 365 + yoe/4 - yoe/100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// Inverse of daysFromCivil
+static void civilFromDays(int64_t z, int & y, int & m, int & d) {
+    z += 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const int64_t doe = z - era * 146097;
+    const int64_t yoe = (doe - doe/1460 + doe/36524 - doe/146096) / 365;
+    const int64_t doy = doe - (365*yoe + yoe/4 - yoe/100);
+    const int64_t mp = (5*doy + 2)/153;
+    d = int(doy - (153*mp+2)/5 + 1);
+    m = int(mp < 10 ? mp+3 : mp-9);
+    y = int(yoe + era * 400 + (m <= 2));
+}
+
+int64_t mwc713time2ms(const QStringRef & str) {
+    // yyyy-MM-dd hh:mm:ss
+    // 0123456789012345678
+    const int LEN = 19;
+    QStringRef s = str.trimmed();
+    if (s.length() < LEN)
+        return 0;
+
+    const QChar * p = s.unicode();
+    int num[6] = {0,0,0,0,0,0};
+    const int start[6] = {0,5,8,11,14,17};
+    const int len[6]   = {4,2,2,2,2,2};
+    for (int k=0; k<6; k++) {
+        for (int i=start[k]; i<start[k]+len[k]; i++) {
+            ushort c = p[i].unicode();
+            if (c<'0' || c>'9')
+                return 0;
+            num[k] = num[k]*10 + (c-'0');
+        }
+    }
+    if ( p[4]!='-' || p[7]!='-' || p[10]!=' ' || p[13]!=':' || p[16]!=':' )
+        return 0;
+    if ( num[1]<1 || num[1]>12 || num[2]<1 || num[2]>31 || num[3]>23 || num[4]>59 || num[5]>59 )
+        return 0;
+
+    int64_t secs = daysFromCivil(num[0], num[1], num[2]) * 86400 + num[3]*3600 + num[4]*60 + num[5];
+    return secs * 1000;
+}
+
+QString ms2ThisTime(int64_t ms) {
+    if (ms==0)
+        return "";
+
     static int offsetFromUTC = calcOffsetFromUTC();
 
-    QDateTime time = QDateTime::fromString(mwc713TimeStr, mwc::DATETIME_TEMPLATE_MWC713 );
-    time = time.addSecs(offsetFromUTC);
+    // Histories have many rows with the same time, and views render the same rows again and again
+    static QMutex cacheLock;
+    static QHash<int64_t, QString> cache;
+
+    int64_t secs = ms / 1000 + offsetFromUTC;
+
+    QMutexLocker l(&cacheLock);
+    auto it = cache.find(secs);
+    if (it != cache.end())
+        return it.value();
+
+    int64_t days = secs / 86400;
+    int64_t daySecs = secs % 86400;
+    if (daySecs<0) {
+        daySecs += 86400;
+        days--;
+    }
+    int y=0, m=0, d=0;
+    civilFromDays(days, y, m, d);
+
+    // hh:mm:ss dd-MM-yyyy
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%02d:%02d:%02d %02d-%02d-%04d", int(daySecs/3600), int(daySecs/60%60), int(daySecs%60), d, m, y );
+    QString res = QString::fromLatin1(buf);
 
-    QString res = time.toString( mwc::DATETIME_TEMPLATE_THIS);
+    if (cache.size() > 10000)
+        cache.clear();
+    cache.insert(secs, res);
     return res;
 }
 
@@ -16,6 +16,7 @@
 #define STRINGUTILS_H
 
 #include <QVector>
+#include <QString>
 
 namespace util {
 
@@ -32,6 +33,7 @@ QString zeroDbl2Dbl(QString  dbl);
 
 // convert string representing double into nano
 QPair<bool,int64_t> one2nano(QString str);
+QPair<bool,int64_t> one2nano(const QStringRef & str);
 
 // convert int64_t strign into shorter version
 // abcdefgh  => abc...
@@ -54,10 +56,20 @@ QString formatErrorMessages(QStringList messages);
 
 // Get safely substring from the string. If indexes out of range, return emoty string
 QString getSubString(const QString & str, int idx1, int idx2);
+// The same as getSubString, but without data copy. Result is valid while str is alive.
+QStringRef getSubStringRef(const QString & str, int idx1, int idx2);
 
 // Convert mwc713 UTC time to this wallet time. Time template is different.
 QString mwc713time2ThisTime(QString mwc713TimeStr);
 
+// Parse mwc713 UTC time 'yyyy-MM-dd hh:mm:ss' into epoch msec. Fixed layout, no QDateTime.
+// Return 0 if the string is empty or doesn't match the layout.
+int64_t mwc713time2ms(const QStringRef & mwc713TimeStr);
+
+// Epoch msec to this wallet local time string ('hh:mm:ss dd-MM-yyyy'). 0 is an empty string.
+// Recent results are cached, rows with the same time share the string.
+QString ms2ThisTime(int64_t ms);
+
 // Validate string for acceptable symbols. mwc713 understand low ASCII synblos only. Need to verify that.
 QPair <bool, QString> validateMwc713Str(QString str, bool secureStr = false);
 
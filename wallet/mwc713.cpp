@@ -17,7 +17,8 @@
 #include <QDebug>
 #include <QDir>
 #include <QThread>
-#include "../tries/mwc713inputparser.h"
+#include <QTimer>
+#include "mwc713parserthread.h"
 #include "mwc713events.h"
 #include <QApplication>
 #include <core/Notification.h>
@@ -39,6 +40,7 @@
 #include "../util/Files.h"
 #include "../util/Waiting.h"
 #include "../util/Process.h"
+#include "../util/Trace.h"
 #include "../node/MwcNodeConfig.h"
 #include "../node/MwcNode.h"
 
@@ -54,44 +56,114 @@ MWC713::MWC713(QString _mwc713path, QString _mwc713configPath, core::AppContext
         appContext(_appContext), mwc713Path(_mwc713path),  mwc713configPath(_mwc713configPath) {
 
     currentAccount = appContext->getCurrentAccountName();
+    appContext->loadTaskLatencyStats(taskLatency);
 }
 
 MWC713::~MWC713() {
     processStop(startedMode != STARTED_MODE::INIT);
+    dropSpareMwc713process();
+    waitForStoppingProcesses();
+
+    if (probeProcess) {
+        launchQueue.removeOne(probeProcess);
+        probeProcess->kill();
+        delete probeProcess;
+        probeProcess = nullptr;
+    }
+
+    delete queryThread;
+    queryThread = nullptr;
 }
 
 
-// Check if waaled need to be initialized or not. Will run statndalone app, wait for exit and return the result
-// Check signal: onWalletState(bool initialized)
-bool MWC713::checkWalletInitialized() {
+// Check if waaled need to be initialized or not. Will run statndalone app 'mwc713 state', result come when it exit
+// Check signal: onWalletInitialized(bool initialized)
+void MWC713::checkWalletInitialized() {
+
+    if (probeProcess) {
+        qDebug() << "checkWalletState is already running, waiting for it";
+        return;
+    }
 
     qDebug() << "checkWalletState with " << mwc713Path << " and " << mwc713configPath;
 
+    // Warm process will be started again after the check
+    dropSpareMwc713process();
+
     QProcess * process = initMwc713process( {}, {"state"}, false );
+    probeProcess = process;
+
+    connect( process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished), this,
+             [this](int exitCode, QProcess::ExitStatus exitStatus) {
+                 Q_UNUSED(exitCode);
+                 onProbeFinished(exitStatus == QProcess::NormalExit);
+             } );
+    connect( process, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+                 // Crash will be reported by finished
+                 if (error == QProcess::FailedToStart)
+                     onProbeFinished(false);
+             } );
+
+    armProbeTimeout(process);
+    launchMwc713process(process);
+}
+
+// mwc713 expected to exit quickly. If it is not, the user decide how long to wait
+void MWC713::armProbeTimeout(QProcess * process) {
+    QTimer::singleShot( (int)(20000 * config::getTimeoutMultiplier()), process, [this, process]() {
+        if (probeProcess != process || process->state() == QProcess::NotRunning)
+            return;
+
+        if (control::MessageBox::questionText(nullptr, "Warning", "Checking the wallet state with mwc713 is taking longer than expected.\nContinue to wait?",
+                                          "Yes", "No", true, false) == control::MessageBox::RETURN_CODE::BTN1) {
+            config::increaseTimeoutMultiplier();
+            armProbeTimeout(process);
+            return;
+        }
+        onProbeFinished(false);
+    } );
+}
+
+void MWC713::onProbeFinished(bool ok) {
+    if (probeProcess==nullptr)
+        return; // failure already reported
 
-    if (process==nullptr)
-        return false; // error expected to be reported by initMwc713process
+    QProcess * process = probeProcess;
+    probeProcess = nullptr;
+    launchQueue.removeOne(process);
 
-    if (!util::processWaitForFinished( process, 20000, "mwc713")) {
+    QString output;
+    if (ok)
+        output = process->readAll();
+    else
+        process->kill();
+
+    process->deleteLater();
+
+    if (!ok) {
         appendNotificationMessage( notify::MESSAGE_LEVEL::FATAL_ERROR, "mwc713 failed to invalidate the status.\nPath: " + mwc713Path + "\nConfig:" + mwc713configPath );
-        return false;
     }
 
-    QString output = process->readAll();
-
-    delete process;
+    bool uninit = !ok || output.contains("Uninitialized");
 
-    bool uninit = output.contains("Uninitialized");
+    if (ok)
+        logger::logInfo("MWC713", QString("Wallet initialization checking status: ") + (uninit ? "Uninitialized" : "Initialized") );
 
-    logger::logInfo("MWC713", QString("Wallet initialization checking status: ") + (uninit ? "Uninitialized" : "Initialized") );
+    // Wallet might wait for the probe to finish
+    launchPendingMwc713process();
+    // Password will be asked, it is a time to get mwc713 ready
+    if (!uninit)
+        launchSpareMwc713process();
 
-    return !uninit;
+    logger::logEmit("MWC713", "onWalletInitialized", QString::number(!uninit) );
+    emit onWalletInitialized(!uninit);
 }
 
 // pass - provide password through env variable. If pass empty - nothing will be done
 // paramsPlus - additional parameters for the process
+// Process is not started, caller suppose to call launchMwc713process
 QProcess * MWC713::initMwc713process(  const QStringList & envVariables, const QStringList & paramsPlus, bool trackProcessExit ) {
-    // Creating process and starting
+    // Creating process
     QProcess * process = new QProcess();
     process->setProcessChannelMode(QProcess::MergedChannels);
     process->setWorkingDirectory( QDir::homePath() );
@@ -110,50 +182,178 @@ QProcess * MWC713::initMwc713process(  const QStringList & envVariables, const Q
     QStringList params{"--config", mwc713configPath, "--disable-history" ,"-r", mwc::PROMPTS_MWC713 };
     params.append( paramsPlus );
 
-    walletStartTime = QDateTime::currentMSecsSinceEpoch();
-    commandLine = "'" + QFileInfo(mwc713Path).canonicalFilePath() + "'";
-    for (auto & p : params) {
+    process->setProgram(mwc713Path);
+    process->setArguments(params);
+
+    if (trackProcessExit)
+        mwc713connect(process, true);
+
+    return process;
+}
+
+// Attaching to the warm spare if it fit, otherwise the new process
+QProcess * MWC713::startMwc713process( const QStringList & envVariables, const QStringList & paramsPlus ) {
+    if (spareProcess) {
+        if ( envVariables.isEmpty() && paramsPlus.isEmpty() && spareProcess->state() != QProcess::NotRunning )
+            return attachSpareMwc713process();
+
+        // Spare is started with different parameters
+        dropSpareMwc713process();
+    }
+
+    QProcess * process = initMwc713process( envVariables, paramsPlus );
+    launchMwc713process(process);
+    return process;
+}
+
+void MWC713::launchMwc713process(QProcess * process) {
+    Q_ASSERT(process);
+    Q_ASSERT(!launchQueue.contains(process));
+    launchQueue.push_back(process);
+
+    if ( isMwc713busy() )
+        logger::logInfo("MWC713", "New mwc713 process is waiting for previous one to exit");
+
+    launchPendingMwc713process();
+}
+
+// Previous mwc713 still holds the wallet data
+bool MWC713::isMwc713busy() const {
+    if (!stoppingProcesses.isEmpty())
+        return true;
+    if (probeProcess!=nullptr && probeProcess->state() != QProcess::NotRunning)
+        return true;
+    return false;
+}
+
+void MWC713::launchPendingMwc713process() {
+    // Probe is exiting by itself, others will wait for it. That is why checking after every launch
+    while ( !launchQueue.isEmpty() && !isMwc713busy() ) {
+        QProcess * process = launchQueue.takeFirst();
+
+        commandLine = mwc713commandLine(process);
+        walletStartTime = QDateTime::currentMSecsSinceEpoch();
+        mwc713launchUs = trace::now();
+        logger::logInfo("MWC713", "Starting new process: " + commandLine);
+
+        process->start( QProcess::Unbuffered | QProcess::ReadWrite );
+        armStartTimeout(process);
+    }
+}
+
+QString MWC713::mwc713commandLine(const QProcess * process) const {
+    QString res = "'" + QFileInfo(process->program()).canonicalFilePath() + "'";
+    for (auto & p : process->arguments()) {
         if (p=="-r" ||  p==mwc::PROMPTS_MWC713 )
             continue; // skipping prompt parameter. It is not needed for troubleshouting
-        commandLine += " '" + p + "'";
-    }
-
-    logger::logInfo("MWC713", "Starting new process: " + commandLine);
-
-    process->start(mwc713Path, params, QProcess::Unbuffered | QProcess::ReadWrite );
-
-    while ( ! process->waitForStarted( (int)(10000 * config::getTimeoutMultiplier()) ) ) {
-
-        logger::logInfo("MWC713", "mwc713 process failed to start");
-
-        switch (process->error())
-        {
-            case QProcess::FailedToStart:
-                appendNotificationMessage( notify::MESSAGE_LEVEL::FATAL_ERROR, "mwc713 failed to start mwc713 located at " + mwc713Path + "\n\nCommand line:\n\n" + commandLine );
-                return nullptr;
-            case QProcess::Crashed:
-                appendNotificationMessage( notify::MESSAGE_LEVEL::FATAL_ERROR, "mwc713 crashed during start\n\nCommand line:\n\n" + commandLine );
-                return nullptr;
-            case QProcess::Timedout:
-                if (control::MessageBox::questionText(nullptr, "Warning", QString("Starting for mwc713 process is taking longer than expected.\nContinue to wait?") +
-                                                  "\n\nCommand line:\n\n" + commandLine,
-                                                  "Yes", "No", true, false) == control::MessageBox::RETURN_CODE::BTN1) {
-                    config::increaseTimeoutMultiplier();
-                    continue; // retry with waiting
-                }
-                appendNotificationMessage( notify::MESSAGE_LEVEL::FATAL_ERROR, "mwc713 takes too much time to start. Something wrong with environment.\n\nCommand line:\n\n" + commandLine );
-                return nullptr;
-            default:
-                appendNotificationMessage( notify::MESSAGE_LEVEL::FATAL_ERROR, "mwc713 failed to start because of unknown error.\n\nCommand line:\n\n" + commandLine );
-                return nullptr;
-        }
+        res += " '" + p + "'";
     }
+    return res;
+}
 
-    mwc713connect(process, trackProcessExit);
+// Spare is started while nothing else is running. It does the welcome and waits for the password prompt,
+// so the next start, getnextkey or receive slate can skip that
+void MWC713::launchSpareMwc713process() {
+    if ( spareProcess!=nullptr || mwc713process!=nullptr || probeProcess!=nullptr || !stoppingProcesses.isEmpty() || !launchQueue.isEmpty() )
+        return;
+
+    QProcess * process = initMwc713process( {}, {}, false );
+    spareProcess = process;
+    spareLaunchUs = trace::now();
+    spareReadyUs = 0;
+
+    connect( process, &QProcess::readyReadStandardOutput, this, [this, process]() {
+                 if (spareProcess==process && spareReadyUs==0)
+                     spareReadyUs = trace::now();
+             } );
+    connect( process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished), this,
+             [this, process](int exitCode, QProcess::ExitStatus exitStatus) {
+                 Q_UNUSED(exitStatus);
+                 logger::logInfo("MWC713", "Warm mwc713 process exited with exit code " + QString::number(exitCode) );
+                 if (spareProcess==process)
+                     spareProcess = nullptr;
+                 process->deleteLater();
+             } );
+    connect( process, &QProcess::errorOccurred, this, [this, process](QProcess::ProcessError error) {
+                 // Crash will be handled by finished. Real start will report the problem if it still exist
+                 if (error == QProcess::FailedToStart && spareProcess==process) {
+                     logger::logInfo("MWC713", "Warm mwc713 process failed to start");
+                     spareProcess = nullptr;
+                     process->deleteLater();
+                 }
+             } );
+
+    logger::logInfo("MWC713", "Starting warm mwc713 process: " + mwc713commandLine(process));
+    process->start( QProcess::Unbuffered | QProcess::ReadWrite );
+}
+
+QProcess * MWC713::attachSpareMwc713process() {
+    Q_ASSERT(spareProcess);
+    QProcess * process = spareProcess;
+    spareProcess = nullptr;
+    process->disconnect(this);
+
+    const int64_t nowUs = trace::now();
+    // Startup that we don't need to wait for
+    const int64_t savedUs = (spareReadyUs>0 ? spareReadyUs : nowUs) - spareLaunchUs;
+
+    commandLine = mwc713commandLine(process);
+    walletStartTime = QDateTime::currentMSecsSinceEpoch() - (nowUs - spareLaunchUs)/1000;
+    mwc713launchUs = spareLaunchUs;
+
+    logger::logInfo("MWC713", "Attaching to the warm mwc713 process, startup time saved: " + QString::number(savedUs/1000) + " ms" );
+    if (trace::isEnabled()) {
+        trace::asyncSpan("mwc713", "warm mwc713 startup", spareLaunchUs+1, spareLaunchUs, spareLaunchUs + savedUs );
+        trace::instant("mwc713", "attach warm mwc713", trace::arg("savedMs", savedUs/1000) );
+    }
 
+    mwc713connect(process, true);
+
+    // Welcome and prompt are waiting in the process buffer. Parser is not created yet, so reading later
+    QMetaObject::invokeMethod(this, "mwc713readyReadStandardOutput", Qt::QueuedConnection);
     return process;
 }
 
+void MWC713::dropSpareMwc713process() {
+    if (spareProcess==nullptr)
+        return;
+
+    QProcess * process = spareProcess;
+    spareProcess = nullptr;
+    process->disconnect(this);
+
+    logger::logInfo("MWC713", "Stopping warm mwc713 process");
+    // It is locked, nothing to save. Next process will be launched when it is dead
+    stopMwc713processAsync(process, false);
+}
+
+void MWC713::armStartTimeout(QProcess * process) {
+    // Failures are reported with errorOccurred, here we are handling the slow start only
+    QTimer::singleShot( (int)(10000 * config::getTimeoutMultiplier()), process, [this, process]() {
+        if (process->state() != QProcess::Starting)
+            return;
+
+        logger::logInfo("MWC713", "mwc713 process is still starting");
+
+        if (control::MessageBox::questionText(nullptr, "Warning", QString("Starting for mwc713 process is taking longer than expected.\nContinue to wait?") +
+                                          "\n\nCommand line:\n\n" + commandLine,
+                                          "Yes", "No", true, false) == control::MessageBox::RETURN_CODE::BTN1) {
+            config::increaseTimeoutMultiplier();
+            armStartTimeout(process);
+            return;
+        }
+
+        if (process->state() != QProcess::Starting)
+            return; // was started while user was thinking
+
+        appendNotificationMessage( notify::MESSAGE_LEVEL::FATAL_ERROR, "mwc713 takes too much time to start. Something wrong with environment.\n\nCommand line:\n\n" + commandLine );
+        if (process == probeProcess)
+            onProbeFinished(false);
+        else
+            process->kill();
+    } );
+}
+
 // normal start. will require the password
 void MWC713::start(bool loginWithLastKnownPassword)  {
     qDebug() << "MWC713::start loginWithLastKnownPassword=" << loginWithLastKnownPassword;
@@ -165,17 +365,19 @@ void MWC713::start(bool loginWithLastKnownPassword)  {
 
     // Start the binary
     Q_ASSERT(mwc713process == nullptr);
-    Q_ASSERT(inputParser == nullptr);
+    Q_ASSERT(parserThread == nullptr);
 
     qDebug() << "Starting MWC713 at " << mwc713Path << " for config " << mwc713configPath;
 
+    txCache.setWallet( mwc713configPath + "\n" + readWalletConfig().getDataPath() );
+
     // Creating process and starting
-    mwc713process = initMwc713process({}, {} );
+    mwc713process = startMwc713process({}, {});
 
-    inputParser = new tries::Mwc713InputParser();
+    parserThread = new Mwc713ParserThread();
 
     eventCollector = new Mwc713EventManager(this);
-    eventCollector->connectWith(inputParser);
+    eventCollector->connectWith(parserThread);
     // Add first init task
     eventCollector->addTask( new TaskStarting(this), TaskStarting::TIMEOUT );
 
@@ -196,21 +398,25 @@ void MWC713::start2init(QString password) {
     startedMode = STARTED_MODE::INIT;
     // Start the binary
     Q_ASSERT(mwc713process == nullptr);
-    Q_ASSERT(inputParser == nullptr);
+    Q_ASSERT(parserThread == nullptr);
 
     mwcMqOnline = keybaseOnline = false;
     mwcMqStarted = keybaseStarted = false;
 
     qDebug() << "Starting MWC713 as init at " << mwc713Path << " for config " << mwc713configPath;
 
+    // New seed, cached transactions belong to another wallet
+    txCache.setWallet( mwc713configPath + "\n" + readWalletConfig().getDataPath() );
+    txCache.clear();
+
     // Creating process and starting
 
-    mwc713process = initMwc713process({"MWC_PASSWORD", password}, {"init"} );
+    mwc713process = startMwc713process({"MWC_PASSWORD", password}, {"init"});
 
-    inputParser = new tries::Mwc713InputParser();
+    parserThread = new Mwc713ParserThread();
 
     eventCollector = new Mwc713EventManager(this);
-    eventCollector->connectWith(inputParser);
+    eventCollector->connectWith(parserThread);
 
     // Adding permanent listeners
     // Adding permanent listeners
@@ -232,10 +438,14 @@ void MWC713::start2recover(const QVector<QString> & seed, QString password) {
 
     // Start the binary
     Q_ASSERT(mwc713process == nullptr);
-    Q_ASSERT(inputParser == nullptr);
+    Q_ASSERT(parserThread == nullptr);
 
     qDebug() << "Starting MWC713 as init at " << mwc713Path << " for config " << mwc713configPath;
 
+    // Wallet is restored from the node, cached transactions might be different
+    txCache.setWallet( mwc713configPath + "\n" + readWalletConfig().getDataPath() );
+    txCache.clear();
+
     QString seedStr;
     for ( auto & s : seed) {
         if (!seedStr.isEmpty())
@@ -245,12 +455,12 @@ void MWC713::start2recover(const QVector<QString> & seed, QString password) {
 
     // Creating process and starting
     // Mnemonic will moved into variables
-    mwc713process = initMwc713process({"MWC_PASSWORD", password, "MWC_MNEMONIC", seedStr}, {"recover", "--mnemonic", "env" } );
+    mwc713process = startMwc713process({"MWC_PASSWORD", password, "MWC_MNEMONIC", seedStr}, {"recover", "--mnemonic", "env" });
 
-    inputParser = new tries::Mwc713InputParser();
+    parserThread = new Mwc713ParserThread();
 
     eventCollector = new Mwc713EventManager(this);
-    eventCollector->connectWith(inputParser);
+    eventCollector->connectWith(parserThread);
     // Add first init task
     eventCollector->addTask( new TaskRecoverFull( this), TaskRecoverFull::TIMEOUT );
 
@@ -272,17 +482,17 @@ void MWC713::start2getnextkey( int64_t amountNano, QString btcaddress, QString a
 
     // Start the binary
     Q_ASSERT(mwc713process == nullptr);
-    Q_ASSERT(inputParser == nullptr);
+    Q_ASSERT(parserThread == nullptr);
 
     qDebug() << "Starting MWC713 for getnextkey at " << mwc713Path << " for config " << mwc713configPath;
 
     // Creating process and starting
     // Mnemonic will moved into variables
     // !!!!! Security breach
-    mwc713process = initMwc713process({}, {} );
-    inputParser = new tries::Mwc713InputParser();
+    mwc713process = startMwc713process({}, {});
+    parserThread = new Mwc713ParserThread();
     eventCollector = new Mwc713EventManager(this);
-    eventCollector->connectWith(inputParser);
+    eventCollector->connectWith(parserThread);
 
     // Excuting the single command and then read all output
 
@@ -311,18 +521,18 @@ void MWC713::start2receiveSlate( QString receiveAccount, QString identifier, QSt
 
     // Start the binary
     Q_ASSERT(mwc713process == nullptr);
-    Q_ASSERT(inputParser == nullptr);
+    Q_ASSERT(parserThread == nullptr);
 
     qDebug() << "Starting MWC713 receiveSlate at " << mwc713Path << " for config " << mwc713configPath;
 
     // Creating process and starting
     // Mnemonic will moved into variables
-    mwc713process = initMwc713process({}, {} );
+    mwc713process = startMwc713process({}, {});
 
-    inputParser = new tries::Mwc713InputParser();
+    parserThread = new Mwc713ParserThread();
 
     eventCollector = new Mwc713EventManager(this);
-    eventCollector->connectWith(inputParser);
+    eventCollector->connectWith(parserThread);
 
     // Adding permanent listeners
     eventCollector->addListener( new TaskErrWrnInfoListener(this) );
@@ -354,7 +564,15 @@ void MWC713::processStop(bool exitNicely) {
     mwcAddress = "";
     accountInfo.clear();
     currentAccount = "default"; // Keep current account by name. It fit better to mwc713 interactions.
+    mwc713Account = "";
+    accountSwitchesInFlight = 0;
     collectedAccountInfo.clear();
+    balanceRefresh = BALANCE_REFRESH::IDLE;
+    balanceRefreshFollowUp = false;
+
+    appContext->saveTaskLatencyStats(taskLatency);
+    txCache.save();
+    utxoCache.clear();
 
     if (mwcMqOnline)
         emit onMwcMqListenerStatus(false);
@@ -372,28 +590,12 @@ void MWC713::processStop(bool exitNicely) {
     // emit onWalletBalanceUpdated();
 
     if (mwc713process) {
-        if (exitNicely) {
-            qDebug() << "start exiting...";
-            executeMwc713command("exit", "");
-
-            if (!util::processWaitForFinished( mwc713process, 10000, "mwc713")) {
-                mwc713process->terminate();
-            }
-            qDebug() << "mwc713 is exited";
-        }
-        else {
-            // init state have to be killed. Otherwise it will create a
-            // seed without verification. We don't want that
-            mwc713process->kill();
-        }
-
-        mwc713process->deleteLater();
+        QProcess * process = mwc713process;
         mwc713process = nullptr;
-    }
+        launchQueue.removeOne(process);
+        mwc713pendingInput.clear();
 
-    if (inputParser) {
-        inputParser->deleteLater();
-        inputParser = nullptr;
+        stopMwc713processAsync(process, exitNicely);
     }
 
     if (eventCollector) {
@@ -402,9 +604,78 @@ void MWC713::processStop(bool exitNicely) {
         eventCollector = nullptr;
     }
 
+    if (parserThread) {
+        parserThread->deleteLater();
+        parserThread = nullptr;
+    }
+
 
 }
 
+void MWC713::stopMwc713processAsync(QProcess * process, bool exitNicely) {
+    if (process->state() == QProcess::NotRunning) {
+        // Never started or already dead
+        process->deleteLater();
+        return;
+    }
+
+    stoppingProcesses.push_back(process);
+    connect( process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished), this,
+             [this, process](int exitCode, QProcess::ExitStatus exitStatus) {
+                 Q_UNUSED(exitCode); Q_UNUSED(exitStatus);
+                 onStoppedMwc713process(process);
+             } );
+
+    if (exitNicely && process->state() == QProcess::Running) {
+        qDebug() << "start exiting...";
+        logger::logMwc713in("exit");
+        process->write( "exit\n" );
+
+        // Not exiting in time, terminate and then kill. The process is owned by this object until it is finished
+        QTimer::singleShot( (int)(10000 * config::getTimeoutMultiplier()), process, [process]() {
+            logger::logInfo("MWC713", "mwc713 is not exited in time, terminating");
+            process->terminate();
+            QTimer::singleShot( (int)(5000 * config::getTimeoutMultiplier()), process, [process]() {
+                logger::logInfo("MWC713", "mwc713 is not terminated in time, killing");
+                process->kill();
+            } );
+        } );
+    }
+    else {
+        // init state have to be killed. Otherwise it will create a
+        // seed without verification. We don't want that
+        process->kill();
+    }
+}
+
+void MWC713::onStoppedMwc713process(QProcess * process) {
+    qDebug() << "mwc713 is exited";
+    if (!stoppingProcesses.removeOne(process))
+        return;
+
+    process->deleteLater();
+
+    // New process might wait for this one
+    launchPendingMwc713process();
+    // Nothing is waiting, it is a logout or a mode switch. Next start will need mwc713
+    launchSpareMwc713process();
+}
+
+// Called from destructor, no event loop, no signals. The stopping processes need to be finished before the app exit
+void MWC713::waitForStoppingProcesses() {
+    QVector<QProcess *> processes = stoppingProcesses;
+    stoppingProcesses.clear();
+
+    for (QProcess * process : processes) {
+        process->disconnect(this);
+        if (!util::processWaitForFinished( process, 10000, "mwc713")) {
+            process->kill();
+            process->waitForFinished(1000);
+        }
+        delete process;
+    }
+}
+
 // Check signal: onLoginResult(bool ok)
 void MWC713::loginWithPassword(QString password)  {
     qDebug() << "MWC713::loginWithPassword call";
@@ -413,7 +684,8 @@ void MWC713::loginWithPassword(QString password)  {
 }
 
 // Exit from the wallet. Expected that state machine will switch to Init state
-// syncCall - stop NOW. Caller suppose to understand what he is doing
+// syncCall - stop without waiting for the queued tasks. The process is still stopped async,
+//            next start waits until it exits. Caller suppose to understand what he is doing
 void MWC713::logout(bool syncCall)  {
     qDebug() << "MWC713::logout syncCall=" << syncCall;
 
@@ -540,7 +812,25 @@ void MWC713::updateWalletBalance()  {
     // 2 - for every account get info ( see updateAccountList call )
     // 3 - restore back current account
 
-    eventCollector->addTask( new TaskAccountList(this), TaskAccountList::TIMEOUT );
+    // Queued refresh didn't read anything yet, it will cover this request
+    if (balanceRefresh == BALANCE_REFRESH::QUEUED) {
+        coalescedBalanceRefreshes++;
+        qDebug() << "Balance refresh is merged with the queued one, total merged: " << coalescedBalanceRefreshes;
+        return;
+    }
+    // Running refresh might read some accounts before the change. All requests that come now share a single next refresh
+    if (balanceRefresh == BALANCE_REFRESH::RUNNING) {
+        if (balanceRefreshFollowUp)
+            coalescedBalanceRefreshes++;
+        balanceRefreshFollowUp = true;
+        qDebug() << "Balance refresh is scheduled after the running one, total merged: " << coalescedBalanceRefreshes;
+        return;
+    }
+
+    eventCollector->beginTaskGroup(TASK_PRIORITY::BACKGROUND);
+    if ( eventCollector->addTask( new TaskAccountList(this), TaskAccountList::TIMEOUT ) )
+        balanceRefresh = BALANCE_REFRESH::QUEUED;
+    eventCollector->endTaskGroup();
 }
 
 // Create another account, note no delete exist for accounts
@@ -585,6 +875,8 @@ void MWC713::renameAccount(const QString & oldName, const QString & newName)  {
 // Check Signals: onRecoverProgress( int progress, int maxVal );
 // Check Signals: onCheckResult(bool ok, QString errors );
 void MWC713::check(bool wait4listeners)  {
+    // Check might restore or cancel transactions
+    txCache.clear();
     eventCollector->addTask( new TaskCheck(this,wait4listeners), TaskCheck::TIMEOUT );
 }
 
@@ -593,11 +885,13 @@ void MWC713::check(bool wait4listeners)  {
 // Before send, wallet always do the switch to account to make it active
 // Check signal:  onSend
 void MWC713::sendTo( const wallet::AccountInfo &account, int64_t coinNano, const QString & address, QString message, int inputConfirmationNumber, int changeOutputs )  {
+    eventCollector->beginTaskGroup(TASK_PRIORITY::USER_WRITE);
     // switch account first
-    eventCollector->addTask( new TaskAccountSwitch(this, account.accountName, walletPassword, true), TaskAccountSwitch::TIMEOUT );
+    eventCollector->addTask( new TaskAccountSwitch(this, account.accountName, walletPassword, true), TaskAccountSwitch::TIMEOUT, false );
     // If listening, strting...
 
     eventCollector->addTask( new TaskSendMwc(this, coinNano, address, message, inputConfirmationNumber, changeOutputs), TaskSendMwc::TIMEOUT );
+    eventCollector->endTaskGroup();
     // Set some funds
 
 }
@@ -612,10 +906,12 @@ void MWC713::sendFile( const wallet::AccountInfo &account, int64_t coinNano, QSt
         return;
     }
 
+    eventCollector->beginTaskGroup(TASK_PRIORITY::USER_WRITE);
     // switch account first
-    eventCollector->addTask( new TaskAccountSwitch(this, account.accountName, walletPassword, true), TaskAccountSwitch::TIMEOUT );
+    eventCollector->addTask( new TaskAccountSwitch(this, account.accountName, walletPassword, true), TaskAccountSwitch::TIMEOUT, false );
 
     eventCollector->addTask( new TaskSendFile(this, coinNano, message, fileTx, inputConfirmationNumber, changeOutputs ), TaskSendFile::TIMEOUT );
+    eventCollector->endTaskGroup();
 }
 
 // Receive transaction. Will generate *.response file in the same dir
@@ -643,37 +939,83 @@ void MWC713::finalizeFile( QString fileTxResponse )  {
 
 // Get total number of Outputs
 // Check Signal: onOutputCount(int number)
-void MWC713::getOutputCount(QString account)  {
-    eventCollector->addTask( new TaskAccountSwitch(this, account, walletPassword, true), TaskAccountSwitch::TIMEOUT );
+int64_t MWC713::getOutputCount(QString account)  {
+    int64_t requestId = eventCollector->beginTaskGroup(TASK_PRIORITY::INTERACTIVE, "getOutputCount");
+    eventCollector->addTask( new TaskAccountSwitch(this, account, walletPassword, true), TaskAccountSwitch::TIMEOUT, false );
     eventCollector->addTask( new TaskOutputCount(this, account), TaskOutputCount::TIMEOUT );
+    eventCollector->endTaskGroup();
+    return requestId;
 }
 
 // Show outputs for the wallet
-// Check Signal: onOutputs( QString account, int64_t height, QVector<WalletOutput> Transactions)
-void MWC713::getOutputs(QString account, int offset, int number)  {
+// Check Signal: onOutputs( QString account, int64_t height, OutputColumns outputs)
+int64_t MWC713::getOutputs(QString account, int offset, int number)  {
+    // Newer page request replace the queued one
+    int64_t requestId = eventCollector->beginTaskGroup(TASK_PRIORITY::INTERACTIVE, "getOutputs");
     // Need to switch account first
-    eventCollector->addTask( new TaskAccountSwitch(this, account, walletPassword, true), TaskAccountSwitch::TIMEOUT );
+    eventCollector->addTask( new TaskAccountSwitch(this, account, walletPassword, true), TaskAccountSwitch::TIMEOUT, false );
     eventCollector->addTask( new TaskOutputs(this, offset, number), TaskOutputs::TIMEOUT );
+    eventCollector->endTaskGroup();
+    utxoCache.setLastPage(account, offset, number);
+    return requestId;
+}
+
+void MWC713::releaseOutputs() {
+    utxoCache.resetLastPage();
+}
+
+void MWC713::refreshOutputs() {
+    if ( !isWalletRunningAndLoggedIn() )
+        return;
+
+    QString account;
+    int offset = 0;
+    int number = 0;
+    if (!utxoCache.getLastPage(account, offset, number))
+        return; // Nobody looked at the outputs yet
+
+    // Several events in a row need a single refresh
+    eventCollector->beginTaskGroup(TASK_PRIORITY::BACKGROUND, "refreshOutputs");
+    // Background refresh must not change the current account
+    eventCollector->addTask( new TaskAccountSwitch(this, account, walletPassword, false), TaskAccountSwitch::TIMEOUT, false );
+    eventCollector->addTask( new TaskOutputs(this, offset, number), TaskOutputs::TIMEOUT );
+    eventCollector->endTaskGroup();
 }
 
 // Get total number of Transactions
 // Check Signal: onTransactionCount(int number)
-void MWC713::getTransactionCount(QString account) {
-    eventCollector->addTask( new TaskAccountSwitch(this, account, walletPassword, true), TaskAccountSwitch::TIMEOUT );
+int64_t MWC713::getTransactionCount(QString account) {
+    int64_t requestId = eventCollector->beginTaskGroup(TASK_PRIORITY::INTERACTIVE, "getTransactionCount");
+    eventCollector->addTask( new TaskAccountSwitch(this, account, walletPassword, true), TaskAccountSwitch::TIMEOUT, false );
     eventCollector->addTask( new TaskTransactionCount(this, account), TaskTransactions::TIMEOUT );
-}
-
-void MWC713::getTransactions(QString account, int offset, int number)  {
-    // Need to switch account first
-    eventCollector->addTask( new TaskAccountSwitch(this, account, walletPassword, true), TaskAccountSwitch::TIMEOUT );
-    eventCollector->addTask( new TaskTransactions(this, offset, number), TaskTransactions::TIMEOUT );
+    eventCollector->endTaskGroup();
+    return requestId;
+}
+
+// Page is delivered from the cache first if it has it. Then only transactions that might be changed
+// or are not cached are requested from mwc713.
+int64_t MWC713::getTransactions(QString account, int offset, int number)  {
+    if (txCache.hasRange(account, offset, number))
+        emit onTransactions( account, txCache.getHeight(account), TransactionColumns::fromVector( txCache.getRange(account, offset, number) ) );
+
+    // Newer page request replace the queued one
+    int64_t requestId = eventCollector->beginTaskGroup(TASK_PRIORITY::INTERACTIVE, "getTransactions");
+    int64_t refreshStart = txCache.getRefreshStart(account, offset, number);
+    if (refreshStart>=0) {
+        // Need to switch account first
+        eventCollector->addTask( new TaskAccountSwitch(this, account, walletPassword, true), TaskAccountSwitch::TIMEOUT, false );
+        eventCollector->addTask( new TaskTransactions(this, int(refreshStart), int(offset + number - refreshStart), offset, number), TaskTransactions::TIMEOUT );
+    }
+    eventCollector->endTaskGroup();
+    return requestId;
 }
 
 // Read all transactions for all accounts. Might take time...
-// Check Signal: onAllTransactions( QVector<WalletTransaction> Transactions)
+// Check Signal: onAllTransactions( TransactionColumns Transactions)
 // Schedule bunch of requests.
-void MWC713::getAllTransactions() {
+int64_t MWC713::getAllTransactions() {
     // Requesting transactions for all accounts...
+    int64_t requestId = eventCollector->beginTaskGroup(TASK_PRIORITY::BACKGROUND);
 
     // By first task only checking if it is exist
     if ( eventCollector->addTask( new TaskAllTransactionsStart(this), -1, true ) ) {
@@ -681,10 +1023,31 @@ void MWC713::getAllTransactions() {
 
         for (AccountInfo & acc : accountInfo ) {
             eventCollector->addTask(new TaskAccountSwitch(this, acc.accountName, walletPassword, false), TaskAccountSwitch::TIMEOUT, false);
-            eventCollector->addTask(new TaskAllTransactions(this), TaskAllTransactions::TIMEOUT, false);
+            // Final transactions are taken from the cache
+            eventCollector->addTask(new TaskAllTransactions(this, txCache.getAllRefreshStart(acc.accountName)), TaskAllTransactions::TIMEOUT, false);
         }
         eventCollector->addTask( new TaskAllTransactionsEnd(this), -1, false );
     }
+    eventCollector->endTaskGroup();
+    return requestId;
+}
+
+// Search the account transactions history. Not final transactions are refreshed first, the final ones are taken from the cache.
+// Check Signal: onTransactionQueryResult( int64_t requestId, QString account, int total, int offset, TransactionColumns transactions, bool last )
+int64_t MWC713::queryTransactions(QString account, TransactionQuery query) {
+    // Newer query replace the queued one
+    int64_t requestId = eventCollector->beginTaskGroup(TASK_PRIORITY::INTERACTIVE, "queryTransactions");
+    eventCollector->addTask( new TaskAccountSwitch(this, account, walletPassword, true), TaskAccountSwitch::TIMEOUT, false );
+    eventCollector->addTask( new TaskAllTransactions(this, txCache.getAllRefreshStart(account), false), TaskAllTransactions::TIMEOUT, false );
+    eventCollector->addTask( new TaskTransactionQuery(this, requestId, account, query), -1, false );
+    eventCollector->endTaskGroup();
+    return requestId;
+}
+
+bool MWC713::cancelRequest(int64_t requestId) {
+    if (eventCollector==nullptr)
+        return false;
+    return eventCollector->cancelTaskGroup(requestId);
 }
 
 // -------------- Transactions
@@ -731,7 +1094,10 @@ bool MWC713::getNodeStatus() {
     if ( !isWalletRunningAndLoggedIn() )
         return false; // ignoring request
 
+    // Queued or running nodeinfo absorbs this request. onNodeStatus from it is the answer for all callers
+    eventCollector->beginTaskGroup(TASK_PRIORITY::BACKGROUND);
     eventCollector->addTask( new TaskNodeInfo(this), TaskNodeInfo::TIMEOUT );
+    eventCollector->endTaskGroup();
     return true;
 }
 
@@ -747,6 +1113,12 @@ void MWC713::executeMwc713command(QString cmd, QString shadowStr) {
     else
         logger::logMwc713in( "CENSORED: " + shadowStr );
 
+    if (mwc713process->state() != QProcess::Running) {
+        // Process is starting, or waiting for the previous one to exit. Will be written by mwc713started
+        mwc713pendingInput += (cmd + "\n").toLocal8Bit();
+        return;
+    }
+
     mwc713process->write( (cmd + "\n").toLocal8Bit() );
 }
 
@@ -898,7 +1270,11 @@ void MWC713::updateAccountList( QVector<QString> accounts ) {
     bool cancel = false;
     int idx = 0;
     for (QString acc : accounts) {
+        // Group per account, so interactive requests can get in between
+        eventCollector->beginTaskGroup(TASK_PRIORITY::BACKGROUND);
         if (! eventCollector->addTask( new TaskAccountSwitch(this, acc, walletPassword, false), TaskAccountSwitch::TIMEOUT, idx == 0 ) ) {
+            eventCollector->endTaskGroup();
+            finishBalanceRefresh();
             cancel  = true;
             break;
         }
@@ -914,9 +1290,12 @@ void MWC713::updateAccountList( QVector<QString> accounts ) {
 
         eventCollector->addTask( new TaskAccountInfo(this, params.inputConfirmationNumber, !need2sync ), TaskAccountInfo::TIMEOUT, false );
         eventCollector->addTask( new TaskAccountProgress(this, idx++, accounts.size() ), -1, false ); // Updating the progress
+        eventCollector->endTaskGroup();
     }
     if (!cancel) {
+        eventCollector->beginTaskGroup(TASK_PRIORITY::BACKGROUND);
         eventCollector->addTask( new TaskAccountListFinal(this, currentAccount), -1, false ); // Finalize the task
+        eventCollector->endTaskGroup();
     }
     // Final will switch back to current account
 }
@@ -947,7 +1326,11 @@ void MWC713::updateAccountFinalize(QString prevCurrentAccount) {
 
     // !!!!!! NOTE, 'false' mean that we don't save to that account. It make sence because during such long operation
     //  somebody could change account
+    eventCollector->beginTaskGroup(TASK_PRIORITY::BACKGROUND);
     eventCollector->addTask( new TaskAccountSwitch(this, prevCurrentAccount, walletPassword, false), TaskAccountSwitch::TIMEOUT );
+    eventCollector->endTaskGroup();
+
+    finishBalanceRefresh();
 }
 
 void MWC713::createNewAccount( QString newAccountName ) {
@@ -967,6 +1350,9 @@ void MWC713::createNewAccount( QString newAccountName ) {
 
 void MWC713::switchToAccount( QString switchAccountName, bool makeAccountCurrent ) {
     logger::logEmit( "MWC713", "onAccountSwitched",switchAccountName);
+    // Switch failed, don't know where mwc713 is
+    if (switchAccountName.isEmpty())
+        resetMwc713Account();
     if (makeAccountCurrent) {
         currentAccount = switchAccountName;
         appContext->setCurrentAccountName(currentAccount);
@@ -984,6 +1370,10 @@ void MWC713::updateRenameAccount(const QString & oldName, const QString & newNam
             ai.accountName = newName;
     }
 
+    // Names are reused by create and delete, the history has to follow the account
+    if (success)
+        txCache.renameAccount(oldName, newName);
+
     if (createSimulation) {
         logger::logEmit( "MWC713", "onAccountCreated",newName);
 
@@ -1032,6 +1422,8 @@ void MWC713::reportSlateSendTo( QString slate, QString mwc, QString sendAddr ) {
 
     logger::logEmit( "MWC713", "onSlateSend", slate + " with " +mwc + " to " + sendAddr );
     emit onSlateSendTo(slate, mwc, sendAddr);
+
+    refreshOutputs();
 }
 
 void MWC713::reportSlateSendBack( QString slate,  QString sendAddr ) {
@@ -1051,6 +1443,7 @@ void MWC713::reportSlateReceivedBack( QString slate, QString mwc, QString fromAd
 
     // Request balace refresh
     updateWalletBalance();
+    refreshOutputs();
 }
 
 void MWC713::reportSlateReceivedFrom( QString slate, QString mwc, QString fromAddr, QString message ) {
@@ -1064,6 +1457,7 @@ void MWC713::reportSlateReceivedFrom( QString slate, QString mwc, QString fromAd
     emit onSlateReceivedFrom(slate, mwc, fromAddr, message );
 
     updateWalletBalance();
+    refreshOutputs();
 
     // Show message box with congrats. Message bot should work from any point. No needs to block locking or what ever we have
     control::MessageBox::messageHTML(nullptr, "Congratulations!",
@@ -1083,6 +1477,7 @@ void MWC713::reportSlateFinalized( QString slate ) {
 
     // Request balance refresh
     updateWalletBalance();
+    refreshOutputs();
 }
 
 void MWC713::setSendFileResult( bool success, QStringList errors, QString fileName ) {
@@ -1113,13 +1508,29 @@ void MWC713::setFinalizeFile( bool success, QStringList errors, QString fileName
 
 // Transactions
 void MWC713::updateTransactionCount(QString account, int number) {
+    txCache.setCount(account, number);
     logger::logEmit( "MWC713", "onTransactionCount", "number=" + QString::number(number) );
     emit onTransactionCount( account, number );
 }
 
-void MWC713::setTransactions( QString account, int64_t height, QVector<WalletTransaction> Transactions ) {
+void MWC713::setTransactions( QString account, int64_t height, QVector<WalletTransaction> Transactions, int readOffset, int pageOffset, int pageNumber ) {
+    if (!TransactionCache::isOffsetIndexed(readOffset, Transactions))
+        dropTransactionsIndex(account, 0);
+    txCache.update(account, height, Transactions);
+
+    if (!txCache.isIndexed(account)) {
+        if (readOffset != pageOffset) {
+            // Head of the page was taken from the cache, it can't be trusted. Reading the whole page
+            getTransactions(account, pageOffset, pageNumber);
+            return;
+        }
+        logger::logEmit( "MWC713", "onTransactions", "account="+account + " not cached" );
+        emit onTransactions( account, height, TransactionColumns::fromVector( Transactions ) );
+        return;
+    }
+
     logger::logEmit( "MWC713", "onTransactions", "account="+account );
-    emit onTransactions( account, height, Transactions );
+    emit onTransactions( account, height, TransactionColumns::fromVector( txCache.getRange(account, pageOffset, pageNumber) ) );
 }
 
 void MWC713::updateOutputCount(QString account, int number) {
@@ -1127,9 +1538,16 @@ void MWC713::updateOutputCount(QString account, int number) {
     emit onOutputCount( account, number );
 }
 
-void MWC713::setOutputs( QString account, int64_t height, QVector<WalletOutput> outputs) {
+void MWC713::setOutputs( QString account, int64_t height, QVector<WalletOutput> outputs, int offset, int number) {
+    WalletOutputsDiff diff = utxoCache.applyPage(account, height, offset, number, outputs);
+    if (!diff.isEmpty()) {
+        logger::logEmit( "MWC713", "onOutputsChanged", "account="+account + " added=" + QString::number(diff.added.size()) +
+                " removed=" + QString::number(diff.removed.size()) + " changed=" + QString::number(diff.changed.size()) );
+        emit onOutputsChanged( diff );
+    }
+
     logger::logEmit( "MWC713", "onOutputs", "account="+account );
-    emit onOutputs( account, height, outputs );
+    emit onOutputs( account, height, OutputColumns::fromVector(outputs) );
 }
 
 void MWC713::setExportProofResults( bool success, QString fn, QString msg ) {
@@ -1196,16 +1614,66 @@ void MWC713::notifyMqFailedToStart() {
 }
 
 void MWC713::processAllTransactionsStart() {
-    collectedTransactions.clear();
+    collectedTransactionAccounts.clear();
 }
 
-void MWC713::processAllTransactionsAppend(const QVector<WalletTransaction> & trVector) {
-    collectedTransactions.append(trVector);
+void MWC713::processAllTransactionsAppend(const QString & account, int64_t height, const QVector<WalletTransaction> & trVector) {
+    txCache.update(account, height, trVector);
+    if (!collectedTransactionAccounts.contains(account))
+        collectedTransactionAccounts.push_back(account);
 }
 
 void MWC713::processAllTransactionsEnd() {
-    emit onAllTransactions(collectedTransactions);
-    collectedTransactions.clear();
+    TransactionColumns transactions;
+    for (const QString & account : collectedTransactionAccounts) {
+        for (const WalletTransaction & tx : txCache.getAll(account))
+            transactions.append(tx);
+    }
+    collectedTransactionAccounts.clear();
+
+    emit onAllTransactions(transactions);
+}
+
+void MWC713::updateCachedTransactions(const QString & account, int64_t height, const QVector<WalletTransaction> & trVector) {
+    txCache.update(account, height, trVector);
+}
+
+void MWC713::dropTransactionsIndex(const QString & account, int64_t readFrom) {
+    if (!txCache.isIndexed(account))
+        return;
+
+    logger::logInfo("MWC713", "mwc713 transaction rows don't match txIdx for account " + account + ", transactions cache is disabled for it");
+    txCache.dropIndex(account);
+
+    if (readFrom>0) {
+        // The read started after the cached transactions, some might be missed
+        eventCollector->beginTaskGroup(TASK_PRIORITY::BACKGROUND);
+        eventCollector->addTask( new TaskAccountSwitch(this, account, walletPassword, false), TaskAccountSwitch::TIMEOUT, false );
+        eventCollector->addTask( new TaskAllTransactions(this, 0, false), TaskAllTransactions::TIMEOUT, false );
+        eventCollector->endTaskGroup();
+    }
+}
+
+void MWC713::runTransactionQuery(int64_t requestId, const QString & account, const TransactionQuery & query) {
+    if (queryThread == nullptr) {
+        queryThread = new TransactionQueryThread();
+        connect( queryThread, &TransactionQueryThread::sgResult, this, &MWC713::onQueryResult, Qt::QueuedConnection );
+    }
+
+    // The history is copied to the query thread only when it was changed
+    int64_t revision = txCache.getRevision(account);
+    QVector<WalletTransaction> transactions;
+    if (queryRevisionSent.value(account, -1) != revision) {
+        transactions = txCache.getAll(account);
+        queryRevisionSent[account] = revision;
+    }
+    queryThread->query(requestId, account, revision, transactions, query);
+}
+
+void MWC713::onQueryResult(int64_t requestId, QString account, int total, int offset, TransactionColumns transactions, bool last) {
+    logger::logEmit( "MWC713", "onTransactionQueryResult", account + " total=" + QString::number(total) + " offset=" + QString::number(offset) +
+                    " size=" + QString::number(transactions.size()) );
+    emit onTransactionQueryResult(requestId, account, total, offset, transactions, last);
 }
 
 
@@ -1218,6 +1686,7 @@ void MWC713::mwc713connect(QProcess * process, bool trackProcessExit) {
     Q_ASSERT(process);
 
     if (process) {
+        mwc713connections.push_back( connect( process, &QProcess::started, this, &MWC713::mwc713started) );
         mwc713connections.push_back( connect( process, &QProcess::errorOccurred, this, &MWC713::mwc713errorOccurred, Qt::QueuedConnection) );
 
         if (trackProcessExit) {
@@ -1238,6 +1707,21 @@ void MWC713::mwc713disconnect() {
     mwc713connections.clear();
 }
 
+void MWC713::mwc713started() {
+    logger::logInfo("MWC713", "mwc713 process is started in " + QString::number(QDateTime::currentMSecsSinceEpoch() - walletStartTime) + " ms" );
+    if (trace::isEnabled())
+        trace::asyncSpan("mwc713", "mwc713 process start", mwc713launchUs, mwc713launchUs, trace::now() );
+
+    if (mwc713process && !mwc713pendingInput.isEmpty()) {
+        mwc713process->write(mwc713pendingInput);
+        mwc713pendingInput.clear();
+    }
+
+    // TaskStarting deadline doesn't include the time in the launch queue
+    if (eventCollector)
+        eventCollector->onProcessStarted();
+}
+
 void MWC713::mwc713errorOccurred(QProcess::ProcessError error) {
     logger::logInfo("MWC713", "Unable to start mwc713 process. ProcessError=" + QString::number(error) );
     qDebug() << "Unable to start mwc713 process. ProcessError=" << error;
@@ -1246,14 +1730,25 @@ void MWC713::mwc713errorOccurred(QProcess::ProcessError error) {
         logger::logInfo("MWC713", "stdout: " + mwc713process->readAllStandardOutput() );
         logger::logInfo("MWC713", "stderr: " + mwc713process->readAllStandardError() );
 
+        launchQueue.removeOne(mwc713process);
         mwc713process->deleteLater();
         mwc713process = nullptr;
+        mwc713pendingInput.clear();
     }
 
-    appendNotificationMessage( notify::MESSAGE_LEVEL::FATAL_ERROR,
-                     "mwc713 process exited. Process error: "+ QString::number(error) +
-                     + "\n\nCommand line:\n\n" + commandLine);
-
+    switch (error) {
+        case QProcess::FailedToStart:
+            appendNotificationMessage( notify::MESSAGE_LEVEL::FATAL_ERROR, "mwc713 failed to start mwc713 located at " + mwc713Path + "\n\nCommand line:\n\n" + commandLine );
+            break;
+        case QProcess::Crashed:
+            appendNotificationMessage( notify::MESSAGE_LEVEL::FATAL_ERROR, "mwc713 crashed\n\nCommand line:\n\n" + commandLine );
+            break;
+        default:
+            appendNotificationMessage( notify::MESSAGE_LEVEL::FATAL_ERROR,
+                             "mwc713 process exited. Process error: "+ QString::number(error) +
+                             + "\n\nCommand line:\n\n" + commandLine);
+            break;
+    }
 }
 
 void MWC713::mwc713finished(int exitCode, QProcess::ExitStatus exitStatus) {
@@ -1293,39 +1788,49 @@ void MWC713::mwc713readyReadStandardError() {
 }
 
 void MWC713::mwc713readyReadStandardOutput() {
-    if (mwc713process==nullptr)
+    if (mwc713process==nullptr || parserThread==nullptr)
         return;
 
-    QString str( ioutils::FilterEscSymbols( mwc713process->readAllStandardOutput() ) );
-    qDebug() << "Get output:" << str;
-    logger::logMwc713out(str);
+    // Filtering and parsing are done by the parser thread. Events will come to eventCollector
+    parserThread->processOutput( mwc713process->readAllStandardOutput() );
+}
 
-    // Let's filter out the possible prompt from the editor it can be located anywhere
-    // To filter out:  'wallet713>'
-    auto lns = str.split(QRegExp("[\r\n]"),QString::SkipEmptyParts);
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+//      Utils
 
-    QString filteredStr;
-    for (auto ln : lns) {
-        if (ln.startsWith("wallet713>"))
-            ln = ln.mid(strlen("wallet713>")).trimmed();
+bool MWC713::skipAccountSwitch(const QString & accountName) {
+    // The switch in flight might fail, can't skip until it is done
+    if (accountSwitchesInFlight>0 || mwc713Account.isEmpty() || accountName != mwc713Account)
+        return false;
 
-        if (!filteredStr.isEmpty())
-            filteredStr += "\n";
-        filteredStr += ln;
-    }
+    elidedAccountSwitches++;
+    qDebug() << "Skipping switch to account " << accountName << ", total skipped: " << elidedAccountSwitches;
+    return true;
+}
 
-    if (str.size()>0 && (str[0] == '\n' || str[0] == '\r') )
-        filteredStr = "\n" + filteredStr;
+void MWC713::startAccountSwitch() {
+    accountSwitchesInFlight++;
+    mwc713Account = "";
+}
 
-    if ( str.size()>0 && (str[str.size()-1] == '\n' || str[str.size()-1] == '\r') ) {
-        filteredStr += "\n";
-    }
+void MWC713::finishAccountSwitch(const QString & accountName) {
+    Q_ASSERT(accountSwitchesInFlight>0);
+    accountSwitchesInFlight = std::max(0, accountSwitchesInFlight-1);
+    // Account is known only after the last written switch
+    mwc713Account = accountSwitchesInFlight==0 ? accountName : "";
+}
 
-    inputParser->processInput(filteredStr);
+void MWC713::startBalanceRefresh() {
+    balanceRefresh = BALANCE_REFRESH::RUNNING;
 }
 
-//////////////////////////////////////////////////////////////////////////////////////////////////////
-//      Utils
+void MWC713::finishBalanceRefresh() {
+    balanceRefresh = BALANCE_REFRESH::IDLE;
+    if (balanceRefreshFollowUp) {
+        balanceRefreshFollowUp = false;
+        updateWalletBalance();
+    }
+}
 
 // Update acc value at collection accounts. If account is not founf, we can add it (addIfNotFound) or skip
 void MWC713::updateAccountInfo( const AccountInfo & acc, QVector<AccountInfo> & accounts, bool addIfNotFound ) const {
@@ -1478,6 +1983,8 @@ bool MWC713::setWalletConfig( const WalletConfig & config, core::AppContext * ap
 
     emit onConfigUpdate();
 
+    // Warm process has an old config
+    dropSpareMwc713process();
     // Stopping the wallet. Start will be done by init state and caller is responsible for that
     processStop(true); // sync if ok for this call
     return true;
@@ -16,13 +16,15 @@
 #define MWC713_H
 
 #include "wallet.h"
+#include "tasklatency.h"
+#include "tasktiming.h"
+#include "txcache.h"
+#include "utxocache.h"
+#include "txquery.h"
 #include <QObject>
 #include <QProcess>
 #include "../core/global.h"
 
-namespace tries {
-    class Mwc713InputParser;
-}
 
 namespace core {
 class AppContext;
@@ -31,6 +33,7 @@ class AppContext;
 namespace wallet {
 
 class Mwc713EventManager;
+class Mwc713ParserThread;
 
 class MWC713 : public Wallet
 {
@@ -52,9 +55,9 @@ public:
     virtual bool isRunning() override {return mwc713process!= nullptr;}
 
 
-    // Check if waaled need to be initialized or not. Will run statndalone app, wait for exit and return the result
-    // Call might take few seconds
-    virtual bool checkWalletInitialized() override;
+    // Check if waaled need to be initialized or not. Will run statndalone app 'mwc713 state', result come when it exit.
+    // Check signal: onWalletInitialized(bool initialized)
+    virtual void checkWalletInitialized() override;
 
     virtual STARTED_MODE getStartedMode() override { if (mwc713process==nullptr) {return STARTED_MODE::OFFLINE;} return startedMode;}
 
@@ -92,7 +95,7 @@ public:
     virtual void loginWithPassword(QString password)  override;
 
     // Exit from the wallet. Expected that state machine will switch to Init state
-    // syncCall - stop NOW. Caller suppose to understand what he is doing
+    // syncCall - stop without waiting for the queued tasks, the process exits async. Caller suppose to understand what he is doing
     virtual void logout(bool syncCall) override;
 
     // Confirm that user write the passphase
@@ -224,32 +227,70 @@ public:
 
     // Get total number of Outputs
     // Check Signal: onOutputCount(int number)
-    virtual void getOutputCount(QString account)  override;
+    virtual int64_t getOutputCount(QString account)  override;
 
     // Show outputs for the wallet
-    // Check Signal: onOutputs( QString account, int64_t height, QVector<WalletOutput> outputs)
-    virtual void getOutputs(QString account, int offset, int number)  override;
+    // Check Signal: onOutputs( QString account, int64_t height, OutputColumns outputs)
+    virtual int64_t getOutputs(QString account, int offset, int number)  override;
+    // Outputs page is closed, wallet events don't need to refresh it any more
+    virtual void releaseOutputs() override;
 
     // Get total number of Transactions
     // Check Signal: onTransactionCount(int number)
-    virtual void getTransactionCount(QString account) override;
+    virtual int64_t getTransactionCount(QString account) override;
 
     // Show all transactions for current account
-    // Check Signal: onTransactions( QString account, int64_t height, QVector<WalletTransaction> Transactions)
-    virtual void getTransactions(QString account, int offset, int number)  override;
+    // Check Signal: onTransactions( QString account, int64_t height, TransactionColumns Transactions)
+    virtual int64_t getTransactions(QString account, int offset, int number)  override;
 
     // Read all transactions for all accounts. Might take time...
-    // Check Signal: onAllTransactions( QVector<WalletTransaction> Transactions)
-    virtual void getAllTransactions() override;
+    // Check Signal: onAllTransactions( TransactionColumns Transactions)
+    virtual int64_t getAllTransactions() override;
+
+    // Search the account transactions history. Not final transactions are refreshed first.
+    // Check Signal: onTransactionQueryResult( int64_t requestId, QString account, int total, int offset, TransactionColumns transactions, bool last )
+    virtual int64_t queryTransactions(QString account, TransactionQuery query) override;
+
+    // Cancel the request that is not started yet
+    virtual bool cancelRequest(int64_t requestId) override;
+
+    // Timing histograms of the wallet tasks
+    virtual TaskTimingStats getTaskTimingStats() const override {return taskTiming;}
 
 public:
     // Feed the command to mwc713 process
     void executeMwc713command( QString cmd, QString shadowStr);
 
     bool isWalletRunningAndLoggedIn() const { return ! (mwc713process== nullptr || eventCollector== nullptr || startedMode != STARTED_MODE::NORMAL || loggedIn==false ); }
+    // False while the process is starting or waiting for the previous one to exit. Tasks have no deadline until then.
+    bool isMwc713processStarted() const { return mwc713process!=nullptr && mwc713process->state() == QProcess::Running; }
+
+    // Number of account switches that was skipped because mwc713 was already at that account
+    int64_t getElidedAccountSwitches() const {return elidedAccountSwitches;}
+    // Return true if the switch is not needed: mwc713 is at this account and no other switch is in flight.
+    // Called when the switch is about to be written
+    bool skipAccountSwitch(const QString & accountName);
+    // Switch command was written, mwc713 account is not known until its result
+    void startAccountSwitch();
+    // Switch result. accountName is empty if it failed. Account is known when all written switches are done
+    void finishAccountSwitch(const QString & accountName);
+    // mwc713 active account is not known any more. Next switch will be executed
+    void resetMwc713Account() { mwc713Account = ""; }
+
+    // Observed execution time of the commands, for the task deadlines
+    TaskLatencyStats & getTaskLatency() {return taskLatency;}
+    // Where the task time goes, for diagnostics
+    TaskTimingStats & getTaskTiming() {return taskTiming;}
+
+    // Number of balance refresh requests that was merged into the queued or running refresh
+    int64_t getCoalescedBalanceRefreshes() const {return coalescedBalanceRefreshes;}
+    // Balance refresh started to read the data. Requests from now will need another refresh
+    void startBalanceRefresh();
+    // Balance refresh is done or failed. Starting the refresh that was requested while this one was running
+    void finishBalanceRefresh();
 
 public:
-    // stop mwc713 process nicely
+    // stop mwc713 process nicely. The process is exiting in the background, next process will be launched when it is done
     void processStop(bool exitNicely);
 
     void setLoginResult(bool ok);
@@ -309,10 +350,12 @@ public:
 
     // Transactions
     void updateTransactionCount(QString account, int number);
-    void setTransactions( QString account, int64_t height, QVector<WalletTransaction> Transactions);
+    // Transactions are merged into the cache, the page [pageOffset, pageOffset+pageNumber) is delivered from it.
+    // readOffset - 'txs -o' offset of the transactions. If rows don't match txIdx, the page is delivered as mwc713 printed it.
+    void setTransactions( QString account, int64_t height, QVector<WalletTransaction> Transactions, int readOffset, int pageOffset, int pageNumber);
     // Outputs results
     void updateOutputCount(QString account, int number);
-    void setOutputs( QString account, int64_t height, QVector<WalletOutput> outputs);
+    void setOutputs( QString account, int64_t height, QVector<WalletOutput> outputs, int offset, int number);
 
     void setExportProofResults( bool success, QString fn, QString msg );
     void setVerifyProofResults( bool success, QString fn, QString msg );
@@ -330,8 +373,14 @@ public:
 
         //-------------
     void processAllTransactionsStart();
-    void processAllTransactionsAppend(const QVector<WalletTransaction> & trVector);
+    void processAllTransactionsAppend(const QString & account, int64_t height, const QVector<WalletTransaction> & trVector);
     void processAllTransactionsEnd();
+    // Transactions that was refreshed for the search
+    void updateCachedTransactions(const QString & account, int64_t height, const QVector<WalletTransaction> & trVector);
+    void runTransactionQuery(int64_t requestId, const QString & account, const TransactionQuery & query);
+    // mwc713 rows don't match txIdx, cached ranges of the account can't be used any more.
+    // readFrom - offset of the read that found it, the transactions before it are reread in the background.
+    void dropTransactionsIndex(const QString & account, int64_t readFrom);
 private:
 
 
@@ -346,8 +395,42 @@ private:
     // paramsPlus - additional parameters for the process
     QProcess * initMwc713process( const QStringList & envVariables, const QStringList & paramsPlus, bool trackProcessExit = true );
 
+    // Attach to the warm spare process if parameters match, otherwise init and launch a new one
+    QProcess * startMwc713process( const QStringList & envVariables, const QStringList & paramsPlus );
+
+    // Process is started, or postponed until the stopping or probing processes exit.
+    // Only one mwc713 can work with the wallet data at the time.
+    void launchMwc713process(QProcess * process);
+    // Launch the postponed processes if nothing else is running any more
+    void launchPendingMwc713process();
+    bool isMwc713busy() const;
+    QString mwc713commandLine(const QProcess * process) const;
+
+    // Warm spare mwc713. It is started when nothing is running and the next start is expected
+    void launchSpareMwc713process();
+    QProcess * attachSpareMwc713process();
+    void dropSpareMwc713process();
+    // Waiting for the process start. Asking the user if it is taking too long
+    void armStartTimeout(QProcess * process);
+
+    // Stopping process, it is released when exit or killed
+    void stopMwc713processAsync(QProcess * process, bool exitNicely);
+    void onStoppedMwc713process(QProcess * process);
+    // App is exiting, no event loop any more. Have to wait for the stopping processes
+    void waitForStoppingProcesses();
+
+    // 'mwc713 state' process is finished or failed
+    void onProbeFinished(bool ok);
+    void armProbeTimeout(QProcess * process);
+
+    // Slate events don't have the outputs. Rereading the last outputs page in the background, the views get the diff.
+    void refreshOutputs();
+
 private slots:
+    void onQueryResult(int64_t requestId, QString account, int total, int offset, TransactionColumns transactions, bool last);
+
     // mwc713 Process IOs
+    void	mwc713started();
     void	mwc713errorOccurred(QProcess::ProcessError error);
     void	mwc713finished(int exitCode, QProcess::ExitStatus exitStatus);
     void	mwc713readyReadStandardError();
@@ -362,7 +445,15 @@ private:
     QString mwc713Path; // path to the backed binary
     QString mwc713configPath; // config file for mwc713
     QProcess * mwc713process = nullptr;
-    tries::Mwc713InputParser * inputParser = nullptr; // Parser will generate bunch of signals that wallet will listem on
+    QVector<QProcess *> launchQueue; // processes that are waiting for the previous process exit
+    int64_t mwc713launchUs = 0; // trace time of the mwc713process launch
+    QByteArray mwc713pendingInput; // commands that was written before the process started
+    QVector<QProcess *> stoppingProcesses; // exiting mwc713 processes, not owned by wallet state any more
+    QProcess * probeProcess = nullptr; // 'mwc713 state' process, see checkWalletInitialized
+    QProcess * spareProcess = nullptr; // started mwc713 that nobody use yet
+    int64_t spareLaunchUs = 0; // trace time of the spare launch
+    int64_t spareReadyUs = 0; // trace time of the spare first output. 0 if it is still starting
+    Mwc713ParserThread * parserThread = nullptr; // Parsing mwc713 output in the separate thread. Events are pulled by eventCollector
 
     STARTED_MODE startedMode = STARTED_MODE::OFFLINE;
     bool   loggedIn = false; // Make sence for startedMode NORMAL. True if login was successfull
@@ -388,13 +479,37 @@ private:
     // Accounts with balances info
     QVector<AccountInfo> accountInfo;
     QString currentAccount = "default"; // Keep current account by name. It fit better to mwc713 interactions.
+
+    // Account that mwc713 is at, confirmed by the switch result. Empty if unknown
+    QString mwc713Account;
+    int accountSwitchesInFlight = 0; // Switches that are written, but their result is not known yet
+    int64_t elidedAccountSwitches = 0;
+
+    // Balance refresh is multistep, see updateWalletBalance. Slates can come in bursts, every one requests the refresh.
+    enum class BALANCE_REFRESH {IDLE, QUEUED, RUNNING};
+    BALANCE_REFRESH balanceRefresh = BALANCE_REFRESH::IDLE;
+    bool balanceRefreshFollowUp = false; // Refresh was requested while running
+    int64_t coalescedBalanceRefreshes = 0;
+
+    // Persistent, saved into the app context at stop
+    TaskLatencyStats taskLatency;
+    // For the app session
+    TaskTimingStats taskTiming;
+    // Transactions that was read from mwc713, saved at stop
+    TransactionCache txCache;
+    // Outputs that was read, for diff feed to the views
+    UtxoCache utxoCache;
+    // History search, created with the first query
+    TransactionQueryThread * queryThread = nullptr;
+    // Transactions revision that the query thread has for the account
+    QMap<QString, int64_t> queryRevisionSent;
 private:
     // Temprary values, local values for states
     QString walletPassword;
 
     QVector<AccountInfo> collectedAccountInfo;
 
-    QVector<WalletTransaction> collectedTransactions;
+    QStringList collectedTransactionAccounts; // accounts that was read by getAllTransactions
 
     int64_t walletStartTime = 0;
     QString commandLine;
@@ -14,71 +14,44 @@
 
 #include "mwc713events.h"
 #include "mwc713.h"
-#include "../tries/mwc713inputparser.h"
+#include "mwc713parserthread.h"
 #include "mwc713task.h"
+#include "tasklatency.h"
 #include <QDateTime>
+#include <QTimer>
+#include <QTimerEvent>
+#include <algorithm>
+#include <climits>
 #include "../util/Log.h"
+#include "../util/Trace.h"
 #include "../core/Config.h"
 #include "../core/Notification.h"
 #include "../control/messagebox.h"
 
 namespace wallet {
 
+// Max number of events that are processed in a single event loop iteration
+const int EVENTS_DRAIN_SLICE = 1000;
+// Max number of commands that are written into mwc713 and waiting for the result
+const int PIPELINE_DEPTH = 8;
 
-QString toString(WALLET_EVENTS event) {
-    switch (event) {
-        case S_READY:           return "S_READY";
-        case S_WELCOME:         return "S_WELCOME";
-        case S_INIT:            return "S_INIT";
-        case S_PASSWORD_ERROR:  return "S_PASSWORD_ERROR";
-        case S_NEED2UNLOCK:     return "S_NEED2UNLOCK";
-        case S_MWC_MQ_LISTENER: return "S_MWC_MQ_LISTENER";
-        case S_GENERIC_ERROR:   return "S_GENERIC_ERROR";
-        case S_YOUR_MWC_ADDRESS:return "S_YOUR_MWC_ADDRESS";
-        case S_MWC_ADDRESS_INDEX:return "S_MWC_ADDRESS_INDEX";
-        case S_INIT_WANT_ENTER: return "S_INIT_WANT_ENTER";
-        case S_ERROR:           return "S_ERROR";
-        case S_LINE:            return "S_LINE";
-
-        case S_LISTENER_MQ_STARTING: return "S_LISTENER_MQ_STARTING";
-        case S_LISTENER_KB_STARTING: return "S_LISTENER_KB_STARTING";
-        case S_LISTENER_ON:  return "S_LISTENER_ON";
-        case S_LISTENER_MQ_STOPPING: return "S_LISTENER_MQ_STOPPING";
-        case S_LISTENER_KB_STOPPING: return "S_LISTENER_KB_STOPPING";
-        case S_LISTENER_OFF: return "S_LISTENER_OFF";
-        case S_RECOVERY_STARTING: return "S_RECOVERY_STARTING";
-        case S_RECOVERY_DONE:   return "S_RECOVERY_DONE";
-        case S_RECOVERY_PROGRESS: return "S_RECOVERY_PROGRESS";
-        case S_RECOVERY_MNEMONIC: return "S_RECOVERY_MNEMONIC";
-
-        case S_GENERIC_WARNING: return "S_GENERIC_WARNING";
-        case S_GENERIC_INFO:    return "S_GENERIC_INFO";
-
-        case S_LISTENER_MQ_LOST_CONNECTION:  return "S_LISTENER_MQ_LOST_CONNECTION";
-        case S_LISTENER_MQ_GET_CONNECTION:   return "S_LISTENER_MQ_GET_CONNECTION";
-        case S_LISTENER_MQ_COLLISION:        return "S_LISTENER_MQ_COLLISION";
-        case S_LISTENER_MQ_FAILED_TO_START:  return "S_LISTENER_MQ_FAILED_TO_START";
-
-        case S_LISTENER_KB_LOST_CONNECTION:  return "S_LISTENER_KB_LOST_CONNECTION";
-        case S_LISTENER_KB_GET_CONNECTION:   return "S_LISTENER_KB_GET_CONNECTION";
-
-        case S_ACCOUNTS_INFO_SUM: return "S_ACCOUNTS_INFO_SUM";
-
-        case S_SLATE_WAS_SENT_TO:    return "S_SLATE_WAS_SENT_TO";
-        case S_SLATE_WAS_SENT_BACK: return "S_SLATE_WAS_SENT_BACK";
-        case S_SLATE_WAS_RECEIVED_BACK: return "S_SLATE_WAS_RECEIVED_BACK";
-        case S_SLATE_WAS_RECEIVED_FROM: return "S_SLATE_WAS_RECEIVED_FROM";
-        case S_SLATE_WAS_FINALIZED: return "S_SLATE_WAS_FINALIZED";
-        case S_SET_RECEIVE:         return "S_SET_RECEIVE";
-
-        case S_TRANSACTION_LOG:     return "S_TRANSACTION_LOG";
-        case S_OUTPUT_LOG:          return "S_OUTPUT_LOG";
+taskInfo::taskInfo(Mwc713Task* _task, int _timeout) :
+    task(_task), timeout(_timeout), readyEvents(_task->getReadyEvents()),
+    pipelinable(_task->isPipelinable() && _task->hasInput()),
+    dedupKey(_task->getTaskName() + '\n' + _task->getInputStr()),
+    latencyKey(TaskLatencyStats::getKey(_task))
+{
+}
 
+QString toString(TASK_PRIORITY priority) {
+    switch (priority) {
+        case TASK_PRIORITY::INTERACTIVE: return "INTERACTIVE";
+        case TASK_PRIORITY::USER_WRITE:  return "USER_WRITE";
+        case TASK_PRIORITY::BACKGROUND:  return "BACKGROUND";
         default: Q_ASSERT(false); return "Unknown";
     }
 }
 
-
 Mwc713EventManager::Mwc713EventManager(MWC713 * _mwc713wallet) : mwc713wallet(_mwc713wallet) , taskQMutex(QMutex::Recursive)
 {
 }
@@ -97,16 +70,46 @@ void Mwc713EventManager::clear() {
         delete t.task;
     }
     taskQ.clear();
+    for (auto t : groupTasks) {
+        delete t.task;
+    }
+    groupTasks.clear();
+    groupDepth = 0;
+    queuedTaskKeys.clear();
     events.clear();
-    taskExecutionTimeLimit = 0;
+    drainBatch.clear();
+    drainPos = 0;
+    setDeadline(0);
+    timeoutTask = nullptr;
+
+    for (int p=0; p<TASK_PRIORITY_NUM; p++) {
+        const QueueWaitStats & ws = waitStats[p];
+        if (ws.tasks>0) {
+            logger::logInfo("Mwc713EventManager", "Queue wait for " + toString(TASK_PRIORITY(p)) + " tasks: " + QString::number(ws.tasks) +
+                            ", average " + QString::number(ws.totalMs / ws.tasks) + " ms, max " + QString::number(ws.maxMs) + " ms");
+        }
+        waitStats[p] = QueueWaitStats();
+    }
+    if (coalescedTasks>0)
+        logger::logInfo("Mwc713EventManager", "Tasks merged with the queued ones: " + QString::number(coalescedTasks));
+    coalescedTasks = 0;
+    if (mwc713wallet && mwc713wallet->getElidedAccountSwitches()>0)
+        logger::logInfo("Mwc713EventManager", "Account switches skipped since the start: " + QString::number(mwc713wallet->getElidedAccountSwitches()));
+
+    // Parser thread will be deleted, not events any more
+    if (parserThread) {
+        disconnect(parserThread, nullptr, this, nullptr);
+        parserThread = nullptr;
+    }
 }
 
-void Mwc713EventManager::connectWith(tries::Mwc713InputParser * inputParser) {
-    const bool connected = connect(inputParser, &tries::Mwc713InputParser::sgGenericEvent, this, &wallet::Mwc713EventManager::slReceiveEvent,Qt::QueuedConnection );
+void Mwc713EventManager::connectWith(Mwc713ParserThread * _parserThread) {
+    Q_ASSERT(parserThread == nullptr);
+    parserThread = _parserThread;
+    const bool connected = connect(parserThread, &Mwc713ParserThread::sgEventsReady, this, &wallet::Mwc713EventManager::slDrainEvents, Qt::QueuedConnection );
     Q_ASSERT(connected);
     Q_UNUSED(connected);
 
-    startTimer(500); // timeout checking. Twice a second is good enough for us
 }
 
 // Add task (single wallet action) to perform.
@@ -117,33 +120,114 @@ bool Mwc713EventManager::addTask( Mwc713Task * task, int64_t timeout, bool cance
 
     QMutexLocker l( &taskQMutex );
 
-    // check if task is already in the Q.
-    bool found = false;
-    if (cancelIfExist) {
+    // timeout multiplier will be applyed to the task because we want apply this value as late as posiible.
+    // User might change it at any moment.
+    taskInfo ti(task,timeout);
+
+    // check if task is already in the Q. The queued one will do the job and notify about the result
+    if (cancelIfExist && queuedTaskKeys.value(ti.dedupKey) > 0) {
+        coalescedTasks++;
+        qDebug() << "Task " << task->getTaskName() << " is merged with the queued one, total merged: " << coalescedTasks;
+        delete task;
+        return false;
+    }
+
+    const bool singleTask = groupDepth==0;
+    if (singleTask)
+        beginTaskGroup(TASK_PRIORITY::USER_WRITE);
+
+    ti.groupId = groupId;
+    ti.priority = groupPriority;
+    ti.supersedeKey = groupKey;
+    ti.queuedTime = QDateTime::currentMSecsSinceEpoch();
+    task->getTimeline().enqueued = TaskTimeline::now();
+    groupTasks.push_back(ti);
+    indexTask(ti);
+
+    if (singleTask)
+        endTaskGroup();
+
+    return true;
+}
+
+int64_t Mwc713EventManager::beginTaskGroup(TASK_PRIORITY priority, const QString & supersedeKey) {
+    QMutexLocker l( &taskQMutex );
+
+    if (groupDepth++ > 0)
+        return groupId;
+
+    groupId = ++lastGroupId;
+    groupPriority = priority;
+    groupKey = supersedeKey;
+
+    // Newer request replace the older one. Cancel before the tasks are added, so they will not be deduplicated with cancelled ones.
+    if (!supersedeKey.isEmpty()) {
+        QSet<int64_t> superseded;
         for ( const taskInfo & ti : taskQ ) {
-            if (ti.task->getTaskName() == task->getTaskName() && ti.task->getInputStr() == task->getInputStr()) {
-                found = true;
-                break;
-            }
+            if (ti.supersedeKey == supersedeKey)
+                superseded.insert(ti.groupId);
         }
+        for (int64_t id : superseded)
+            removeGroupTasks(id);
     }
 
-    if (found) {
-        // not execute the task, it is already in the Q
-        delete task;
-        return false;
+    return groupId;
+}
+
+void Mwc713EventManager::endTaskGroup() {
+    QMutexLocker l( &taskQMutex );
+
+    Q_ASSERT(groupDepth>0);
+    if (--groupDepth > 0 || groupTasks.isEmpty())
+        return;
+
+    // Skipping the queued groups with lower priority. Started group can't be moved
+    int pos = taskQ.size();
+    while (pos>0) {
+        const taskInfo & prev = taskQ[pos-1];
+        if (prev.priority <= groupPriority)
+            break;
+
+        int start = pos;
+        bool started = false;
+        while (start>0 && taskQ[start-1].groupId == prev.groupId) {
+            start--;
+            started = started || taskQ[start].wasProcessed;
+        }
+        if (started)
+            break;
+        pos = start;
     }
 
-    // timeout multiplier will be applyed to the task because we want apply this value as late as posiible.
-    // User might change it at any moment.
-    taskQ.push_back(taskInfo(task,timeout));
+    for (int i=0; i<groupTasks.size(); i++)
+        taskQ.insert(pos+i, groupTasks[i]);
+    groupTasks.clear();
+
     processNextTask();
 
-    if (taskExecutionTimeLimit==0) {
-         taskExecutionTimeLimit = QDateTime::currentMSecsSinceEpoch() + (int64_t)(timeout * config::getTimeoutMultiplier());
+    if (taskExecutionTimeLimit==0 && !taskQ.isEmpty()) {
+        startDeadline(taskQ.front());
     }
+}
 
-    return true;
+bool Mwc713EventManager::cancelTaskGroup(int64_t id) {
+    QMutexLocker l( &taskQMutex );
+    return removeGroupTasks(id) > 0;
+}
+
+// Started tasks are waiting for mwc713 output, they can't be cancelled
+int Mwc713EventManager::removeGroupTasks(int64_t id) {
+    int removed = 0;
+    for (int i=taskQ.size()-1; i>=0; i--) {
+        if (taskQ[i].groupId == id && !taskQ[i].wasProcessed) {
+            logger::logTask( "Mwc713EventManager", taskQ[i].task, "Cancelled" );
+            unindexTask(taskQ[i]);
+            delete taskQ[i].task;
+            taskQ.remove(i);
+            removed++;
+        }
+    }
+    return removed;
 }
 
 // Process next task
@@ -155,34 +239,150 @@ void Mwc713EventManager::processNextTask() {
 
     // Check if we can perform the first task
     taskInfo & task = taskQ.front();
+    const bool waitForEvents = task.timeout > 0;
     if (!task.wasProcessed) {
 
         events.clear();
+        startTask(task);
+
+        if (waitForEvents && !task.skipped) {
+            startDeadline(task);
+        }
+    }
+
+    if (!waitForEvents || task.skipped) {
+        // execute the task now. Next task will be started
+        executeTask(takeFirstTask());
+        return;
+    }
 
-        qDebug() << "Executing the task: " + task.task->toDbgString();
-        task.wasProcessed = true; // reset state first, then process
+    pipelineTasks();
+}
 
-        logger::logTask( "Mwc713EventManager", task.task, "Starting..." );
-        task.task->onStarted();
+void Mwc713EventManager::startTask(taskInfo & task) {
+    qDebug() << "Executing the task: " + task.task->toDbgString();
+    task.wasProcessed = true; // reset state first, then process
+
+    const int64_t waitMs = QDateTime::currentMSecsSinceEpoch() - task.queuedTime;
+    QueueWaitStats & ws = waitStats[int(task.priority)];
+    ws.tasks++;
+    ws.totalMs += waitMs;
+    ws.maxMs = std::max(ws.maxMs, waitMs);
+
+    const bool hasCommand = task.timeout > 0 && task.task->hasInput();
+    task.skipped = hasCommand && task.task->canSkip();
+
+    logger::logTask( "Mwc713EventManager", task.task, QString(task.skipped ? "Skipping" : "Starting...") +
+                     " " + toString(task.priority) + ", waited in the queue " + QString::number(waitMs) + " ms" );
+    task.task->onStarted();
+
+    // schedule the task for execution
+    if (hasCommand && !task.skipped) {
+        // Commands that can't be pipelined might change the wallet state
+        if (!task.pipelinable)
+            mwc713wallet->resetMwc713Account();
+        mwc713wallet->executeMwc713command(task.task->getInputStr(), task.task->getShadowStr());
+        task.task->getTimeline().written = TaskTimeline::now();
+    }
+}
 
-        if (task.timeout > 0) {
-            // schedule the task for execution
-            if (!task.task->getInputStr().isEmpty()) {
-                mwc713wallet->executeMwc713command(task.task->getInputStr(), task.task->getShadowStr());
-            }
-            taskExecutionTimeLimit = QDateTime::currentMSecsSinceEpoch() +  (int64_t)(task.timeout * config::getTimeoutMultiplier());
-        }
-        else {
-            // execute the task now. Next task will be started
-            executeTask(taskQ.takeFirst());
+// mwc713 reads the commands one by one and prints the prompt after every one. So the commands
+// can be written ahead, the events are still attributed to the tasks by the ready events of
+// the current one. Pipelining stops at the first task that can't be pipelined, it has to wait
+// until everything before it is done.
+void Mwc713EventManager::pipelineTasks() {
+    int inFlight = 0;
+    for ( taskInfo & ti : taskQ ) {
+        // Callbacks don't talk to mwc713, they will be executed when become current
+        if (ti.timeout <= 0)
+            continue;
+
+        if (!ti.pipelinable)
+            return;
+
+        if (!ti.wasProcessed) {
+            if (inFlight >= PIPELINE_DEPTH)
+                return;
+            startTask(ti);
         }
+        // Skipped tasks don't wait for mwc713, they will be executed when become current
+        if (!ti.skipped)
+            inFlight++;
     }
 }
 
+void Mwc713EventManager::indexTask(const taskInfo & task) {
+    queuedTaskKeys[task.dedupKey]++;
+}
+
+void Mwc713EventManager::unindexTask(const taskInfo & task) {
+    auto it = queuedTaskKeys.find(task.dedupKey);
+    Q_ASSERT(it != queuedTaskKeys.end() && it.value()>0);
+    if (it == queuedTaskKeys.end())
+        return;
+    if (--it.value() <= 0)
+        queuedTaskKeys.erase(it);
+}
+
+// Executing task is not in the index any more, so it can add the same task again
+taskInfo Mwc713EventManager::takeFirstTask() {
+    taskInfo task = taskQ.takeFirst();
+    unindexTask(task);
+    return task;
+}
+
+// timeout multiplier is applied here because we want apply this value as late as posiible.
+// User might change it at any moment.
+void Mwc713EventManager::startDeadline(taskInfo & task) {
+    // Launch can be postponed until the previous process exits, that time doesn't count
+    if (!mwc713wallet->isMwc713processStarted())
+        return;
+
+    const int64_t now = QDateTime::currentMSecsSinceEpoch();
+    // Restarted deadline (user agreed to wait) is not a restart of the execution
+    if (task.runningSince == 0)
+        task.runningSince = now;
+
+    const int64_t timeout = mwc713wallet->getTaskLatency().getTimeout(task.latencyKey, task.timeout);
+    setDeadline( now + (int64_t)(timeout * config::getTimeoutMultiplier()) );
+}
+
+// There is a single deadline, for the current task. Timer is armed for it, no wake ups when nothing is running
+void Mwc713EventManager::setDeadline(int64_t timeLimit) {
+    taskExecutionTimeLimit = timeLimit;
+
+    if (deadlineTimerId != 0) {
+        killTimer(deadlineTimerId);
+        deadlineTimerId = 0;
+    }
+
+    if (timeLimit == 0)
+        return;
+
+    const qint64 delay = std::max( qint64(0), qint64(timeLimit) - QDateTime::currentMSecsSinceEpoch() );
+    deadlineTimerId = startTimer( int(std::min( delay, qint64(INT_MAX) )) );
+}
+
+void Mwc713EventManager::onProcessStarted() {
+    QMutexLocker l( &taskQMutex );
+    if (taskExecutionTimeLimit!=0 || taskQ.isEmpty())
+        return;
+
+    taskInfo & task = taskQ.front();
+    if (task.wasProcessed && task.timeout > 0 && !task.skipped)
+        startDeadline(task);
+}
+
 void Mwc713EventManager::timerEvent(QTimerEvent *event) {
     QMutexLocker l( &taskQMutex );
 
-    Q_UNUSED(event);
+    if (event->timerId() != deadlineTimerId)
+        return;
+
+    // Single shot
+    killTimer(deadlineTimerId);
+    deadlineTimerId = 0;
+
     if (taskExecutionTimeLimit==0)
         return;
 
@@ -193,75 +393,208 @@ void Mwc713EventManager::timerEvent(QTimerEvent *event) {
         return;
     }
 
-    /*if (QDateTime::currentMSecsSinceEpoch() > taskExecutionTimeLimit/2) {
-        mwc713wallet->executeMwc713command("");
-    }*/
+    // Timer can fire a bit earlier
+    if (QDateTime::currentMSecsSinceEpoch() < taskExecutionTimeLimit) {
+        setDeadline(taskExecutionTimeLimit);
+        return;
+    }
 
-    QString taskName = taskQ.front().task->getTaskName();
+    // The task is not cancelled while the user is deciding. Its output is still processed, queue is moving.
+    taskExecutionTimeLimit = 0;
+    if (timeoutPromptActive)
+        return; // User is answering for the previous one. Deadline will be restarted after that
 
-    if (QDateTime::currentMSecsSinceEpoch() > taskExecutionTimeLimit) {
+    timeoutPromptActive = true;
+    timeoutTask = taskQ.front().task;
+    notify::appendNotificationMessage( notify::MESSAGE_LEVEL::WARNING,
+            "mwc713 command execution is taking longer than expected for the task '" + timeoutTask->getTaskName() + "'" );
 
-        if (control::MessageBox::questionText(nullptr, "Warning", "mwc713 command execution is taking longer than expected.\nContinue to wait?",
-                                          "Yes", "No", true, false) == control::MessageBox::RETURN_CODE::BTN1) {
-            config::increaseTimeoutMultiplier();
-            // Update the waiting time
+    // Asking outside of the timer and mutex, the dialog has its own event loop
+    QMetaObject::invokeMethod(this, "slTaskTimeout", Qt::QueuedConnection);
+}
 
-            if (!taskQ.isEmpty())
-                taskExecutionTimeLimit = QDateTime::currentMSecsSinceEpoch() +  (int64_t)(taskQ.front().timeout * config::getTimeoutMultiplier());
-            return;
-        }
+void Mwc713EventManager::slTaskTimeout() {
+    // Task might be done before we get here
+    const QString taskName = timeoutTask ? timeoutTask->getTaskName() : "";
 
-        // report timeout error. Do it once
-        taskExecutionTimeLimit = 0;
-        notify::appendNotificationMessage( notify::MESSAGE_LEVEL::FATAL_ERROR,
-                "mwc713 unable to process the task '" + taskName + "'" );
+    const bool wait = !taskName.isEmpty() &&
+            control::MessageBox::questionText(nullptr, "Warning", "mwc713 command execution is taking longer than expected.\nContinue to wait?",
+                                      "Yes", "No", true, false) == control::MessageBox::RETURN_CODE::BTN1;
+
+    QMutexLocker l( &taskQMutex );
+
+    // Task might finish while the user was thinking, the answer is not needed any more
+    const bool stillRunning = timeoutTask != nullptr;
+    timeoutTask = nullptr;
+    timeoutPromptActive = false;
+
+    // Late 'Yes' for the finished task doesn't mean that the timeouts are too short
+    if (wait && stillRunning)
+        config::increaseTimeoutMultiplier();
+
+    if (wait || !stillRunning) {
+        // Update the waiting time. Deadlines of the current task was ignored during the dialog
+        if (!taskQ.isEmpty() && taskQ.front().wasProcessed && taskQ.front().timeout > 0)
+            startDeadline(taskQ.front());
+        return;
     }
+
+    // report timeout error. Do it once
+    notify::appendNotificationMessage( notify::MESSAGE_LEVEL::FATAL_ERROR,
+            "mwc713 unable to process the task '" + taskName + "'" );
 }
 
 
-// Events receiver
-void Mwc713EventManager::slReceiveEvent( WALLET_EVENTS event, QString message) {
+void Mwc713EventManager::slDrainEvents() {
+    trace::Scope traceScope("mwc713", "drainEvents");
+    int processed = 0;
+    // Note, parserThread can be reset during event processing
+    while ( parserThread && processed < EVENTS_DRAIN_SLICE ) {
+        if (drainPos >= drainBatch.size()) {
+            drainPos = 0;
+            if (!parserThread->popEvents(drainBatch)) {
+                drainBatch.clear();
+                break;
+            }
+        }
+
+        int len = std::min( drainBatch.size() - drainPos, EVENTS_DRAIN_SLICE - processed );
+        // Holding the batch data, processEvents can clear the manager
+        QVector<WEvent> batch = drainBatch;
+        drainPos += len;
+        processed += len;
+        processEvents( WEventSpan(batch).mid(drainPos - len, len) );
+    }
 
-    // Preprocess event with listeners
-    {
-        QVector<WEvent> evt;
-        evt.push_back(WEvent(event, message));
+    if (traceScope.isActive())
+        traceScope.setArgs( trace::arg("events", processed) );
+
+    if (parserThread == nullptr)
+        return;
+
+    // Let GUI process other events, then continue
+    if ( processed == EVENTS_DRAIN_SLICE || parserThread->finishDrain() )
+        QMetaObject::invokeMethod(this, "slDrainEvents", Qt::QueuedConnection);
+}
 
-        for (Mwc713Task *t : listeners) {
-            if (t->processTask(evt)) {
-                qDebug() << "Mwc713EventManager::sReceiveEvent was preprocessed. event=" << event << " msg='" << message
-                         << "'";
+void routeEvents(WEventSpan evts, WEventRouter & router) {
+    int listened = 0; // events before that are processed by listeners
+    int pos = 0;
+
+    WEventSet ready;
+    while (pos < evts.size()) {
+        // Listeners and the task see the same events order as before: the task is executed
+        // right after listeners processed its ready event.
+        const bool hasTask = router.getTaskReadyEvents(ready);
+        int end = evts.size();
+        if (hasTask) {
+            for (int i = pos; i < end; i++) {
+                if (ready.contains(evts[i].event)) {
+                    end = i+1;
+                    break;
+                }
             }
         }
+
+        if (end > listened) {
+            router.listenEvents( evts.mid(listened, end-listened) );
+            listened = end;
+        }
+
+        // Listeners might add the tasks. Task that was added now wasn't waiting for [pos,end) events,
+        // they was printed before its command. Such task will get the next events only.
+        if (!hasTask || !router.getTaskReadyEvents(ready)) {
+            pos = end;
+            continue;
+        }
+
+        while (pos < end) {
+            const WEvent & evt = evts[pos++];
+            const bool isReady = ready.contains(evt.event);
+            router.taskEvent(evt, isReady);
+            if (isReady)
+                break;
+        }
     }
+}
 
-    QMutexLocker l( &taskQMutex );
+void Mwc713EventManager::processEvents(WEventSpan evts) {
+    routeEvents(evts, *this);
+}
 
+bool Mwc713EventManager::getTaskReadyEvents(WEventSet & ready) {
+    QMutexLocker l( &taskQMutex );
     if (taskQ.isEmpty())
-        return;
+        return false;
+    ready = taskQ.front().readyEvents;
+    return true;
+}
+
+void Mwc713EventManager::listenEvents(WEventSpan evts) {
+    for (Mwc713Listener *t : listeners) {
+        t->processEvents(evts);
+    }
+}
 
-    events.push_back(WEvent(event, message));
-    qDebug() << "Mwc713EventManager::sReceiveEvent adding Event into the list. event=" << event << " msg='"
-             << message << "'  New size:" << events.size();
+void Mwc713EventManager::taskEvent(const WEvent & evt, bool ready) {
+    QMutexLocker l( &taskQMutex );
+    Q_ASSERT(!taskQ.isEmpty());
+    Mwc713Task * task = taskQ.front().task;
 
+    TaskTimeline & timeline = task->getTimeline();
+    if (timeline.firstOutput == 0)
+        timeline.firstOutput = evt.outputTime>0 ? evt.outputTime : TaskTimeline::now();
 
-    if (!taskQ.front().task->getReadyEvents().contains(event))
-        return; // still waiting for events
+    if (ready || !task->processStreamEvent(evt))
+        events.push_back(evt);
 
-    executeTask(taskQ.takeFirst());
+    if (ready) {
+        timeline.ready = TaskTimeline::now();
+        executeTask(takeFirstTask());
+    }
 }
 
 void Mwc713EventManager::executeTask(taskInfo task) {
     // Got the acceptable final event
-    taskExecutionTimeLimit = 0; // stopping timeout
+    setDeadline(0); // stopping timeout
     qDebug() << "Processing task '" << task.task->getTaskName() << "'";
 
     logger::logTask("Mwc713EventManager", task.task, "Executing");
 
+    if (task.runningSince > 0)
+        mwc713wallet->getTaskLatency().addSample( task.latencyKey, QDateTime::currentMSecsSinceEpoch() - task.runningSince );
+
+    TaskTimeline & timeline = task.task->getTimeline();
+    timeline.processStart = TaskTimeline::now();
     task.task->processTask(events);
+    timeline.processEnd = TaskTimeline::now();
+
+    // Queued signals that processTask emitted are delivered before this call
+    const QString taskName = task.task->getTaskName();
+    MWC713 * wallet = mwc713wallet;
+    const int64_t traceId = ++lastTraceId;
+    if (trace::isEnabled())
+        trace::complete("mwc713", taskName + " process", timeline.processStart, timeline.processEnd - timeline.processStart);
+    QTimer::singleShot(0, this, [wallet, taskName, timeline, traceId]() mutable {
+        timeline.delivered = TaskTimeline::now();
+        wallet->getTaskTiming().addTimeline(taskName, timeline);
+
+        if (trace::isEnabled() && timeline.enqueued>0) {
+            trace::asyncSpan("mwc713", taskName, traceId, timeline.enqueued, timeline.delivered,
+                    trace::arg("written", timeline.written) + "," + trace::arg("firstOutput", timeline.firstOutput) + "," +
+                    trace::arg("ready", timeline.ready) + "," + trace::arg("processEnd", timeline.processEnd) );
+        }
+    });
+
     events.clear();
+    if (task.task == timeoutTask)
+        timeoutTask = nullptr;
     delete task.task;
 
+    // The command of the next task might be already written, its time is starting now
+    if (!taskQ.isEmpty() && taskQ.front().wasProcessed && taskQ.front().timeout > 0)
+        startDeadline(taskQ.front());
+
     processNextTask();
 }
 
@@ -19,15 +19,15 @@
 #include <QVector>
 #include <QObject>
 #include <QMutex>
-
-namespace tries {
-    class Mwc713InputParser;
-}
+#include <QSet>
+#include <QHash>
 
 namespace wallet {
 
 class Mwc713Task;
+class Mwc713Listener;
 class MWC713;
+class Mwc713ParserThread;
 
 // Wallet event codes
 enum WALLET_EVENTS {
@@ -91,36 +91,138 @@ enum WALLET_EVENTS {
 };
 QString toString(WALLET_EVENTS event);
 
+// Scheduling class of the tasks. Tasks are placed before queued tasks with lower priority.
+enum class TASK_PRIORITY {
+    INTERACTIVE = 0, // User is waiting for the data. Example: transactions page
+    USER_WRITE  = 1, // Action initiated by user. Example: send, account create. Default for tasks without a group
+    BACKGROUND  = 2  // Refresh that nobody is waiting for. Example: balance update, node info
+};
+const int TASK_PRIORITY_NUM = 3;
+QString toString(TASK_PRIORITY priority);
+
 // Timeout values for the Tasks
 const int TASK_STARTING_TO = 5000;
 const int TASK_UNLOCK_TO = 3000;
 
+// Captured section of the event line
+struct WEventParam {
+    QString str;
+    qint64  number = -1; // str value if it is a non negative integer, otherwise -1
+
+    WEventParam() = default;
+    WEventParam(const QString & _str, qint64 _number) : str(_str), number(_number) {}
+};
+
 struct WEvent {
     WALLET_EVENTS event;
-    QString message;
+    QString message; // The first captured section. Most of events have a single one
+    qint64  number = -1; // message value if it is a non negative integer, otherwise -1
+    QVector<WEventParam> extraParams; // Captured sections after the first one
+    int64_t outputTime = 0; // TaskTimeline::now() when mwc713 output with the event was read. 0 if not known
 
     WEvent(WALLET_EVENTS _event) : event(_event) {}
-    WEvent(WALLET_EVENTS _event, QString _message) : event(_event), message(_message) {}
+    WEvent(WALLET_EVENTS _event, QString _message) : event(_event) { addParam(_message); }
 
     WEvent() = default;
     WEvent(const WEvent &) = default;
     WEvent & operator = (const WEvent &) = default;
+
+    // Append the next captured section. Numbers are converted here, once per event
+    void addParam(const QString & str);
+
+    // Captured sections in order as they are in the line
+    int getParamsNumber() const {return paramsNumber;}
+    // Empty string if section doesn't exist
+    const QString & getParam(int idx) const;
+    // -1 if section doesn't exist or it is not a number
+    qint64 getNumber(int idx) const;
+
+    // Params joined with '|'. For logs and debug output only
+    QString printParams() const;
+private:
+    int paramsNumber = 0;
+};
+
+// Non owning view of contiguous events. Valid while the events source is alive.
+class WEventSpan {
+public:
+    WEventSpan() = default;
+    WEventSpan(const WEvent * _data, int _size) : data(_data), sz(_size) {}
+    WEventSpan(const QVector<WEvent> & events) : data(events.constData()), sz(events.size()) {}
+
+    int size() const {return sz;}
+    bool isEmpty() const {return sz==0;}
+    const WEvent & operator[](int idx) const { Q_ASSERT(idx>=0 && idx<sz); return data[idx]; }
+
+    const WEvent * begin() const {return data;}
+    const WEvent * end() const {return data+sz;}
+
+    WEventSpan mid(int pos, int len) const { Q_ASSERT(pos>=0 && len>=0 && pos+len<=sz); return WEventSpan(data+pos, len); }
+private:
+    const WEvent * data = nullptr;
+    int sz = 0;
+};
+
+// Set of events as a bitmask. WALLET_EVENTS codes are small numbers, so it is cheap to check
+class WEventSet {
+public:
+    WEventSet() = default;
+    WEventSet(const QSet<WALLET_EVENTS> & events);
+
+    void insert(WALLET_EVENTS event);
+    bool contains(WALLET_EVENTS event) const {
+        uint e = uint(event);
+        return e < MAX_EVENT && (bits[e/64] & (quint64(1) << (e%64))) != 0;
+    }
+    bool isEmpty() const {return bits[0]==0 && bits[1]==0;}
+
+private:
+    static const uint MAX_EVENT = 128;
+    quint64 bits[MAX_EVENT/64] = {0,0};
 };
 
+// Destination of the events, see routeEvents. Implemented by Mwc713EventManager.
+class WEventRouter {
+public:
+    virtual ~WEventRouter() {}
+
+    // Ready events of the current task. Return false if there is no task that is waiting for the events
+    virtual bool getTaskReadyEvents(WEventSet & ready) = 0;
+    // Events for all listeners
+    virtual void listenEvents(WEventSpan events) = 0;
+    // Event for the current task. ready - it is the task ready event, task must be executed now
+    virtual void taskEvent(const WEvent & evt, bool ready) = 0;
+};
+
+// Route events in order as mwc713 printed them. Listeners get the whole batch, the current task gets
+// events until its ready event and it is executed right after listeners processed that event.
+// Task that listeners add gets only the events that come after it was added.
+void routeEvents(WEventSpan evts, WEventRouter & router);
+
 struct taskInfo {
     Mwc713Task* task = nullptr; // task
-    bool        wasProcessed = false;
+    bool        wasProcessed = false; // Task was started, its command was written into mwc713
     int         timeout = -1; // timeout for this task
+    WEventSet   readyEvents; // task->getReadyEvents(), calculated once
+    bool        pipelinable = false; // command can be written before the previous one is done
+    bool        skipped = false; // Task was started without writing the command, see Mwc713Task::canSkip
+    int64_t     groupId = 0; // Tasks with the same group are executed in order, other tasks can't get in between
+    TASK_PRIORITY priority = TASK_PRIORITY::USER_WRITE;
+    QString     supersedeKey; // Newer group with the same key cancels this one if it is not started
+    int64_t     queuedTime = 0; // Time when task was added, ms
+    QString     dedupKey; // Task name and input, the same key means the same command
+    QString     latencyKey; // Key for the execution time statistic, see TaskLatencyStats
+    int64_t     runningSince = 0; // Time when task become current and its deadline started, ms
 
     taskInfo() = default;
-    taskInfo(Mwc713Task* _task, int _timeout) : task(_task), timeout(_timeout) {}
+    taskInfo(Mwc713Task* _task, int _timeout);
     taskInfo(const taskInfo&) = default;
     taskInfo & operator=(const taskInfo&) = default;
 };
 
 // Aggregator for Wallet events. Expected that there are not many events are aggregating.
-// That is whay we are not maintaining any indexes.
-class Mwc713EventManager : public QObject
+// Queued tasks are indexed by the command, background refreshes can add the same task often.
+class Mwc713EventManager : public QObject, private WEventRouter
 {
     Q_OBJECT
 public:
@@ -129,16 +231,33 @@ public:
     Mwc713EventManager(const Mwc713EventManager & ) = delete;
     Mwc713EventManager & operator=(const Mwc713EventManager & ) = delete;
 
-    void connectWith(tries::Mwc713InputParser * inputParser);
+    // Events source. Events are pulled from the parser thread queue by slices
+    void connectWith(Mwc713ParserThread * parserThread);
 
-    void addListener(Mwc713Task* task) { listeners.push_back(task);}
+    void addListener(Mwc713Listener* task) { listeners.push_back(task);}
 
     // Add task (single wallet action) to perform.
     // This tale ownership of object
     // Note:  if timeout <= 0, task will be executed immediately
+    // cancelIfExist - the same task (name and input) that is queued or running absorbs this one.
     // Return: true if task was added.  False - was ignored
     bool addTask( Mwc713Task * task, int64_t timeout, bool cancelIfExist = true );
 
+    // Tasks that are added between beginTaskGroup and endTaskGroup are scheduled together: they are executed
+    // in order and other tasks can't get in between. Task that is added outside of a group makes a group
+    // by itself with USER_WRITE priority. Nested groups are a part of the outer one.
+    // supersedeKey - if not empty, queued groups with the same key that are not started yet are cancelled.
+    // Return: group id that can be used to cancel the group
+    int64_t beginTaskGroup(TASK_PRIORITY priority, const QString & supersedeKey = "");
+    void endTaskGroup();
+
+    // Cancel the group tasks that are not started yet.
+    // Return: true if anything was cancelled
+    bool cancelTaskGroup(int64_t groupId);
+
+    // mwc713 process is started, the current task deadline is counted from now
+    void onProcessStarted();
+
 //    void addEvent(WALLET_EVENTS event) { events.push_back(WEvent(event)); }
   //  void addEvent(WALLET_EVENTS event, QString message) { events.push_back(WEvent(event, message)); }
 //    void reset() { events.clear(); }
@@ -147,35 +266,98 @@ public:
 
     // clean all tasks, events and all
     void clear();
+
+    // Process events in order as mwc713 printed them. Listeners get the whole batch,
+    // the current task get events until its ready event.
+    void processEvents(WEventSpan evts);
+
 public slots:
-    void slReceiveEvent( WALLET_EVENTS event, QString message); // message is optional
+    // Process ready events from the parser thread. Process limited number of events
+    // and reschedule itself, so GUI stay responsive with a large mwc713 output.
+    void slDrainEvents();
+
+    // Ask user what to do with the task that is running too long
+    void slTaskTimeout();
 
 private:
-    // timer that we are using for timeouts
+    // Single shot timer for the current task deadline
     virtual void timerEvent(QTimerEvent *event) override;
+    // Set deadline for the task that become current. Deadline is based on the observed execution time.
+    // Not armed while mwc713 process is not started yet, onProcessStarted does that.
+    void startDeadline(taskInfo & task);
+    // Rearm the deadline timer, 0 - no deadline
+    void setDeadline(int64_t timeLimit);
 
     // Process next task
     void processNextTask();
 
+    // Start the task: write its command into mwc713
+    void startTask(taskInfo & task);
+    // Delete not started tasks of the group. Return number of deleted tasks
+    int removeGroupTasks(int64_t groupId);
+    // Start the tasks after the current one while they can be pipelined
+    void pipelineTasks();
+
+    // Maintain queuedTaskKeys for the tasks that enter or leave taskQ/groupTasks
+    void indexTask(const taskInfo & task);
+    void unindexTask(const taskInfo & task);
+    // Remove the first task from the taskQ
+    taskInfo takeFirstTask();
+
     // Execute this task and start the next one
     void executeTask(taskInfo task);
 
+    // WEventRouter
+    virtual bool getTaskReadyEvents(WEventSet & ready) override;
+    virtual void listenEvents(WEventSpan events) override;
+    virtual void taskEvent(const WEvent & evt, bool ready) override;
+
 private:
     // Wallet
     MWC713 * mwc713wallet = nullptr;
+    // Events source. Not owned
+    Mwc713ParserThread * parserThread = nullptr;
 
     // permanent tasks that allways active. They will process events one by one.
     // All input will come to them.
     // Example: checking for wallet become online/offline
-    QVector< Mwc713Task* > listeners; // Owner of the tasks
+    QVector< Mwc713Listener* > listeners; // Owner of the tasks
 
     QMutex taskQMutex; // recursive
     QVector< taskInfo > taskQ; // Owner of the tasks
+    // taskInfo::dedupKey -> number of such tasks at taskQ and groupTasks
+    QHash<QString, int> queuedTaskKeys;
+    int64_t coalescedTasks = 0;
+    int64_t lastTraceId = 0;
 
     // Events for a new task
     QVector<WEvent> events;
 
+    // Batch from the parser thread that is processing now. drainPos - first not processed event
+    QVector<WEvent> drainBatch;
+    int drainPos = 0;
+
     volatile qint64 taskExecutionTimeLimit = 0; // Timeout value for the task
+    int deadlineTimerId = 0;
+    // Task that is expired and waiting for the user decision. Reset when the task is done
+    const Mwc713Task * timeoutTask = nullptr;
+    bool timeoutPromptActive = false;
+
+    // Group that is collecting tasks, see beginTaskGroup
+    QVector< taskInfo > groupTasks;
+    int groupDepth = 0;
+    int64_t groupId = 0;
+    TASK_PRIORITY groupPriority = TASK_PRIORITY::USER_WRITE;
+    QString groupKey;
+    int64_t lastGroupId = 0;
+
+    // Time in the queue for every priority class, reported into the logs
+    struct QueueWaitStats {
+        int64_t tasks = 0;
+        int64_t totalMs = 0;
+        int64_t maxMs = 0;
+    };
+    QueueWaitStats waitStats[TASK_PRIORITY_NUM];
 };
 
 }
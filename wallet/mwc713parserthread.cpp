@@ -0,0 +1,97 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mwc713parserthread.h"
+#include "../tries/mwc713inputparser.h"
+#include "../util/ioutils.h"
+#include "../util/Log.h"
+#include <QThread>
+
+namespace wallet {
+
+Mwc713ParserWorker::Mwc713ParserWorker(Mwc713ParserThread * _owner) :
+    owner(_owner)
+{
+    // Editor prompt can be located at any line, filtering it out
+    outputReader = new ioutils::OutputReader("wallet713>");
+    inputParser = new tries::Mwc713InputParser();
+
+    // Parser is working in the same thread, no need for the queue
+    const bool connected = connect(inputParser, &tries::Mwc713InputParser::sgEvents, this, &Mwc713ParserWorker::onParsedEvents, Qt::DirectConnection );
+    Q_ASSERT(connected);
+    Q_UNUSED(connected);
+}
+
+Mwc713ParserWorker::~Mwc713ParserWorker() {
+    delete inputParser;
+    delete outputReader;
+}
+
+void Mwc713ParserWorker::onOutput(QByteArray data, qint64 readTime) {
+    // Escapes and 'wallet713>' prompts are filtered out, new lines are normalized.
+    int size = outputReader->process(data.constData(), data.size());
+    if (size==0)
+        return;
+
+    const char * filtered = outputReader->getData();
+    qDebug() << "Get output:" << QByteArray::fromRawData(filtered, size);
+    logger::logMwc713out( QString::fromUtf8(filtered, size) );
+
+    // Event time is the time when its data was read, not when the GUI thread got it
+    inputParser->processInput(filtered, size, readTime);
+}
+
+void Mwc713ParserWorker::onParsedEvents( const QVector<WEvent> & events ) {
+    owner->pushEvents(events);
+    owner->notifyConsumer();
+}
+
+////////////////////////////////////////////////////////////////////////////
+
+Mwc713ParserThread::Mwc713ParserThread() {
+    thread = new QThread();
+    thread->setObjectName("mwc713 parser");
+
+    worker = new Mwc713ParserWorker(this);
+    worker->moveToThread(thread);
+    connect( this, &Mwc713ParserThread::sgOutput, worker, &Mwc713ParserWorker::onOutput, Qt::QueuedConnection );
+
+    thread->start();
+}
+
+Mwc713ParserThread::~Mwc713ParserThread() {
+    // Posted data will be lost, the process is already stopped
+    thread->quit();
+    thread->wait();
+
+    delete worker;
+    delete thread;
+}
+
+void Mwc713ParserThread::notifyConsumer() {
+    // Only one notification at a time. Consumer will drain everything.
+    if (!drainScheduled.exchange(true))
+        emit sgEventsReady();
+}
+
+bool Mwc713ParserThread::finishDrain() {
+    drainScheduled.store(false);
+    if (eventQ.isEmpty())
+        return false;
+
+    // Producer might push events before the flag was reset and skip the notification
+    return !drainScheduled.exchange(true);
+}
+
+}
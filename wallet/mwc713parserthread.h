@@ -0,0 +1,101 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_MWC713PARSERTHREAD_H
+#define MWC_QT_WALLET_MWC713PARSERTHREAD_H
+
+#include <QObject>
+#include <atomic>
+#include "mwc713events.h"
+#include "tasktiming.h"
+#include "../util/SpscQueue.h"
+
+class QThread;
+
+namespace tries {
+    class Mwc713InputParser;
+}
+
+namespace ioutils {
+    class OutputReader;
+}
+
+namespace wallet {
+
+class Mwc713ParserThread;
+
+// Lives in the parser thread. Filter mwc713 output, parse it and push the events into the queue
+class Mwc713ParserWorker : public QObject {
+    Q_OBJECT
+public:
+    Mwc713ParserWorker(Mwc713ParserThread * owner);
+    virtual ~Mwc713ParserWorker() override;
+
+public slots:
+    // readTime - TaskTimeline::now() when data was read from mwc713
+    void onOutput(QByteArray data, qint64 readTime);
+    void onParsedEvents( const QVector<WEvent> & events );
+
+private:
+    Mwc713ParserThread * owner;
+    ioutils::OutputReader * outputReader = nullptr;
+    tries::Mwc713InputParser * inputParser = nullptr;
+};
+
+// mwc713 stdout processing in a dedicated thread. GUI thread only reads the process data.
+// Events are delivered through lock free queue by batches (one per stdout chunk) in the same order as mwc713 printed them.
+// Consumer (Mwc713EventManager) get sgEventsReady notification and drains the queue.
+class Mwc713ParserThread : public QObject {
+    Q_OBJECT
+    friend class Mwc713ParserWorker;
+public:
+    Mwc713ParserThread();
+    // Stop the thread and wait for the current data to be processed
+    virtual ~Mwc713ParserThread() override;
+
+    Mwc713ParserThread(const Mwc713ParserThread & ) = delete;
+    Mwc713ParserThread & operator=(const Mwc713ParserThread & ) = delete;
+
+    // Pass raw mwc713 stdout data to the parser
+    void processOutput(const QByteArray & data) { emit sgOutput(data, TaskTimeline::now()); }
+
+    // Consumer API
+    // Return false if nothing is ready
+    bool popEvents(QVector<WEvent> & events) { return eventQ.pop(events); }
+    // Consumer finished the drain. Return true if new events arrived and drain should be continued.
+    bool finishDrain();
+
+signals:
+    // Events are available. Emitted once until finishDrain is called
+    void sgEventsReady();
+
+    // Data for the worker
+    void sgOutput(QByteArray data, qint64 readTime);
+
+private:
+    // Producer API, parser thread only
+    void pushEvents(const QVector<WEvent> & events) { eventQ.push(events); }
+    void notifyConsumer();
+
+private:
+    QThread * thread = nullptr;
+    Mwc713ParserWorker * worker = nullptr;
+
+    util::SpscQueue< QVector<WEvent> > eventQ;
+    std::atomic<bool> drainScheduled{false};
+};
+
+}
+
+#endif //MWC_QT_WALLET_MWC713PARSERTHREAD_H
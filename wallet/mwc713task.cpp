@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "mwc713task.h"
+#include <QDebug>
 
 namespace wallet {
 
@@ -25,8 +26,20 @@ Mwc713Task::Mwc713Task(QString _taskName, QString _inputStr, MWC713 * _wallet713
 Mwc713Task::~Mwc713Task() {
 }
 
+void Mwc713Listener::processEvents(WEventSpan events) {
+    for (const WEvent & evt : events) {
+        if (processEvent(evt))
+            qDebug() << getTaskName() << "processed event" << toString(evt.event) << " msg='" << evt.printParams() << "'";
+    }
+}
+
+bool Mwc713Listener::processTask(const QVector<WEvent> & events) {
+    processEvents(events);
+    return true;
+}
+
 // Filter events by type
-QVector< WEvent > filterEvents(const QVector<WEvent> & events, WALLET_EVENTS type ) {
+QVector< WEvent > filterEvents(WEventSpan events, WALLET_EVENTS type ) {
     QVector< WEvent > res;
     for (const auto & e : events) {
         if (e.event == type)
@@ -36,14 +49,14 @@ QVector< WEvent > filterEvents(const QVector<WEvent> & events, WALLET_EVENTS typ
 }
 
 // Print events into the string
-QString printEvents(const QVector<WEvent> & events) {
+QString printEvents(WEventSpan events) {
     QString res;
 
     for (const auto & e : events) {
         if (res.length()>0)
             res += ", ";
 
-        res += "Evt(T=" + toString(e.event) + ", msg=" + e.message + ")";
+        res += "Evt(T=" + toString(e.event) + ", msg=" + e.printParams() + ")";
     }
     return res;
 }
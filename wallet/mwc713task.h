@@ -17,6 +17,7 @@
 
 #include <QString>
 #include "mwc713events.h"
+#include "tasktiming.h"
 #include <QSet>
 
 namespace wallet {
@@ -38,6 +39,24 @@ public:
 
     virtual void onStarted() {}
 
+    // true if command can be written into mwc713 before the previous commands are finished.
+    // mwc713 must print exactly one prompt for it and not read any extra input.
+    // Interactive and critical tasks (unlock, send, recover) must not be pipelined, they block the pipeline.
+    virtual bool isPipelinable() const {return false;}
+
+    // Called before the command is written into mwc713. Return true if the command is not needed
+    // any more, example: switch to the account that is already active. Skipped task doesn't wait
+    // for the ready event, processTask will be called with no events.
+    virtual bool canSkip() {return false;}
+
+    // Expected number of rows in the output, 0 if not known. Execution time statistic is collected per size class
+    virtual int getExpectedRows() const {return 0;}
+
+    // Called for every event while the task is active and waiting for the ready event.
+    // Tasks with a large output can process it as it comes.
+    // Return true if event was consumed and must not be passed into processTask
+    virtual bool processStreamEvent(const WEvent & evt) { Q_UNUSED(evt); return false; }
+
     // Will be called from 'Ready' for normal tasks
     // Or in order as events coming for filtering tasks
     // Return true if data was processed. In this case processed evenets will be dropped
@@ -57,6 +76,9 @@ public:
             return "Mwc713Task("+shadowStr+")";
     }
 
+    // Time points of the task life, filled by Mwc713EventManager
+    TaskTimeline & getTimeline() {return timeline;}
+
 protected:
     QString taskName;
 
@@ -64,15 +86,35 @@ protected:
     MWC713 * wallet713;
     QString inputStr; // string (command) to feed to a wallet
     QString shadowStr; // If difined, will represend this task into the logs
+    TaskTimeline timeline;
+};
+
+// Base class for permanent listeners. Listeners get all events in batches and process them one by one.
+// They don't have input and ready events.
+class Mwc713Listener : public Mwc713Task {
+public:
+    Mwc713Listener(QString taskName, MWC713 * wallet713) : Mwc713Task(taskName, "", wallet713, "") {}
+    virtual ~Mwc713Listener() override {}
+
+    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>();}
+
+    // Process the batch of events in order as mwc713 printed them
+    void processEvents(WEventSpan events);
+
+    virtual bool processTask(const QVector<WEvent> & events) override;
+
+protected:
+    // Return true if event was processed
+    virtual bool processEvent(const WEvent & evt) = 0;
 };
 
 // Some event utils
 
 // Filter events by type
-QVector< WEvent > filterEvents(const QVector<WEvent> & events, WALLET_EVENTS type );
+QVector< WEvent > filterEvents(WEventSpan events, WALLET_EVENTS type );
 
 // Print events into the string
-QString printEvents(const QVector<WEvent> & events);
+QString printEvents(WEventSpan events);
 
 }
 
@@ -0,0 +1,139 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mwc713events.h"
+
+// WEvent and helpers. Kept apart from Mwc713EventManager, so parsers can be linked without the wallet.
+
+namespace wallet {
+
+// Non negative integer value of the string, -1 if it is not a number
+static qint64 toEventNumber(const QString & str) {
+    int b = 0, e = str.length();
+    while (b<e && str[b].isSpace())
+        b++;
+    while (e>b && str[e-1].isSpace())
+        e--;
+
+    // 18 digits always fit into qint64
+    if (b==e || e-b > 18)
+        return -1;
+
+    qint64 res = 0;
+    for (int i=b; i<e; i++) {
+        ushort ch = str[i].unicode();
+        if (ch<'0' || ch>'9')
+            return -1;
+        res = res*10 + (ch-'0');
+    }
+    return res;
+}
+
+void WEvent::addParam(const QString & str) {
+    if (paramsNumber==0) {
+        message = str;
+        number = toEventNumber(str);
+    }
+    else {
+        extraParams.push_back( WEventParam(str, toEventNumber(str)) );
+    }
+    paramsNumber++;
+}
+
+const QString & WEvent::getParam(int idx) const {
+    static const QString empty;
+    if (idx<0 || idx>=paramsNumber)
+        return empty;
+    return idx==0 ? message : extraParams[idx-1].str;
+}
+
+qint64 WEvent::getNumber(int idx) const {
+    if (idx<0 || idx>=paramsNumber)
+        return -1;
+    return idx==0 ? number : extraParams[idx-1].number;
+}
+
+QString WEvent::printParams() const {
+    QString res = message;
+    for (const auto & p : extraParams)
+        res += "|" + p.str;
+    return res;
+}
+
+WEventSet::WEventSet(const QSet<WALLET_EVENTS> & events) {
+    for (WALLET_EVENTS evt : events)
+        insert(evt);
+}
+
+void WEventSet::insert(WALLET_EVENTS event) {
+    uint e = uint(event);
+    Q_ASSERT(e < MAX_EVENT);
+    if (e < MAX_EVENT)
+        bits[e/64] |= quint64(1) << (e%64);
+}
+
+QString toString(WALLET_EVENTS event) {
+    switch (event) {
+        case S_READY:           return "S_READY";
+        case S_WELCOME:         return "S_WELCOME";
+        case S_INIT:            return "S_INIT";
+        case S_PASSWORD_ERROR:  return "S_PASSWORD_ERROR";
+        case S_NEED2UNLOCK:     return "S_NEED2UNLOCK";
+        case S_MWC_MQ_LISTENER: return "S_MWC_MQ_LISTENER";
+        case S_GENERIC_ERROR:   return "S_GENERIC_ERROR";
+        case S_YOUR_MWC_ADDRESS:return "S_YOUR_MWC_ADDRESS";
+        case S_MWC_ADDRESS_INDEX:return "S_MWC_ADDRESS_INDEX";
+        case S_INIT_WANT_ENTER: return "S_INIT_WANT_ENTER";
+        case S_ERROR:           return "S_ERROR";
+        case S_LINE:            return "S_LINE";
+
+        case S_LISTENER_MQ_STARTING: return "S_LISTENER_MQ_STARTING";
+        case S_LISTENER_KB_STARTING: return "S_LISTENER_KB_STARTING";
+        case S_LISTENER_ON:  return "S_LISTENER_ON";
+        case S_LISTENER_MQ_STOPPING: return "S_LISTENER_MQ_STOPPING";
+        case S_LISTENER_KB_STOPPING: return "S_LISTENER_KB_STOPPING";
+        case S_LISTENER_OFF: return "S_LISTENER_OFF";
+        case S_RECOVERY_STARTING: return "S_RECOVERY_STARTING";
+        case S_RECOVERY_DONE:   return "S_RECOVERY_DONE";
+        case S_RECOVERY_PROGRESS: return "S_RECOVERY_PROGRESS";
+        case S_RECOVERY_MNEMONIC: return "S_RECOVERY_MNEMONIC";
+
+        case S_GENERIC_WARNING: return "S_GENERIC_WARNING";
+        case S_GENERIC_INFO:    return "S_GENERIC_INFO";
+
+        case S_LISTENER_MQ_LOST_CONNECTION:  return "S_LISTENER_MQ_LOST_CONNECTION";
+        case S_LISTENER_MQ_GET_CONNECTION:   return "S_LISTENER_MQ_GET_CONNECTION";
+        case S_LISTENER_MQ_COLLISION:        return "S_LISTENER_MQ_COLLISION";
+        case S_LISTENER_MQ_FAILED_TO_START:  return "S_LISTENER_MQ_FAILED_TO_START";
+
+        case S_LISTENER_KB_LOST_CONNECTION:  return "S_LISTENER_KB_LOST_CONNECTION";
+        case S_LISTENER_KB_GET_CONNECTION:   return "S_LISTENER_KB_GET_CONNECTION";
+
+        case S_ACCOUNTS_INFO_SUM: return "S_ACCOUNTS_INFO_SUM";
+
+        case S_SLATE_WAS_SENT_TO:    return "S_SLATE_WAS_SENT_TO";
+        case S_SLATE_WAS_SENT_BACK: return "S_SLATE_WAS_SENT_BACK";
+        case S_SLATE_WAS_RECEIVED_BACK: return "S_SLATE_WAS_RECEIVED_BACK";
+        case S_SLATE_WAS_RECEIVED_FROM: return "S_SLATE_WAS_RECEIVED_FROM";
+        case S_SLATE_WAS_FINALIZED: return "S_SLATE_WAS_FINALIZED";
+        case S_SET_RECEIVE:         return "S_SET_RECEIVE";
+
+        case S_TRANSACTION_LOG:     return "S_TRANSACTION_LOG";
+        case S_OUTPUT_LOG:          return "S_OUTPUT_LOG";
+
+        default: Q_ASSERT(false); return "Unknown";
+    }
+}
+
+}
@@ -0,0 +1,115 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tasklatency.h"
+#include "mwc713task.h"
+#include <QDataStream>
+#include <algorithm>
+#include <climits>
+
+namespace wallet {
+
+// Samples that we keep per key, old ones are replaced
+const int LATENCY_SAMPLES = 50;
+// Less samples are not enough to trust the percentile
+const int LATENCY_MIN_SAMPLES = 5;
+const int LATENCY_PERCENTILE = 95;
+// Deadline = percentile * LATENCY_HEADROOM_FACTOR + LATENCY_HEADROOM_MS
+const int LATENCY_HEADROOM_FACTOR = 3;
+const int64_t LATENCY_HEADROOM_MS = 2000;
+
+QString TaskLatencyStats::getKey(const Mwc713Task * task) {
+    const QString & input = task->getInputStr();
+    int cmdLen = input.indexOf(' ');
+    QString key = task->getTaskName() + "/" + (cmdLen<0 ? input : input.left(cmdLen));
+
+    // Grouping by the power of 2, time is expected to be proportional to the output size
+    int rows = task->getExpectedRows();
+    if (rows>0) {
+        int sizeClass = 1;
+        while (sizeClass < rows)
+            sizeClass *= 2;
+        key += "/" + QString::number(sizeClass);
+    }
+    return key;
+}
+
+void TaskLatencyStats::addSample(const QString & key, int64_t timeMs) {
+    Samples & s = stats[key];
+    int val = int(std::min( timeMs, int64_t(INT_MAX) ));
+    if (s.timeMs.size() < LATENCY_SAMPLES) {
+        s.timeMs.push_back(val);
+    }
+    else {
+        s.timeMs[s.next] = val;
+        s.next = (s.next+1) % LATENCY_SAMPLES;
+    }
+}
+
+int64_t TaskLatencyStats::getPercentile(const QString & key, int percentile) const {
+    auto it = stats.find(key);
+    if (it == stats.end() || it.value().timeMs.size() < LATENCY_MIN_SAMPLES)
+        return -1;
+
+    QVector<int> times = it.value().timeMs;
+    int idx = std::min( times.size()-1, (times.size() * percentile) / 100 );
+    std::nth_element( times.begin(), times.begin()+idx, times.end() );
+    return times[idx];
+}
+
+int64_t TaskLatencyStats::getTimeout(const QString & key, int64_t defaultTimeout) const {
+    int64_t p = getPercentile(key, LATENCY_PERCENTILE);
+    if (p<0)
+        return defaultTimeout;
+
+    int64_t timeout = p * LATENCY_HEADROOM_FACTOR + LATENCY_HEADROOM_MS;
+    return std::max( defaultTimeout/10, std::min( defaultTimeout*10, timeout ) );
+}
+
+void TaskLatencyStats::saveData(QDataStream & out) const {
+    out << int(0x5A31);
+    out << int(stats.size());
+    for (auto it = stats.begin(); it != stats.end(); it++) {
+        out << it.key();
+        out << it.value().timeMs;
+        out << it.value().next;
+    }
+}
+
+bool TaskLatencyStats::loadData(QDataStream & in) {
+    stats.clear();
+
+    int id = 0;
+    in >> id;
+    if ( id!=0x5A31 )
+        return false;
+
+    int sz = 0;
+    in >> sz;
+    for (int i=0; i<sz; i++) {
+        QString key;
+        Samples s;
+        in >> key;
+        in >> s.timeMs;
+        in >> s.next;
+        if (in.status() != QDataStream::Ok || s.timeMs.size() > LATENCY_SAMPLES || s.next<0 || s.next >= std::max(1, s.timeMs.size()) ) {
+            stats.clear();
+            return false;
+        }
+        stats[key] = s;
+    }
+    return true;
+}
+
+}
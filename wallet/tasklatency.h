@@ -0,0 +1,60 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_TASKLATENCY_H
+#define MWC_QT_WALLET_TASKLATENCY_H
+
+#include <QString>
+#include <QVector>
+#include <QMap>
+
+class QDataStream;
+
+namespace wallet {
+
+class Mwc713Task;
+
+// Observed execution time of mwc713 commands. Task deadlines are derived from it instead of
+// the static TIMEOUT values, so slow machines are not getting false alarms and hung mwc713 on
+// a fast machine is detected early.
+class TaskLatencyStats {
+public:
+    // Statistic key: task name, command and the output size class
+    static QString getKey(const Mwc713Task * task);
+
+    // Register execution time of the finished task
+    void addSample(const QString & key, int64_t timeMs);
+
+    // Deadline for the task: high percentile of the observed times plus headroom.
+    // defaultTimeout is used until there are enough samples. Result is limited to [defaultTimeout/10, defaultTimeout*10]
+    int64_t getTimeout(const QString & key, int64_t defaultTimeout) const;
+
+    // Percentile of the observed times. -1 if not enough samples
+    int64_t getPercentile(const QString & key, int percentile) const;
+
+    void saveData(QDataStream & out) const;
+    bool loadData(QDataStream & in);
+
+private:
+    // Last observed times, ring buffer
+    struct Samples {
+        QVector<int> timeMs;
+        int next = 0;
+    };
+    QMap<QString, Samples> stats;
+};
+
+}
+
+#endif //MWC_QT_WALLET_TASKLATENCY_H
@@ -38,6 +38,10 @@ static QString widenDerivPath(QString path ) {
     return res;
 }
 
+void TaskAccountList::onStarted() {
+    wallet713->startBalanceRefresh();
+}
+
 bool TaskAccountList::processTask(const QVector<WEvent> &events) {
     QVector< WEvent > lns = filterEvents(events, WALLET_EVENTS::S_LINE );
 
@@ -63,6 +67,7 @@ bool TaskAccountList::processTask(const QVector<WEvent> &events) {
 
     if (idx>=lns.size()) {
         notify::appendNotificationMessage( notify::MESSAGE_LEVEL::CRITICAL, "Unable to get a list of accounts from mwc713" );
+        wallet713->finishBalanceRefresh();
         return true; // No data to process.
     }
 
@@ -105,8 +110,18 @@ bool TaskAccountCreate::processTask(const QVector<WEvent> &events) {
 
 // ---------------------------- TaskAccountSwitch -------------------------
 
+bool TaskAccountSwitch::canSkip() {
+    return wallet713->skipAccountSwitch(switchAccountName);
+}
+
+void TaskAccountSwitch::onStarted() {
+    wallet713->startAccountSwitch();
+}
+
 bool TaskAccountSwitch::processTask(const QVector<WEvent> &events) {
     QVector< WEvent > errors = filterEvents( events, WALLET_EVENTS::S_ERROR );
+    // mwc713 account is recorded only after the switch succeeded
+    wallet713->finishAccountSwitch( errors.empty() ? switchAccountName : "" );
     if ( errors.empty() )
         wallet713->switchToAccount( switchAccountName, makeAccountCurrent );
     else
@@ -169,13 +184,14 @@ bool TaskAccountInfo::processTask( const QVector<WEvent> & events) {
         return false;
     }
 
-    QStringList infoData = infoEvts[0].message.split('|');
-    bool ok = (infoData.size()==2);
+    const WEvent & info = infoEvts[0];
+    bool ok = (info.getParamsNumber()==2);
     QString currentAccountName;
     int64_t height = 0;
     if (ok) {
-        currentAccountName = infoData[0];
-        height = infoData[1].toLongLong(&ok);
+        currentAccountName = info.getParam(0);
+        height = info.getNumber(1);
+        ok = height>=0;
     }
 
     int lnIdx = 0;
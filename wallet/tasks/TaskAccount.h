@@ -30,9 +30,12 @@ public:
 
     virtual ~TaskAccountList() override {}
 
+    virtual void onStarted() override;
+
     virtual bool processTask(const QVector<WEvent> &events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual bool isPipelinable() const override {return true;}
 
 };
 
@@ -64,9 +67,14 @@ public:
 
     virtual ~TaskAccountSwitch() override {}
 
+    // mwc713 might be at this account already
+    virtual bool canSkip() override;
+    virtual void onStarted() override;
+
     virtual bool processTask(const QVector<WEvent> &events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual bool isPipelinable() const override {return true;}
 private:
     QString switchAccountName;
     bool makeAccountCurrent;
@@ -109,6 +117,7 @@ public:
     virtual bool processTask(const QVector<WEvent> &events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>{ WALLET_EVENTS::S_READY };}
+    virtual bool isPipelinable() const override {return true;}
 };
 
 // Just a callback, not a real task
@@ -19,12 +19,7 @@
 
 namespace wallet {
 
-bool TaskErrWrnInfoListener::processTask(const QVector<WEvent> &events) {
-    // It is listener, one by one processing only
-    Q_ASSERT(events.size()==1);
-
-    const WEvent & evt = events[0];
-
+bool TaskErrWrnInfoListener::processEvent(const WEvent & evt) {
     switch (evt.event) {
         case S_READY:
             if (!walletIsReady)
@@ -33,8 +28,10 @@ bool TaskErrWrnInfoListener::processTask(const QVector<WEvent> &events) {
             return false;
         case S_ERROR:
         case S_GENERIC_ERROR: {
+            // After an error the active account is not known
+            wallet713->resetMwc713Account();
             if (walletIsReady) {
-                qDebug() << "TaskErrWrnInfoListener::processTask with events: " << printEvents(events);
+                qDebug() << "TaskErrWrnInfoListener::processEvent with event: " << printEvents( WEventSpan(&evt, 1) );
                 notify::appendNotificationMessage( notify::MESSAGE_LEVEL::CRITICAL,
                                                      evt.message);
             }
@@ -42,7 +39,7 @@ bool TaskErrWrnInfoListener::processTask(const QVector<WEvent> &events) {
         }
         case S_GENERIC_WARNING: {
             if (walletIsReady) {
-                qDebug() << "TaskErrWrnInfoListener::processTask with events: " << printEvents(events);
+                qDebug() << "TaskErrWrnInfoListener::processEvent with event: " << printEvents( WEventSpan(&evt, 1) );
                 notify::appendNotificationMessage( notify::MESSAGE_LEVEL::WARNING,
                                                      evt.message);
             }
@@ -50,7 +47,7 @@ bool TaskErrWrnInfoListener::processTask(const QVector<WEvent> &events) {
         }
         case S_GENERIC_INFO: {
             if (walletIsReady) {
-                qDebug() << "TaskErrWrnInfoListener::processTask with events: " << printEvents(events);
+                qDebug() << "TaskErrWrnInfoListener::processEvent with event: " << printEvents( WEventSpan(&evt, 1) );
                 notify::appendNotificationMessage( notify::MESSAGE_LEVEL::INFO,
                                                      evt.message);
             }
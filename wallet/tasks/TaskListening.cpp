@@ -22,12 +22,7 @@ namespace wallet {
 
 // ------------------------------- TaskListeningListener ------------------------------------------
 
-bool TaskListeningListener::processTask(const QVector<WEvent> &events) {
-    // It is listener, one by one processing only
-    Q_ASSERT(events.size()==1);
-
-    const WEvent & evt = events[0];
-
+bool TaskListeningListener::processEvent(const WEvent & evt) {
     switch (evt.event) {
         case S_YOUR_MWC_ADDRESS: {
             QString address = evt.message;
@@ -39,70 +34,66 @@ bool TaskListeningListener::processTask(const QVector<WEvent> &events) {
             return true;
         }
         case S_LISTENER_ON: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
+            qDebug() << "TaskListeningListener::processEvent with event: " << printEvents( WEventSpan(&evt, 1) );
 
-            QStringList prms = evt.message.split('|');
-            if ( prms.size()==0 )
+            if ( evt.getParamsNumber()==0 )
                 return false;
 
-            if ( prms[0] == "keybase" ) {
+            const QString & addrees = evt.getParam(0);
+            if ( addrees == "keybase" ) {
                 wallet713->setKeybaseListeningStatus(true);
             }
             else {
-                const QString & addrees = prms[0];
                 // x prefix is for testnet
                 // q - for mainnet
                 if (addrees.size()>0 && (addrees[0]=='x' || addrees[0]=='q') ) {
-                    wallet713->setMwcMqListeningStatus(true, prms.size()>1 ? prms[1] : "", true);
-                    wallet713->setMwcAddress(prms[0] );
+                    wallet713->setMwcMqListeningStatus(true, evt.getParam(1), true);
+                    wallet713->setMwcAddress(addrees);
                 }
             }
             return true;
         }
         case S_LISTENER_OFF: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
+            qDebug() << "TaskListeningListener::processEvent with event: " << printEvents( WEventSpan(&evt, 1) );
 
-            QStringList prms = evt.message.split('|');
-            if ( prms.size()==0 )
+            if ( evt.getParamsNumber()==0 )
                 return false;
 
-            if ( prms[0] == "keybase" ) {
+            if ( evt.getParam(0) == "keybase" ) {
                 wallet713->setKeybaseListeningStatus(false);
             }
             else {
-                wallet713->setMwcMqListeningStatus(false, prms.size()>1 ? prms[1] : "" , true);
+                wallet713->setMwcMqListeningStatus(false, evt.getParam(1), true);
             }
             return true;
         }
         case S_LISTENER_MQ_LOST_CONNECTION: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
-            QStringList prms = evt.message.split('|');
-            wallet713->setMwcMqListeningStatus(false, prms.size()>1 ? prms[1] : "", false );
+            qDebug() << "TaskListeningListener::processEvent with event: " << printEvents( WEventSpan(&evt, 1) );
+            wallet713->setMwcMqListeningStatus(false, evt.getParam(1), false );
             return true;
         }
         case S_LISTENER_MQ_GET_CONNECTION: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
-            QStringList prms = evt.message.split('|');
-            wallet713->setMwcMqListeningStatus(true, prms.size()>1 ? prms[1] : "", false );
+            qDebug() << "TaskListeningListener::processEvent with event: " << printEvents( WEventSpan(&evt, 1) );
+            wallet713->setMwcMqListeningStatus(true, evt.getParam(1), false );
             return true;
         }
         case S_LISTENER_KB_LOST_CONNECTION: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
+            qDebug() << "TaskListeningListener::processEvent with event: " << printEvents( WEventSpan(&evt, 1) );
             wallet713->setKeybaseListeningStatus(false);
             return true;
         }
         case S_LISTENER_KB_GET_CONNECTION: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
+            qDebug() << "TaskListeningListener::processEvent with event: " << printEvents( WEventSpan(&evt, 1) );
             wallet713->setKeybaseListeningStatus(true);
             return true;
         }
         case S_LISTENER_MQ_COLLISION: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
+            qDebug() << "TaskListeningListener::processEvent with event: " << printEvents( WEventSpan(&evt, 1) );
             wallet713->notifyListenerMqCollision();
             return true;
         }
         case S_LISTENER_MQ_FAILED_TO_START: {
-            qDebug() << "TaskListeningListener::processTask with events: " << printEvents(events);
+            qDebug() << "TaskListeningListener::processEvent with event: " << printEvents( WEventSpan(&evt, 1) );
             wallet713->notifyMqFailedToStart();
             return true;
         }
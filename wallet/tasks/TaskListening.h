@@ -21,18 +21,17 @@ namespace wallet {
 
 // It is listener task. No input can be defined.
 // Listening for MWC MQ & keybase connection statuses
-class TaskListeningListener : public Mwc713Task {
+class TaskListeningListener : public Mwc713Listener {
 public:
     const static int64_t TIMEOUT = 3600*1000*5; // NA in any case
 
     TaskListeningListener( MWC713 *wallet713 ) :
-            Mwc713Task("TaskListeningListener", "", wallet713,"") {}
+            Mwc713Listener("TaskListeningListener", wallet713) {}
 
     virtual ~TaskListeningListener() override {}
 
-    virtual bool processTask(const QVector<WEvent> &events) override;
-
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>();}
+protected:
+    virtual bool processEvent(const WEvent & evt) override;
 };
 
 
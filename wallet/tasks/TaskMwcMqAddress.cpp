@@ -36,12 +36,8 @@ bool TaskMwcMqAddress::processTask(const QVector<WEvent> & events) {
 
     int idx=-1;
 
-    if (mwcMqAddrIdx.size()>0) {
-        bool ok = false;
-        idx = mwcMqAddrIdx[0].message.toInt(&ok);
-        if (!ok)
-            idx=-1;
-    }
+    if (mwcMqAddrIdx.size()>0)
+        idx = int(mwcMqAddrIdx[0].number);
 
     qDebug() << "Get mwc MQ address " << address << " for index " << idx;
 
@@ -45,28 +45,21 @@ static bool ProcessRecoverTask(const QVector<WEvent> &events,MWC713 *wallet713)
 
 // ----------------------------------- TaskRecoverProgressListener ---------------------------------
 
-bool TaskRecoverProgressListener::processTask(const QVector<WEvent> &events) {
-    // It is listener, one by one processing only
-    Q_ASSERT(events.size()==1);
-
-    const WEvent & evt = events[0];
+bool TaskRecoverProgressListener::processEvent(const WEvent & evt) {
     if (evt.event != S_RECOVERY_PROGRESS)
         return false;
 
-    qDebug() << "TaskRecoverProgressListener::processTask with events: " << printEvents(events);
+    qDebug() << "TaskRecoverProgressListener::processEvent with event: " << printEvents( WEventSpan(&evt, 1) );
 
-    QStringList lst = evt.message.split('|');
-    Q_ASSERT(lst.size()==2);
-    if (lst.size()!=2)
+    Q_ASSERT(evt.getParamsNumber()==2);
+    if (evt.getParamsNumber()!=2)
         return false;
 
-    bool ok0 = false;
-    int64_t limit = lst[0].toLongLong(&ok0); // Limit
-    bool ok1 = false;
-    int64_t pos = lst[1].toLongLong(&ok1); // position
+    int64_t limit = evt.getNumber(0); // Limit
+    int64_t pos = evt.getNumber(1); // position
 
-    Q_ASSERT(ok0 && ok1);
-    if (ok0 && ok1) {
+    Q_ASSERT(limit>=0 && pos>=0);
+    if (limit>=0 && pos>=0) {
         Q_ASSERT(pos<=limit);
         wallet713->setRecoveryProgress( pos, limit );
         return true;
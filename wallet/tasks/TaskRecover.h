@@ -22,20 +22,18 @@
 namespace wallet {
 
 // It is listener task. No input can be defined
-class TaskRecoverProgressListener : public Mwc713Task {
+class TaskRecoverProgressListener : public Mwc713Listener {
 public:
     const static int64_t TIMEOUT = 3600*1000*5; // 5 hours should be enough
 
     // Start one listen per request. mwc713 doesn't support both
     TaskRecoverProgressListener( MWC713 *wallet713 ) :
-            Mwc713Task("TaskRecoverProgressListener", "", wallet713,"") {}
+            Mwc713Listener("TaskRecoverProgressListener", wallet713) {}
 
     virtual ~TaskRecoverProgressListener() override {}
 
-    virtual bool processTask(const QVector<WEvent> &events) override;
-
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>();}
-
+protected:
+    virtual bool processEvent(const WEvent & evt) override;
 };
 
 /////////////////////////////////////////////////////
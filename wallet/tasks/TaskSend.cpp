@@ -22,53 +22,43 @@ namespace wallet {
 
 // ---------------- TaskSlatesListener -----------------------
 
-bool TaskSlatesListener::processTask(const QVector<WEvent> & events) {
-    // It is listener, one by one processing only
-    Q_ASSERT(events.size()==1);
-
-    const WEvent & evt = events[0];
-
+bool TaskSlatesListener::processEvent(const WEvent & evt) {
     switch (evt.event) {
     case S_SLATE_WAS_SENT_TO:{
-        qDebug() << "TaskSlatesListener::processTask with events: " << printEvents(events);
-        QStringList prms = evt.message.split('|');
-        if (prms.size()==3) {
-            wallet713->reportSlateSendTo( prms[0], util::zeroDbl2Dbl( prms[1] ), prms[2] );
+        qDebug() << "TaskSlatesListener::processEvent with event: " << printEvents( WEventSpan(&evt, 1) );
+        if (evt.getParamsNumber()==3) {
+            wallet713->reportSlateSendTo( evt.getParam(0), util::zeroDbl2Dbl( evt.getParam(1) ), evt.getParam(2) );
         }
         return true;
     }
     case S_SLATE_WAS_SENT_BACK:{
-        qDebug() << "TaskSlatesListener::processTask with events: " << printEvents(events);
-        QStringList prms = evt.message.split('|');
-        if (prms.size()==2) {
-            wallet713->reportSlateSendBack( prms[0], prms[1] );
+        qDebug() << "TaskSlatesListener::processEvent with event: " << printEvents( WEventSpan(&evt, 1) );
+        if (evt.getParamsNumber()==2) {
+            wallet713->reportSlateSendBack( evt.getParam(0), evt.getParam(1) );
         }
         return true;
     }
 
     case S_SLATE_WAS_RECEIVED_FROM: {
         // We get some moner from somebody!!!
-        qDebug() << "TaskSlatesListener::processTask with events: " << printEvents(events);
-        QStringList prms = evt.message.split('|');
-        if (prms.size()>=3) {
-            wallet713->reportSlateReceivedFrom( prms[0], util::zeroDbl2Dbl( prms[2] ), prms[1], prms.size()>3 ? prms[3] : "" );
+        qDebug() << "TaskSlatesListener::processEvent with event: " << printEvents( WEventSpan(&evt, 1) );
+        if (evt.getParamsNumber()>=3) {
+            wallet713->reportSlateReceivedFrom( evt.getParam(0), util::zeroDbl2Dbl( evt.getParam(2) ), evt.getParam(1), evt.getParam(3) );
         }
         return true;
     }
 
     case S_SLATE_WAS_RECEIVED_BACK: {
-        qDebug() << "TaskSlatesListener::processTask with events: " << printEvents(events);
-        QStringList prms = evt.message.split('|');
-        if (prms.size()==3) {
-            wallet713->reportSlateReceivedBack( prms[0], util::zeroDbl2Dbl( prms[2] ), prms[1] );
+        qDebug() << "TaskSlatesListener::processEvent with event: " << printEvents( WEventSpan(&evt, 1) );
+        if (evt.getParamsNumber()==3) {
+            wallet713->reportSlateReceivedBack( evt.getParam(0), util::zeroDbl2Dbl( evt.getParam(2) ), evt.getParam(1) );
         }
         return true;
     }
     case S_SLATE_WAS_FINALIZED: {
-        qDebug() << "TaskSlatesListener::processTask with events: " << printEvents(events);
-        QStringList prms = evt.message.split('|');
-        if (prms.size()==1) {
-            wallet713->reportSlateFinalized( prms[0] );
+        qDebug() << "TaskSlatesListener::processEvent with event: " << printEvents( WEventSpan(&evt, 1) );
+        if (evt.getParamsNumber()==1) {
+            wallet713->reportSlateFinalized( evt.message );
         }
         return true;
     }
@@ -131,10 +121,10 @@ bool TaskSendMwc::processTask(const QVector<WEvent> &events) {
         QVector< WEvent > sendSlate = filterEvents(events, WALLET_EVENTS::S_SLATE_WAS_SENT_TO);
 
         if (sendSlate.size()==1) {
-            QStringList prms = sendSlate[0].message.split('|');
-            if (prms.size()==3) {
-                slate = prms[0];
-                address = prms[2];
+            const WEvent & evt = sendSlate[0];
+            if (evt.getParamsNumber()==3) {
+                slate = evt.getParam(0);
+                address = evt.getParam(2);
             }
         }
     }
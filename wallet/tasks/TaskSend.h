@@ -21,16 +21,15 @@
 namespace wallet {
 
 // Listening for transaction task
-class TaskSlatesListener : public Mwc713Task {
+class TaskSlatesListener : public Mwc713Listener {
 public:
     TaskSlatesListener( MWC713 * wallet713) :
-            Mwc713Task("TaskSlatesListener", "", wallet713, "") {}
+            Mwc713Listener("TaskSlatesListener", wallet713) {}
 
     virtual ~TaskSlatesListener() override {}
 
-    virtual bool processTask(const QVector<WEvent> & events) override;
-
-    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>();}
+protected:
+    virtual bool processEvent(const WEvent & evt) override;
 };
 
 ////////////////////////////////////     set-recv       ///////////////
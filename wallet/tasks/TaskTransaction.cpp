@@ -18,212 +18,170 @@
 
 namespace wallet {
 
-// ------------------------------------ TaskOutputs -------------------------------------------
-
-struct OutputIdxLayout {
-    int outputCommitment = -1;
-    int mmrIndex = -1;
-    int blockHeight = -1;
-    int lockedUntil = -1;
-    int status = -1;
-    int coinbase = -1;
-    int confirms= -1;
-    int value = -1;
-    int tx = -1;
-
-    bool isDefined() const {
-        return outputCommitment>=0 && mmrIndex>0 && blockHeight>0 && lockedUntil>0 && status >0 && coinbase>0 && confirms>0 && value>0 && tx>0;
-    }
-};
+// ------------------------------------ TableDecoder -------------------------------------------
 
-bool parseOutputLine( QString str, const OutputIdxLayout & tl,
-                           WalletOutput & output) {
-
-    QString strOutputCommitment = util::getSubString(str, tl.outputCommitment, tl.mmrIndex );
-    QString strMmrIndex = util::getSubString(str, tl.mmrIndex, tl.blockHeight);
-    QString strBlockHeight = util::getSubString(str, tl.blockHeight, tl.lockedUntil);
-    QString strLockedUntil = util::getSubString(str, tl.lockedUntil, tl.status);
-    QString strStatus = util::getSubString(str, tl.status, tl.coinbase);
-    QString strCoinbase = util::getSubString(str, tl.coinbase, tl.confirms);
-    QString strConfirms = util::getSubString(str, tl.confirms, tl.value);
-    QString strValue = util::getSubString(str, tl.value, tl.tx);
-    QString strTx = util::getSubString(str, tl.tx, str.length());
+TableDecoder::TableDecoder(WALLET_EVENTS _titleEvent) :
+    titleEvent(_titleEvent)
+{
+}
 
-    if (strOutputCommitment.isEmpty() )
-        return false;
+TableDecoder::~TableDecoder() {}
 
-    QPair<bool,int64_t> mwcOne = util::one2nano(strValue);
+bool TableDecoder::processEvent(const WEvent & evt) {
+    if (evt.event == titleEvent) {
+        Q_ASSERT(evt.getParamsNumber()==2);
+        account = evt.getParam(0);
+        height = evt.getNumber(1);
+        state = STATE::HEADER;
+        return true;
+    }
 
-    bool ok = false;
-    int64_t tx = strTx.toLongLong(&ok);
-    if (!ok)
+    if (evt.event != WALLET_EVENTS::S_LINE)
         return false;
 
-    output.setData(strOutputCommitment,
-                   strMmrIndex,
-                   strBlockHeight,
-            strLockedUntil,
-            strStatus,
-            strCoinbase != "false",
-            strConfirms,
-            mwcOne.second,
-            tx);
+    const QString & line = evt.message;
 
-    return mwcOne.first;
-}
-
-static int getNumberFromEvents(const QVector<WEvent> & events) {
-    // Searching for the last line with just a number
-    int number = 0; // in case if not found...
-    for (int i=events.size()-1; i>=0; i--) {
-        if ( events[i].event == WALLET_EVENTS::S_LINE ) {
-            bool ok = false;
-            int n = events[i].message.toInt(&ok);
-            if (ok && n>=0) {
-                number = n;
-                break;
-            }
-        }
+    // Note, the columns and the order are hardcoded and come from mwc713 data!!!
+    switch (state) {
+        case STATE::TITLE:
+            break; // Lines before the table, nobody need them
+        case STATE::HEADER:
+            if (processHeader(line))
+                state = STATE::SEPARATOR;
+            break;
+        case STATE::SEPARATOR:
+            if (line.startsWith("=============="))
+                state = STATE::ROWS;
+            break;
+        case STATE::ROWS:
+            if (!line.startsWith("--------------------"))
+                processRow(line);
+            break;
     }
-    return number;
-}
-
-
-bool TaskOutputCount::processTask(const QVector<WEvent> & events) {
-    wallet713->updateOutputCount( account, getNumberFromEvents(events));
     return true;
 }
 
-bool TaskTransactionCount::processTask(const QVector<WEvent> & events) {
-    wallet713->updateTransactionCount(account, getNumberFromEvents(events));
-    return true;
-}
-
-
-bool TaskOutputs::processTask(const QVector<WEvent> & events) {
-    // We are processing transactions outptu mostly as a raw data
+// ------------------------------------ OutputsDecoder -------------------------------------------
 
-    int curEvt = 0;
+bool OutputsDecoder::processHeader(const QString & str) {
+    if ( !(str.contains("Output Commitment") && str.contains("Block Height")) )
+        return false;
 
-    QString account;
-    int64_t  height = -1;
+    layout.outputCommitment = str.indexOf("Output Commitment");
+    layout.mmrIndex = str.indexOf("MMR Index", layout.outputCommitment);
+    layout.blockHeight = str.indexOf("Block Height", layout.mmrIndex);
+    layout.lockedUntil = str.indexOf("Locked Until", layout.blockHeight);
+    layout.status = str.indexOf("Status", layout.lockedUntil);
+    layout.coinbase = str.indexOf("Coinbase", layout.status);
+    layout.confirms= str.indexOf("# Confirms", layout.coinbase);
+    layout.value = str.indexOf("Value", layout.confirms);
+    layout.tx = str.indexOf("Tx", layout.value);
+
+    Q_ASSERT(layout.isDefined()); // There is a small chance, but it is really not likely it is ok
+    return layout.isDefined();
+}
 
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_OUTPUT_LOG ) {
-            QStringList l = events[curEvt].message.split('|');
-            Q_ASSERT(l.size()==2);
-            account = l[0];
-            height = l[1].toInt();
-            break;
-        }
-    }
+void OutputsDecoder::processRow(const QString & str) {
+    const Layout & tl = layout;
+    // Fields are referenced, only the stored ones are copied
+    QStringRef strOutputCommitment = util::getSubStringRef(str, tl.outputCommitment, tl.mmrIndex );
+    QStringRef strMmrIndex = util::getSubStringRef(str, tl.mmrIndex, tl.blockHeight);
+    QStringRef strBlockHeight = util::getSubStringRef(str, tl.blockHeight, tl.lockedUntil);
+    QStringRef strLockedUntil = util::getSubStringRef(str, tl.lockedUntil, tl.status);
+    QStringRef strStatus = util::getSubStringRef(str, tl.status, tl.coinbase);
+    QStringRef strCoinbase = util::getSubStringRef(str, tl.coinbase, tl.confirms);
+    QStringRef strConfirms = util::getSubStringRef(str, tl.confirms, tl.value);
+    QStringRef strValue = util::getSubStringRef(str, tl.value, tl.tx);
+    QStringRef strTx = util::getSubStringRef(str, tl.tx, str.length());
 
-    // positions for the columns. Note, the columns and the order are hardcoded and come from mwc713 data!!!
-
-    OutputIdxLayout outLayout;
-
-    // Continue with transaction output
-    // Search for Header first
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_LINE ) {
-            auto & str = events[curEvt].message;
-            if ( str.contains("Output Commitment") && str.contains("Block Height") ) {
-
-                outLayout.outputCommitment = str.indexOf("Output Commitment");
-                outLayout.mmrIndex = str.indexOf("MMR Index", outLayout.outputCommitment);
-                outLayout.blockHeight = str.indexOf("Block Height", outLayout.mmrIndex);
-                outLayout.lockedUntil = str.indexOf("Locked Until", outLayout.blockHeight);
-                outLayout.status = str.indexOf("Status", outLayout.lockedUntil);
-                outLayout.coinbase = str.indexOf("Coinbase", outLayout.status);
-                outLayout.confirms= str.indexOf("# Confirms", outLayout.coinbase);
-                outLayout.value = str.indexOf("Value", outLayout.confirms);
-                outLayout.tx = str.indexOf("Tx", outLayout.value);
-
-                if ( outLayout.isDefined() ) {
-                    curEvt++;
-                    break;
-                }
-                Q_ASSERT(false); // There is a small chance, but it is really not likely it is ok
-            }
-        }
-    }
+    if (strOutputCommitment.isEmpty() )
+        return;
 
-    // Skip header
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_LINE) {
-            auto &str = events[curEvt].message;
-            if (str.startsWith("==============")) {
-                curEvt++; // skipping this
-                break;
-            }
-        }
-    }
+    QPair<bool,int64_t> mwcOne = util::one2nano(strValue);
+    if (!mwcOne.first)
+        return;
 
-    QVector< WalletOutput > outputResult;
+    bool ok = false;
+    int64_t tx = strTx.toLongLong(&ok);
+    if (!ok)
+        return;
+
+    // Numbers are empty for the outputs that are not in the chain yet
+    auto toNumber = [](const QStringRef & s, int64_t def) -> int64_t {
+        bool numOk = false;
+        int64_t n = s.toLongLong(&numOk);
+        return numOk ? n : def;
+    };
+
+    WalletOutput output;
+    output.setData(strOutputCommitment.toString(),
+                   toNumber(strMmrIndex, -1),
+                   toNumber(strBlockHeight, -1),
+            toNumber(strLockedUntil, 0),
+            WalletOutput::statusFromString(strStatus),
+            strCoinbase != QLatin1String("false"),
+            toNumber(strConfirms, 0),
+            mwcOne.second,
+            tx);
+    outputs.push_back(output);
+}
 
-    // Processing transactions
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_LINE ) {
-            auto &str = events[curEvt].message;
+QVector<WalletOutput> OutputsDecoder::takeAll() {
+    QVector<WalletOutput> res;
+    res.swap(outputs);
+    return res;
+}
 
-            if (str.startsWith("--------------------"))
-                continue;
+// ------------------------------------ TransactionsDecoder -------------------------------------------
 
-            // Expected to be a normal line
-            WalletOutput output;
-            if ( parseOutputLine(str, outLayout, output) ) {
-                outputResult.push_back(output);
-            }
-        }
-    }
+bool TransactionsDecoder::processHeader(const QString & str) {
+    if ( !(str.contains("Creation Time") && str.contains("Confirmed?")) )
+        return false;
 
-    wallet713->setOutputs(account, height, outputResult );
-    return true;
+    layout.posId = str.indexOf("Id");
+    layout.posType = str.indexOf("Type", layout.posId);
+    layout.posTxid = str.indexOf("TXID", layout.posType);
+    layout.posAddress = str.indexOf("Address", layout.posTxid);
+    layout.posCrTime = str.indexOf("Creation Time", layout.posAddress);
+    layout.posConf = str.indexOf("Confirmed?", layout.posCrTime);
+    layout.posHeight = str.indexOf("Height", layout.posConf);
+    layout.posConfTime = str.indexOf("Confirmation Time", layout.posConf);
+    layout.posNetDiff = str.indexOf("Net", layout.posConfTime);
+    layout.posProof = str.indexOf("Proof?", layout.posNetDiff);
+
+    Q_ASSERT(layout.isDefined()); // There is a small chance, but it is really not likely it is ok
+    return layout.isDefined();
 }
 
-
-// ------------------------------------ TaskTransactions -------------------------------------------
-
-struct TransactionIdxLayout {
-    int posId = -1;
-    int posType = -1;
-    int posTxid = -1;
-    int posAddress = -1;
-    int posCrTime = -1;
-    int posConf = -1;
-    int posHeight = -1;
-    int posConfTime = -1;
-    int posNetDiff = -1;
-    int posProof = -1;
-
-    bool isDefined() const {
-        return posId>=0 && posType>0 && posTxid>0 && posAddress>0 && posCrTime>0 &&
-                            posConf>0 && posHeight>0 && posConfTime>0 && posNetDiff>0 && posProof>0;
+void TransactionsDecoder::processRow(const QString & str) {
+    // mwc713 has a special line for 'cancelled'
+    if (str.contains("- Cancelled")) {
+        auto it = transactions.find(pendingId);
+        if (it != transactions.end())
+            it.value().cancelled();
+        return;
     }
-};
-
-bool parseTransactionLine( QString str, const TransactionIdxLayout & tl,
-                           WalletTransaction & trans) {
-
-    QString strId       = util::getSubString(str, tl.posId, tl.posType);
-    QString strType     = util::getSubString(str, tl.posType, tl.posTxid);
-    QString strTxid     = util::getSubString(str, tl.posTxid, tl.posAddress);
-    QString strAddress  = util::getSubString(str, tl.posAddress, tl.posCrTime);
-    QString strCrTime   = util::getSubString(str, tl.posCrTime, tl.posConf);
-    QString strConf     = util::getSubString(str, tl.posConf, tl.posHeight);
-    QString strHeight   = util::getSubString(str, tl.posHeight, tl.posConfTime);
-    QString strConfTime = util::getSubString(str, tl.posConfTime, tl.posNetDiff);
-    QString strNetDiff  = util::getSubString(str, tl.posNetDiff, tl.posProof);
-    QString strProof    = util::getSubString(str, tl.posProof, str.length());
+
+    const Layout & tl = layout;
+    // Fields are referenced, only the stored ones are copied
+    QStringRef strId       = util::getSubStringRef(str, tl.posId, tl.posType);
+    QStringRef strType     = util::getSubStringRef(str, tl.posType, tl.posTxid);
+    QStringRef strTxid     = util::getSubStringRef(str, tl.posTxid, tl.posAddress);
+    QStringRef strAddress  = util::getSubStringRef(str, tl.posAddress, tl.posCrTime);
+    QStringRef strCrTime   = util::getSubStringRef(str, tl.posCrTime, tl.posConf);
+    QStringRef strConf     = util::getSubStringRef(str, tl.posConf, tl.posHeight);
+    QStringRef strHeight   = util::getSubStringRef(str, tl.posHeight, tl.posConfTime);
+    QStringRef strConfTime = util::getSubStringRef(str, tl.posConfTime, tl.posNetDiff);
+    QStringRef strNetDiff  = util::getSubStringRef(str, tl.posNetDiff, tl.posProof);
+    QStringRef strProof    = util::getSubStringRef(str, tl.posProof, str.length());
 
     if (strId.length() == 0)
-        return false;
+        return;
 
     bool ok = false;
-    int64_t id = -1;
-    id = strId.toLongLong(&ok);
+    int64_t id = strId.toLongLong(&ok);
     if (!ok || id < 0)
-        return false;
+        return;
 
     WalletTransaction::TRANSACTION_TYPE tansType = WalletTransaction::TRANSACTION_TYPE::NONE;
     if (strType.startsWith("Sent") || strType.startsWith("Send"))
@@ -231,10 +189,10 @@ bool parseTransactionLine( QString str, const TransactionIdxLayout & tl,
     else if (strType.startsWith("Received"))
         tansType = WalletTransaction::TRANSACTION_TYPE::RECEIVE;
     else
-        return false;
+        return;
 
     if ( strCrTime.isEmpty())
-        return false;
+        return;
 
     bool conf = strConf.startsWith("yes", Qt::CaseInsensitive);
 
@@ -242,126 +200,96 @@ bool parseTransactionLine( QString str, const TransactionIdxLayout & tl,
 
     QPair<bool, int64_t> net = util::one2nano(strNetDiff);
     if ( !net.first )
-        return false;
+        return;
 
     bool proof = strProof.startsWith("yes", Qt::CaseInsensitive);
 
+    WalletTransaction trans;
     trans.setData(id, tansType,
-                  strTxid,
-                  strAddress,
-                  strCrTime,
+                  strTxid.toString(),
+                  strAddress.toString(),
+                  util::mwc713time2ms(strCrTime),
                   conf,
                   height,
-                  strConfTime,
+                  util::mwc713time2ms(strConfTime),
                   net.second,
                   proof);
-    return true;
+
+    // The same id replace the previous row
+    transactions.insert(id, trans);
+    pendingId = id;
 }
 
-// local utility function that parse transactions output
-static void parseTransactionsOutput(const QVector<WEvent> & events, // in
-                                    QString & account, // out
-                                    int64_t & height,  // out
-                                    QVector<WalletTransaction> & trVector) // out
-{
-    // We are processing transactions mostly as a raw data
-    int curEvt = 0;
-
-    account = "";
-    height = -1;
-
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_TRANSACTION_LOG ) {
-            QStringList l = events[curEvt].message.split('|');
-            Q_ASSERT(l.size()==2);
-            account = l[0];
-            height = l[1].toInt();
-            break;
-        }
-    }
+QVector<WalletTransaction> TransactionsDecoder::takeReady() {
+    QVector<WalletTransaction> res;
+    if (getReadyNumber()<=0)
+        return res;
 
-    // positions for the columns. Note, the columns and the order are hardcoded and come from mwc713 data!!!
-
-    TransactionIdxLayout tl;
-
-    // Continue with transaction output
-    // Search for Header first
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_LINE ) {
-            auto & str = events[curEvt].message;
-            if ( str.contains("Creation Time") && str.contains("Confirmed?") ) {
-                tl.posId = str.indexOf("Id");
-                tl.posType = str.indexOf("Type", tl.posId);
-                tl.posTxid = str.indexOf("TXID", tl.posType);
-                tl.posAddress = str.indexOf("Address", tl.posTxid);
-                tl.posCrTime = str.indexOf("Creation Time", tl.posAddress);
-                tl.posConf = str.indexOf("Confirmed?", tl.posCrTime);
-                tl.posHeight = str.indexOf("Height", tl.posConf);
-                tl.posConfTime = str.indexOf("Confirmation Time", tl.posConf);
-                tl.posNetDiff = str.indexOf("Net", tl.posConfTime);
-                tl.posProof = str.indexOf("Proof?", tl.posNetDiff);
-
-                if ( tl.isDefined() ) {
-                    curEvt++;
-                    break;
-                }
-                Q_ASSERT(false); // There is a small chance, but it is really not likely it is ok
-            }
+    res.reserve(transactions.size());
+    for (auto it = transactions.begin(); it != transactions.end(); ) {
+        if (it.key() == pendingId) {
+            it++;
+            continue;
         }
+        res.push_back(it.value());
+        it = transactions.erase(it);
     }
+    return res;
+}
+
+QVector<WalletTransaction> TransactionsDecoder::takeAll() {
+    QVector<WalletTransaction> res;
+    res.reserve(transactions.size());
+    for (const WalletTransaction & tx : transactions)
+        res.push_back(tx);
+    transactions.clear();
+    pendingId = -1;
+    return res;
+}
 
-    // Skip header
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_LINE) {
-            auto &str = events[curEvt].message;
-            if (str.startsWith("==============")) {
-                curEvt++; // skipping this
+// ------------------------------------ TaskOutputs -------------------------------------------
+
+static int getNumberFromEvents(const QVector<WEvent> & events) {
+    // Searching for the last line with just a number
+    int number = 0; // in case if not found...
+    for (int i=events.size()-1; i>=0; i--) {
+        if ( events[i].event == WALLET_EVENTS::S_LINE ) {
+            // Numbers are converted by the parser
+            if (events[i].number>=0) {
+                number = int(events[i].number);
                 break;
             }
         }
     }
+    return number;
+}
 
-    QMap<int64_t, WalletTransaction > transactions;
-
-    // Processing transactions
-    int64_t lastTransId = -1;
-    for ( ; curEvt < events.size(); curEvt++ ) {
-        if (events[curEvt].event == WALLET_EVENTS::S_LINE ) {
-            auto &str = events[curEvt].message;
 
-            if (str.startsWith("--------------------"))
-                continue;
+bool TaskOutputCount::processTask(const QVector<WEvent> & events) {
+    wallet713->updateOutputCount( account, getNumberFromEvents(events));
+    return true;
+}
 
-            // mwc713 has a special line for 'cancelled'
-            if (str.contains("- Cancelled")) {
-                transactions[lastTransId].cancelled();
-                continue;
-            }
+bool TaskTransactionCount::processTask(const QVector<WEvent> & events) {
+    wallet713->updateTransactionCount(account, getNumberFromEvents(events));
+    return true;
+}
 
-            // Expected to be a normal line
-            WalletTransaction trans;
-            if ( parseTransactionLine(str, tl, trans) ) {
-                lastTransId = trans.txIdx;
-                transactions[trans.txIdx] = trans;
-            }
-        }
-    }
 
-    trVector.clear();
-    for ( WalletTransaction & trItem : transactions )
-        trVector.push_back( trItem );
+bool TaskOutputs::processTask(const QVector<WEvent> & events) {
+    Q_UNUSED(events)
+    // Table was decoded by processStreamEvent
+    wallet713->setOutputs(decoder.getAccount(), decoder.getHeight(), decoder.takeAll(), offset, rows );
+    return true;
 }
 
-bool TaskTransactions::processTask(const QVector<WEvent> & events) {
-
-    QString account;
-    int64_t height = -1;
-    QVector<WalletTransaction> trVector;
 
-    parseTransactionsOutput(events, // in
-                           account, height, trVector); // out
+// ------------------------------------ TaskTransactions -------------------------------------------
 
-    wallet713->setTransactions( account, height, trVector );
+bool TaskTransactions::processTask(const QVector<WEvent> & events) {
+    Q_UNUSED(events)
+    // Table was decoded by processStreamEvent
+    wallet713->setTransactions( decoder.getAccount(), decoder.getHeight(), decoder.takeAll(), offset, pageOffset, pageNumber );
     return true;
 }
 
@@ -380,16 +308,43 @@ bool TaskAllTransactionsEnd::processTask(const QVector<WEvent> &events) {
     return true;
 }
 
+// Number of decoded transactions that worth to deliver before the end of the table
+const int ALL_TRANSACTIONS_CHUNK = 1000;
+
+bool TaskAllTransactions::processStreamEvent(const WEvent & evt) {
+    if (!decoder.processEvent(evt))
+        return false;
+
+    if (decoder.getReadyNumber() >= ALL_TRANSACTIONS_CHUNK)
+        deliver( decoder.takeReady() );
+    return true;
+}
+
 bool TaskAllTransactions::processTask(const QVector<WEvent> & events) {
-    QString account;
-    int64_t height = -1;
-    QVector<WalletTransaction> trVector;
+    Q_UNUSED(events)
+    deliver( decoder.takeAll() );
+    return true;
+}
+
+void TaskAllTransactions::deliver(const QVector<WalletTransaction> & transactions) {
+    // Chunks are txIdx ordered and don't overlap, together they must start from fromIdx without gaps
+    if (indexed && !TransactionCache::isOffsetIndexed(nextIdx, transactions)) {
+        indexed = false;
+        wallet713->dropTransactionsIndex( decoder.getAccount(), fromIdx );
+    }
+    nextIdx += transactions.size();
 
-    parseTransactionsOutput(events, // in
-                            account, height, trVector); // out
+    if (allTransactions)
+        wallet713->processAllTransactionsAppend( decoder.getAccount(), decoder.getHeight(), transactions );
+    else
+        wallet713->updateCachedTransactions( decoder.getAccount(), decoder.getHeight(), transactions );
+}
 
-    wallet713->processAllTransactionsAppend( trVector );
+// ------------------------- TaskTransactionQuery ---------------------------
 
+bool TaskTransactionQuery::processTask(const QVector<WEvent> &events) {
+    Q_UNUSED(events)
+    wallet713->runTransactionQuery(requestId, account, query);
     return true;
 }
 
@@ -16,10 +16,118 @@
 #define MWC_QT_WALLET_TASKTRANSACTION_H
 
 #include "../mwc713task.h"
+#include "../wallet.h"
 #include "../../util/stringutils.h"
+#include <climits>
+#include <QMap>
 
 namespace wallet {
 
+// Streaming decoder for mwc713 tables ('txs', 'outputs'). Table is started with a title event
+// that has account and height, column layout is learned from the header line, rows are
+// decoded as they come. Raw lines are not stored.
+class TableDecoder {
+public:
+    TableDecoder(WALLET_EVENTS titleEvent);
+    virtual ~TableDecoder();
+
+    // Return true if event belongs to the table output and was consumed
+    bool processEvent(const WEvent & evt);
+
+    const QString & getAccount() const {return account;}
+    int64_t getHeight() const {return height;}
+
+protected:
+    // Return true if line is a header and layout was learned
+    virtual bool processHeader(const QString & line) = 0;
+    // Table row, except separators
+    virtual void processRow(const QString & line) = 0;
+
+private:
+    enum class STATE { TITLE, HEADER, SEPARATOR, ROWS };
+
+    const WALLET_EVENTS titleEvent;
+    STATE   state = STATE::TITLE;
+    QString account;
+    int64_t height = -1;
+};
+
+// 'txs' table decoder
+// Taken transactions are sorted by txIdx and unique, the later row with the same txIdx replaces the
+// previous one. Every take is sorted by itself. Row that comes after the taken ones can have a smaller
+// txIdx or repeat it, consumers merge the chunks by txIdx (see TransactionCache::update).
+class TransactionsDecoder : public TableDecoder {
+public:
+    TransactionsDecoder() : TableDecoder(WALLET_EVENTS::S_TRANSACTION_LOG) {}
+
+    // Number of decoded transactions that can be taken
+    int getReadyNumber() const { return transactions.size() - (transactions.contains(pendingId) ? 1 : 0); }
+    // Take decoded transactions. The last decoded one is held until the next row because
+    // the next line can mark it as cancelled.
+    QVector<WalletTransaction> takeReady();
+    // Table is finished, take the rest
+    QVector<WalletTransaction> takeAll();
+
+protected:
+    virtual bool processHeader(const QString & line) override;
+    virtual void processRow(const QString & line) override;
+
+private:
+    struct Layout {
+        int posId = -1;
+        int posType = -1;
+        int posTxid = -1;
+        int posAddress = -1;
+        int posCrTime = -1;
+        int posConf = -1;
+        int posHeight = -1;
+        int posConfTime = -1;
+        int posNetDiff = -1;
+        int posProof = -1;
+
+        bool isDefined() const {
+            return posId>=0 && posType>0 && posTxid>0 && posAddress>0 && posCrTime>0 &&
+                   posConf>0 && posHeight>0 && posConfTime>0 && posNetDiff>0 && posProof>0;
+        }
+    };
+
+    Layout layout;
+    QMap<int64_t, WalletTransaction> transactions; // by txIdx
+    int64_t pendingId = -1; // The last decoded transaction, it can be cancelled by the next line
+};
+
+// 'outputs' table decoder
+class OutputsDecoder : public TableDecoder {
+public:
+    OutputsDecoder() : TableDecoder(WALLET_EVENTS::S_OUTPUT_LOG) {}
+
+    QVector<WalletOutput> takeAll();
+
+protected:
+    virtual bool processHeader(const QString & line) override;
+    virtual void processRow(const QString & line) override;
+
+private:
+    struct Layout {
+        int outputCommitment = -1;
+        int mmrIndex = -1;
+        int blockHeight = -1;
+        int lockedUntil = -1;
+        int status = -1;
+        int coinbase = -1;
+        int confirms= -1;
+        int value = -1;
+        int tx = -1;
+
+        bool isDefined() const {
+            return outputCommitment>=0 && mmrIndex>0 && blockHeight>0 && lockedUntil>0 && status >0 && coinbase>0 && confirms>0 && value>0 && tx>0;
+        }
+    };
+
+    Layout layout;
+    QVector<WalletOutput> outputs;
+};
+
 class TaskOutputCount : public Mwc713Task {
 public:
     const static int64_t TIMEOUT = 1000*10;
@@ -32,6 +140,7 @@ public:
     virtual bool processTask(const QVector<WEvent> & events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual bool isPipelinable() const override {return true;}
 private:
     QString account;
 };
@@ -41,15 +150,24 @@ class TaskOutputs : public Mwc713Task {
 public:
     const static int64_t TIMEOUT = 1000*15;
 
-    TaskOutputs( MWC713 * wallet713, int offset, int number ) :
-            Mwc713Task("Outputs", "outputs -o " + QString::number(offset) + " -l " + QString::number(number), wallet713, "")
+    TaskOutputs( MWC713 * wallet713, int _offset, int number ) :
+            Mwc713Task("Outputs", "outputs -o " + QString::number(_offset) + " -l " + QString::number(number), wallet713, ""), offset(_offset), rows(number)
             { Q_ASSERT(offset>=0); Q_ASSERT(number>0);}
 
     virtual ~TaskOutputs() override {}
 
+    virtual int getExpectedRows() const override {return rows;}
+
+    virtual bool processStreamEvent(const WEvent & evt) override { return decoder.processEvent(evt); }
+
     virtual bool processTask(const QVector<WEvent> & events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual bool isPipelinable() const override {return true;}
+private:
+    OutputsDecoder decoder;
+    int offset;
+    int rows;
 };
 
 class TaskTransactionCount : public Mwc713Task {
@@ -64,6 +182,7 @@ public:
     virtual bool processTask(const QVector<WEvent> & events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual bool isPipelinable() const override {return true;}
 private:
     QString account;
 };
@@ -72,15 +191,28 @@ class TaskTransactions : public Mwc713Task {
 public:
     const static int64_t TIMEOUT = 1000*60;
 
-    TaskTransactions( MWC713 * wallet713, int offset, int number) :
-            Mwc713Task("Transactions", "txs -o " + QString::number(offset) + " -l " + QString::number(number), wallet713, "")
+    // offset, number - transactions to read. pageOffset, pageNumber - transactions that was requested, the rest is cached
+    TaskTransactions( MWC713 * wallet713, int _offset, int number, int _pageOffset, int _pageNumber) :
+            Mwc713Task("Transactions", "txs -o " + QString::number(_offset) + " -l " + QString::number(number), wallet713, ""), offset(_offset), rows(number),
+            pageOffset(_pageOffset), pageNumber(_pageNumber)
             { Q_ASSERT(offset>=0); Q_ASSERT(number>0);}
 
     virtual ~TaskTransactions() override {}
 
+    virtual int getExpectedRows() const override {return rows;}
+
+    virtual bool processStreamEvent(const WEvent & evt) override { return decoder.processEvent(evt); }
+
     virtual bool processTask(const QVector<WEvent> & events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual bool isPipelinable() const override {return true;}
+private:
+    TransactionsDecoder decoder;
+    int offset;
+    int rows;
+    int pageOffset;
+    int pageNumber;
 };
 
 // Just a callback, not a real task
@@ -106,14 +238,45 @@ class TaskAllTransactions : public Mwc713Task {
 public:
     const static int64_t TIMEOUT = 1000*180;
 
-    TaskAllTransactions( MWC713 * wallet713) :
-            Mwc713Task("Transactions", "txs", wallet713, "") {}
+    // Transactions before fromIdx are cached and final, no need to read them
+    // allTransactions - false if only the cache need to be updated, the result is not a part of the all transactions request
+    // Full read and tail read have different names, so they don't share the learned latency.
+    TaskAllTransactions( MWC713 * wallet713, int64_t _fromIdx, bool _allTransactions = true) :
+            Mwc713Task(_fromIdx>0 ? "TransactionsTail" : "AllTransactions", _fromIdx>0 ? "txs -o " + QString::number(_fromIdx) + " -l " + QString::number(INT_MAX) : QString("txs"), wallet713, ""),
+            allTransactions(_allTransactions), fromIdx(_fromIdx), nextIdx(_fromIdx) {}
 
     virtual ~TaskAllTransactions() override {}
 
+    // Decoded transactions are delivered to the wallet by chunks, before the command is finished
+    virtual bool processStreamEvent(const WEvent & evt) override;
+
     virtual bool processTask(const QVector<WEvent> & events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual bool isPipelinable() const override {return true;}
+private:
+    // Deliver decoded transactions to the wallet
+    void deliver(const QVector<WalletTransaction> & transactions);
+
+    TransactionsDecoder decoder;
+    bool allTransactions;
+    int64_t fromIdx;
+    int64_t nextIdx; // txIdx that the next delivered transaction expected to have
+    bool indexed = true;
+};
+
+// Run the history search when the transactions that was requested before are in the cache
+class TaskTransactionQuery : public Mwc713Task {
+public:
+    TaskTransactionQuery( MWC713 * wallet713, int64_t _requestId, QString _account, const TransactionQuery & _query ) :
+            Mwc713Task("TaskTransactionQuery", "", wallet713,""), requestId(_requestId), account(_account), query(_query) {}
+
+    virtual bool processTask(const QVector<WEvent> &events) override;
+    virtual QSet<WALLET_EVENTS> getReadyEvents() override {return QSet<WALLET_EVENTS>();}
+private:
+    int64_t requestId;
+    QString account;
+    TransactionQuery query;
 };
 
 
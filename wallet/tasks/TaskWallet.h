@@ -152,6 +152,7 @@ public:
     virtual bool processTask(const QVector<WEvent> & events) override;
 
     virtual QSet<WALLET_EVENTS> getReadyEvents() override {return { WALLET_EVENTS::S_READY };}
+    virtual bool isPipelinable() const override {return true;}
 };
 
 
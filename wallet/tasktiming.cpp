@@ -0,0 +1,131 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tasktiming.h"
+#include "../util/Trace.h"
+#include <QJsonArray>
+#include <algorithm>
+
+namespace wallet {
+
+// The same clock as trace, timelines go into the trace as they are
+int64_t TaskTimeline::now() {
+    return trace::now();
+}
+
+QString toString(TASK_STAGE stage) {
+    switch (stage) {
+        case TASK_STAGE::QUEUE:        return "queue";
+        case TASK_STAGE::FIRST_OUTPUT: return "first_output";
+        case TASK_STAGE::MWC713:       return "mwc713";
+        case TASK_STAGE::PROCESS:      return "process";
+        case TASK_STAGE::UI:           return "ui";
+        default: Q_ASSERT(false); return "Unknown";
+    }
+}
+
+void LatencyHistogram::add(int64_t timeUs) {
+    timeUs = std::max( int64_t(0), timeUs );
+    int b = 0;
+    while (b < BUCKETS-1 && (int64_t(1) << b) <= timeUs)
+        b++;
+    buckets[b]++;
+    count++;
+    total += timeUs;
+    maxTime = std::max(maxTime, timeUs);
+}
+
+int64_t LatencyHistogram::getPercentile(int percentile) const {
+    if (count==0)
+        return 0;
+
+    const int64_t limit = (count * percentile + 99) / 100;
+    int64_t sum = 0;
+    for (int b=0; b<BUCKETS; b++) {
+        sum += buckets[b];
+        if (sum >= limit)
+            return std::min( maxTime, int64_t(1) << b );
+    }
+    return maxTime;
+}
+
+QJsonObject LatencyHistogram::toJson() const {
+    QJsonObject res;
+    res["count"] = double(count);
+    res["total_us"] = double(total);
+    res["max_us"] = double(maxTime);
+    res["p50_us"] = double(getPercentile(50));
+    res["p95_us"] = double(getPercentile(95));
+
+    // Non empty buckets only, 'le_us' is the upper bound
+    QJsonArray hist;
+    for (int b=0; b<BUCKETS; b++) {
+        if (buckets[b]==0)
+            continue;
+        QJsonObject bucket;
+        bucket["le_us"] = double(int64_t(1) << b);
+        bucket["count"] = double(buckets[b]);
+        hist.append(bucket);
+    }
+    res["buckets"] = hist;
+    return res;
+}
+
+void TaskTimingStats::addTimeline(const QString & taskName, const TaskTimeline & tl) {
+    Stages & s = stats[taskName];
+
+    if (tl.enqueued>0 && tl.written>0)
+        s.stage[int(TASK_STAGE::QUEUE)].add(tl.written - tl.enqueued);
+    if (tl.written>0 && tl.firstOutput>0)
+        s.stage[int(TASK_STAGE::FIRST_OUTPUT)].add(tl.firstOutput - tl.written);
+    if (tl.written>0 && tl.ready>0)
+        s.stage[int(TASK_STAGE::MWC713)].add(tl.ready - tl.written);
+    if (tl.processStart>0 && tl.processEnd>0)
+        s.stage[int(TASK_STAGE::PROCESS)].add(tl.processEnd - tl.processStart);
+    if (tl.processEnd>0 && tl.delivered>0)
+        s.stage[int(TASK_STAGE::UI)].add(tl.delivered - tl.processEnd);
+}
+
+QJsonObject TaskTimingStats::toJson() const {
+    QJsonObject res;
+    for (auto it = stats.begin(); it != stats.end(); it++) {
+        QJsonObject task;
+        for (int st=0; st<TASK_STAGE_NUM; st++)
+            task[ wallet::toString(TASK_STAGE(st)) ] = it.value().stage[st].toJson();
+        res[it.key()] = task;
+    }
+    return res;
+}
+
+QString TaskTimingStats::toString() const {
+    QString res = QString("%1 %2").arg("Task", -28).arg("Stage", -13) +
+                  QString("%1 %2 %3 %4\n").arg("Count", 8).arg("Avg", 10).arg("P95", 10).arg("Max", 10);
+
+    for (auto it = stats.begin(); it != stats.end(); it++) {
+        for (int st=0; st<TASK_STAGE_NUM; st++) {
+            const LatencyHistogram & h = it.value().stage[st];
+            if (h.getCount()==0)
+                continue;
+
+            res += QString("%1 %2").arg(it.key(), -28).arg(wallet::toString(TASK_STAGE(st)), -13) +
+                   QString("%1 %2 %3 %4\n").arg(h.getCount(), 8)
+                           .arg(h.getTotal() / h.getCount() / 1000.0, 10, 'f', 1)
+                           .arg(h.getPercentile(95) / 1000.0, 10, 'f', 1)
+                           .arg(h.getMax() / 1000.0, 10, 'f', 1);
+        }
+    }
+    return res;
+}
+
+}
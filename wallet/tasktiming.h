@@ -0,0 +1,90 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MWC_QT_WALLET_TASKTIMING_H
+#define MWC_QT_WALLET_TASKTIMING_H
+
+#include <QString>
+#include <QMap>
+#include <QJsonObject>
+
+namespace wallet {
+
+// Time points of the task life, microseconds from TaskTimeline::now(). 0 - didn't happen
+struct TaskTimeline {
+    int64_t enqueued = 0;     // addTask
+    int64_t written = 0;      // command is written into mwc713
+    int64_t firstOutput = 0;  // mwc713 output with the first task event was read, before the parser and events queue
+    int64_t ready = 0;        // ready event
+    int64_t processStart = 0; // processTask start
+    int64_t processEnd = 0;   // processTask end. Directly connected slots are done
+    int64_t delivered = 0;    // Queued signals from processTask are delivered
+
+    // Monotonic time, microseconds. Never 0
+    static int64_t now();
+};
+
+// Stages of the task life, every one has own histogram
+enum class TASK_STAGE {
+    QUEUE = 0,        // enqueued -> written
+    FIRST_OUTPUT = 1, // written -> firstOutput
+    MWC713 = 2,       // written -> ready
+    PROCESS = 3,      // processStart -> processEnd
+    UI = 4            // processEnd -> delivered
+};
+const int TASK_STAGE_NUM = 5;
+QString toString(TASK_STAGE stage);
+
+// Histogram with power of 2 buckets. Bucket 0: <1 us, bucket i: [2^(i-1), 2^i) us
+class LatencyHistogram {
+public:
+    static const int BUCKETS = 40;
+
+    void add(int64_t timeUs);
+
+    int64_t getCount() const {return count;}
+    int64_t getTotal() const {return total;}
+    int64_t getMax() const {return maxTime;}
+    // Upper bound of the bucket with the percentile, us
+    int64_t getPercentile(int percentile) const;
+
+    QJsonObject toJson() const;
+private:
+    int64_t buckets[BUCKETS] = {};
+    int64_t count = 0;
+    int64_t total = 0;
+    int64_t maxTime = 0;
+};
+
+// Timing histograms per task name
+class TaskTimingStats {
+public:
+    void addTimeline(const QString & taskName, const TaskTimeline & timeline);
+    void reset() { stats.clear(); }
+
+    bool isEmpty() const {return stats.isEmpty();}
+
+    QJsonObject toJson() const;
+    // Table for the diagnostics window. Times are in ms
+    QString toString() const;
+private:
+    struct Stages {
+        LatencyHistogram stage[TASK_STAGE_NUM];
+    };
+    QMap<QString, Stages> stats;
+};
+
+}
+
+#endif //MWC_QT_WALLET_TASKTIMING_H
@@ -0,0 +1,282 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "txcache.h"
+#include <QDataStream>
+#include <QFile>
+#include <QDir>
+#include <QCryptographicHash>
+#include <QDebug>
+#include <algorithm>
+#include "../util/ioutils.h"
+
+namespace wallet {
+
+void TransactionCache::setWallet(const QString & walletDataPath) {
+    QString key = QCryptographicHash::hash( walletDataPath.toUtf8(), QCryptographicHash::Sha1 ).toHex().left(16);
+    if (key == walletKey)
+        return;
+
+    save();
+    accounts.clear();
+    walletKey = key;
+}
+
+void TransactionCache::save() {
+    if (walletKey.isEmpty())
+        return;
+
+    for (auto it = accounts.begin(); it != accounts.end(); it++) {
+        if (!it.value().dirty || !it.value().indexed)
+            continue;
+
+        // Cache is not critical, no reasons to bother user with error
+        QFile file( getFileName(it.key()) );
+        if (!file.open(QIODevice::WriteOnly)) {
+            qDebug() << "Unable to save transactions cache to " << file.fileName() << " Error: " << file.errorString();
+            continue;
+        }
+
+        QDataStream out(&file);
+        out.setVersion(QDataStream::Qt_5_7);
+        saveData(out, it.key());
+        it.value().dirty = false;
+    }
+}
+
+void TransactionCache::clear() {
+    accounts.clear();
+    if (walletKey.isEmpty())
+        return;
+
+    QDir dir( ioutils::getAppDataPath("txcache/" + walletKey) );
+    for (const QString & fn : dir.entryList( {"*.dat"}, QDir::Files ))
+        dir.remove(fn);
+}
+
+void TransactionCache::renameAccount(const QString & oldName, const QString & newName) {
+    if (oldName == newName)
+        return;
+
+    AccountTransactions acc = getAccount(oldName);
+    accounts.remove(oldName);
+    accounts.remove(newName);
+
+    if (!walletKey.isEmpty()) {
+        QFile::remove( getFileName(oldName) );
+        QFile::remove( getFileName(newName) );
+    }
+
+    // File has the account name inside, so it is written again
+    acc.dirty = true;
+    acc.revision = ++lastRevision;
+    accounts[newName] = acc;
+}
+
+bool TransactionCache::isOffsetIndexed(int64_t offset, const QVector<WalletTransaction> & transactions) {
+    for (int i=0; i<transactions.size(); i++) {
+        if (transactions[i].txIdx != offset+i)
+            return false;
+    }
+    return true;
+}
+
+void TransactionCache::dropIndex(const QString & account) {
+    AccountTransactions & acc = getAccount(account);
+    if (!acc.indexed)
+        return;
+
+    acc.indexed = false;
+    acc.dirty = false;
+    acc.revision = ++lastRevision;
+    if (!walletKey.isEmpty())
+        QFile::remove( getFileName(account) );
+}
+
+bool TransactionCache::isIndexed(const QString & account) {
+    return getAccount(account).indexed;
+}
+
+void TransactionCache::setCount(const QString & account, int count) {
+    getAccount(account).count = count;
+}
+
+int TransactionCache::getCount(const QString & account) {
+    return getAccount(account).count;
+}
+
+int64_t TransactionCache::getRefreshStart(const QString & account, int64_t offset, int64_t number) {
+    AccountTransactions & acc = getAccount(account);
+    if (!acc.indexed)
+        return offset;
+    int64_t end = offset + number;
+    if (acc.count>=0)
+        end = std::min(end, int64_t(acc.count));
+
+    for (int64_t idx = offset; idx<end; idx++) {
+        auto it = acc.transactions.find(idx);
+        if (it == acc.transactions.end() || !it.value().isFinal())
+            return idx;
+    }
+    // Count is not known, new transactions might be there
+    if (acc.count<0)
+        return offset;
+    return -1;
+}
+
+int64_t TransactionCache::getAllRefreshStart(const QString & account) {
+    AccountTransactions & acc = getAccount(account);
+    if (!acc.indexed)
+        return 0;
+    int64_t idx = 0;
+    for (auto it = acc.transactions.begin(); it != acc.transactions.end(); it++, idx++) {
+        if (it.key() != idx || !it.value().isFinal())
+            break;
+    }
+    return idx;
+}
+
+bool TransactionCache::hasRange(const QString & account, int64_t offset, int64_t number) {
+    AccountTransactions & acc = getAccount(account);
+    if (acc.count<0 || !acc.indexed)
+        return false;
+    int64_t end = std::min(offset + number, int64_t(acc.count));
+    for (int64_t idx = offset; idx<end; idx++) {
+        if (!acc.transactions.contains(idx))
+            return false;
+    }
+    return true;
+}
+
+QVector<WalletTransaction> TransactionCache::getRange(const QString & account, int64_t offset, int64_t number) {
+    AccountTransactions & acc = getAccount(account);
+    QVector<WalletTransaction> res;
+    for ( auto it = acc.transactions.lowerBound(offset); it!=acc.transactions.end() && it.key() < offset+number; it++ )
+        res.push_back(it.value());
+    return res;
+}
+
+QVector<WalletTransaction> TransactionCache::getAll(const QString & account) {
+    AccountTransactions & acc = getAccount(account);
+    QVector<WalletTransaction> res;
+    res.reserve(acc.transactions.size());
+    for ( auto it = acc.transactions.begin(); it!=acc.transactions.end(); it++ )
+        res.push_back(it.value());
+    return res;
+}
+
+int64_t TransactionCache::getHeight(const QString & account) {
+    return getAccount(account).height;
+}
+
+int64_t TransactionCache::getRevision(const QString & account) {
+    return getAccount(account).revision;
+}
+
+void TransactionCache::update(const QString & account, int64_t height, const QVector<WalletTransaction> & transactions) {
+    AccountTransactions & acc = getAccount(account);
+    bool changed = false;
+    for (const auto & tx : transactions) {
+        if (!tx.isValid())
+            continue;
+        auto it = acc.transactions.find(tx.txIdx);
+        if (it == acc.transactions.end()) {
+            acc.transactions.insert(tx.txIdx, tx);
+            changed = true;
+        }
+        else if (!it.value().isSame(tx)) {
+            it.value() = tx;
+            changed = true;
+        }
+    }
+    if (changed)
+        acc.revision = ++lastRevision;
+    if (height>0)
+        acc.height = height;
+    acc.dirty = true;
+}
+
+void TransactionCache::saveData(QDataStream & out, const QString & account) const {
+    auto it = accounts.find(account);
+    out << int(0x7A32);
+    out << account;
+    if (it == accounts.end()) {
+        out << qint64(-1);
+        out << int(0);
+        return;
+    }
+    out << qint64(it.value().height);
+    out << int(it.value().transactions.size());
+    for (const auto & tx : it.value().transactions)
+        tx.saveData(out);
+}
+
+bool TransactionCache::loadData(QDataStream & in, const QString & account) {
+    AccountTransactions acc;
+
+    int id = 0;
+    in >> id;
+    if ( id!=0x7A32 )
+        return false;
+
+    QString name;
+    qint64 height = -1;
+    int sz = 0;
+    in >> name;
+    in >> height;
+    in >> sz;
+    if (in.status() != QDataStream::Ok || name != account || sz<0)
+        return false;
+
+    for (int i=0; i<sz; i++) {
+        WalletTransaction tx;
+        if (!tx.loadData(in) || !tx.isValid())
+            return false;
+        acc.transactions[tx.txIdx] = tx;
+    }
+    acc.height = height;
+    acc.count = accounts.value(account).count;
+    accounts[account] = acc;
+    return true;
+}
+
+TransactionCache::AccountTransactions & TransactionCache::getAccount(const QString & account) {
+    auto it = accounts.find(account);
+    if (it != accounts.end())
+        return it.value();
+
+    accounts[account] = AccountTransactions();
+
+    if (!walletKey.isEmpty()) {
+        QFile file( getFileName(account) );
+        if ( file.open(QIODevice::ReadOnly) ) {
+            QDataStream in(&file);
+            in.setVersion(QDataStream::Qt_5_7);
+            if (!loadData(in, account)) {
+                // Broken or old cache, will be read from mwc713 again
+                qDebug() << "Transactions cache " << file.fileName() << " is not valid, ignoring it";
+                accounts[account] = AccountTransactions();
+            }
+        }
+    }
+    AccountTransactions & acc = accounts[account];
+    acc.revision = ++lastRevision;
+    return acc;
+}
+
+QString TransactionCache::getFileName(const QString & account) const {
+    // Account name can have any symbols
+    return ioutils::getAppDataPath("txcache/" + walletKey) + "/" + QString(account.toUtf8().toHex()) + ".dat";
+}
+
+}
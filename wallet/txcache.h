@@ -0,0 +1,98 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef MWC_QT_WALLET_TXCACHE_H
+#define MWC_QT_WALLET_TXCACHE_H
+
+#include <QString>
+#include <QMap>
+#include "wallet.h"
+
+class QDataStream;
+
+namespace wallet {
+
+// Transactions that was read from mwc713, per account, indexed by txIdx. Stored on disk per wallet.
+// Confirmed and cancelled transactions are final, they are never requested from mwc713 again.
+// Everything else, plus transactions that we don't have yet, is refreshed.
+// Ranges are in txIdx. It works because mwc713 'txs -o offset' row offset is equal to txIdx: ids start
+// from 0, go without gaps and transactions are never deleted. Every read checks that with isOffsetIndexed,
+// the account that doesn't match goes to the unindexed mode, see dropIndex.
+class TransactionCache {
+public:
+    // walletDataPath identify the wallet. Data for the previous wallet is saved.
+    void setWallet(const QString & walletDataPath);
+    // Save modified accounts
+    void save();
+    // Wallet data is changed (new seed, resync). Drop everything for the current wallet
+    void clear();
+    // Account was renamed, its history is moved to the new name. Cached data for newName belongs
+    // to another account that had this name before, it is dropped.
+    void renameAccount(const QString & oldName, const QString & newName);
+
+    // Return true if transactions that was read with 'txs -o offset' have txIdx offset, offset+1, ...
+    static bool isOffsetIndexed(int64_t offset, const QVector<WalletTransaction> & transactions);
+    // mwc713 rows don't match txIdx for the account. Its file is deleted, nothing is stored for the rest of
+    // the session and ranges are never served from the cache: every read goes to mwc713 from the start.
+    // Transactions are still collected in memory by their txIdx for the search and the all transactions view.
+    void dropIndex(const QString & account);
+    bool isIndexed(const QString & account);
+
+    // Transaction count that mwc713 reported. -1 if not known
+    void setCount(const QString & account, int count);
+    int getCount(const QString & account);
+
+    // First txIdx in the range [offset, offset+number) that need to be requested from mwc713.
+    // -1 if all transactions in the range are cached and final. Range is limited by the count if it is known.
+    int64_t getRefreshStart(const QString & account, int64_t offset, int64_t number);
+    // First txIdx for the whole history refresh. Everything before is cached and final
+    int64_t getAllRefreshStart(const QString & account);
+
+    // Return true if every transaction in the range is cached
+    bool hasRange(const QString & account, int64_t offset, int64_t number);
+    // Cached transactions in the range, sorted by txIdx
+    QVector<WalletTransaction> getRange(const QString & account, int64_t offset, int64_t number);
+    QVector<WalletTransaction> getAll(const QString & account);
+    // Height of the last update
+    int64_t getHeight(const QString & account);
+    // Changed when the account transactions are changed. Never repeats, so it identify the data snapshot
+    int64_t getRevision(const QString & account);
+
+    // Transactions from mwc713
+    void update(const QString & account, int64_t height, const QVector<WalletTransaction> & transactions);
+
+    void saveData(QDataStream & out, const QString & account) const;
+    bool loadData(QDataStream & in, const QString & account);
+
+private:
+    struct AccountTransactions {
+        QMap<int64_t, WalletTransaction> transactions;
+        int64_t height = -1;
+        int     count = -1; // not stored, mwc713 need to be asked every session
+        bool    dirty = false;
+        int64_t revision = 0;
+        bool    indexed = true; // false - row offset is not txIdx, see dropIndex
+    };
+
+    // Load from the disk at first access
+    AccountTransactions & getAccount(const QString & account);
+    QString getFileName(const QString & account) const;
+
+    QString walletKey; // Empty if wallet is not set, nothing is stored
+    QMap<QString, AccountTransactions> accounts;
+    int64_t lastRevision = 0;
+};
+
+}
+
+#endif //MWC_QT_WALLET_TXCACHE_H
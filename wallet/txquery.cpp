@@ -0,0 +1,264 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "txquery.h"
+#include <QThread>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <algorithm>
+
+namespace wallet {
+
+// ------------------------------------ TransactionIndex -------------------------------------------
+
+// Rows [from,to) of the index
+struct IndexRange {
+    const QVector<int> * rows = nullptr;
+    int from = 0;
+    int to = 0;
+
+    int size() const {return to-from;}
+};
+
+TransactionIndex::TransactionIndex(const TransactionColumns & _transactions) :
+    transactions(_transactions)
+{
+    const int sz = transactions.size();
+
+    txids.resize(sz);
+    amounts.resize(sz);
+    byTxid.reserve(sz);
+    for (int r=0; r<sz; r++) {
+        TransactionColumns::Row tx = transactions[r];
+
+        QString address = tx.address();
+        if (!address.isEmpty())
+            byAddress[address].push_back(r);
+
+        txids[r] = tx.txid().toLower();
+        amounts[r] = std::abs(tx.coinNano());
+
+        if (tx.confirmed())
+            confirmedRows.push_back(r);
+        else
+            unconfirmedRows.push_back(r);
+
+        uint type = tx.transactionType();
+        for (uint bit : {uint(WalletTransaction::TRANSACTION_TYPE::SEND), uint(WalletTransaction::TRANSACTION_TYPE::RECEIVE), uint(WalletTransaction::TRANSACTION_TYPE::CANCELLED)}) {
+            if (type & bit)
+                byType[bit].push_back(r);
+        }
+        byTxid.push_back(r);
+    }
+
+    std::sort(byTxid.begin(), byTxid.end(), [this](int a, int b) { return txids[a] < txids[b]; } );
+
+    byAmount = byTxid; // any permutation
+    std::sort(byAmount.begin(), byAmount.end(), [this](int a, int b) { return amounts[a] < amounts[b] || (amounts[a]==amounts[b] && a<b); } );
+
+    byTime = byAmount;
+    std::sort(byTime.begin(), byTime.end(), [this](int a, int b) {
+        int64_t ta = transactions[a].creationTimeMs();
+        int64_t tb = transactions[b].creationTimeMs();
+        return ta < tb || (ta==tb && a<b);
+    } );
+}
+
+QVector<int> TransactionIndex::candidates(const TransactionQuery & q) const {
+    QVector<IndexRange> ranges;
+
+    static const QVector<int> empty;
+    if (!q.address.isEmpty()) {
+        auto it = byAddress.find(q.address);
+        const QVector<int> & rows = it==byAddress.end() ? empty : it.value();
+        ranges.push_back( IndexRange{&rows, 0, rows.size()} );
+    }
+
+    if (!q.txidPrefix.isEmpty()) {
+        auto from = std::lower_bound(byTxid.begin(), byTxid.end(), q.txidPrefix,
+                                     [this](int r, const QString & prefix) { return txids[r] < prefix; } );
+        auto to = from;
+        while (to!=byTxid.end() && txids[*to].startsWith(q.txidPrefix))
+            to++;
+        ranges.push_back( IndexRange{&byTxid, int(from-byTxid.begin()), int(to-byTxid.begin())} );
+    }
+
+    if (q.minAmountNano>0 || q.maxAmountNano>=0) {
+        auto from = std::lower_bound(byAmount.begin(), byAmount.end(), q.minAmountNano,
+                                     [this](int r, int64_t v) { return amounts[r] < v; } );
+        auto to = q.maxAmountNano<0 ? byAmount.end() : std::upper_bound(from, byAmount.end(), q.maxAmountNano,
+                                     [this](int64_t v, int r) { return v < amounts[r]; } );
+        ranges.push_back( IndexRange{&byAmount, int(from-byAmount.begin()), int(to-byAmount.begin())} );
+    }
+
+    if (q.fromTimeMs>0 || q.toTimeMs>0) {
+        auto from = std::lower_bound(byTime.begin(), byTime.end(), q.fromTimeMs,
+                                     [this](int r, int64_t v) { return transactions[r].creationTimeMs() < v; } );
+        auto to = q.toTimeMs<=0 ? byTime.end() : std::lower_bound(from, byTime.end(), q.toTimeMs,
+                                     [this](int r, int64_t v) { return transactions[r].creationTimeMs() < v; } );
+        ranges.push_back( IndexRange{&byTime, int(from-byTime.begin()), int(to-byTime.begin())} );
+    }
+
+    if (q.confirmed == TransactionQuery::CONFIRMED::YES)
+        ranges.push_back( IndexRange{&confirmedRows, 0, confirmedRows.size()} );
+    else if (q.confirmed == TransactionQuery::CONFIRMED::NO)
+        ranges.push_back( IndexRange{&unconfirmedRows, 0, unconfirmedRows.size()} );
+
+    for (auto it = byType.begin(); it != byType.end(); it++) {
+        if (q.typeMask & it.key())
+            ranges.push_back( IndexRange{&it.value(), 0, it.value().size()} );
+    }
+    if ( (q.typeMask & ~(uint(WalletTransaction::TRANSACTION_TYPE::SEND) | uint(WalletTransaction::TRANSACTION_TYPE::RECEIVE) | uint(WalletTransaction::TRANSACTION_TYPE::CANCELLED))) != 0 ||
+         (q.typeMask!=0 && ranges.isEmpty()) )
+        return QVector<int>(); // Nobody has such type
+
+    QVector<int> res;
+    if (ranges.isEmpty()) {
+        res.resize(transactions.size());
+        for (int r=0; r<res.size(); r++)
+            res[r] = r;
+        return res;
+    }
+
+    const IndexRange * best = &ranges[0];
+    for (const IndexRange & r : ranges) {
+        if (r.size() < best->size())
+            best = &r;
+    }
+    res.reserve(best->size());
+    for (int i=best->from; i<best->to; i++)
+        res.push_back( (*best->rows)[i] );
+    return res;
+}
+
+bool TransactionIndex::matches(int row, const TransactionQuery & q) const {
+    TransactionColumns::Row tx = transactions[row];
+
+    if ( !q.address.isEmpty() && tx.address() != q.address )
+        return false;
+    if ( !q.txidPrefix.isEmpty() && !txids[row].startsWith(q.txidPrefix) )
+        return false;
+    if ( amounts[row] < q.minAmountNano || (q.maxAmountNano>=0 && amounts[row] > q.maxAmountNano) )
+        return false;
+    if ( (q.fromTimeMs>0 && tx.creationTimeMs() < q.fromTimeMs) || (q.toTimeMs>0 && tx.creationTimeMs() >= q.toTimeMs) )
+        return false;
+    if ( (q.confirmed == TransactionQuery::CONFIRMED::YES && !tx.confirmed()) || (q.confirmed == TransactionQuery::CONFIRMED::NO && tx.confirmed()) )
+        return false;
+    if ( (tx.transactionType() & q.typeMask) != q.typeMask )
+        return false;
+    return true;
+}
+
+QVector<int> TransactionIndex::select(const TransactionQuery & query) const {
+    QVector<int> rows = candidates(query);
+
+    // Candidates from one index, checking all conditions
+    int sz = 0;
+    for (int r : rows) {
+        if (matches(r, query))
+            rows[sz++] = r;
+    }
+    rows.resize(sz);
+
+    auto key = [this, &query](int r) -> int64_t {
+        switch (query.sort) {
+        case TransactionQuery::SORT::TIME:   return transactions[r].creationTimeMs();
+        case TransactionQuery::SORT::AMOUNT: return amounts[r];
+        default:                             return transactions[r].txIdx();
+        }
+    };
+
+    const bool desc = query.descending;
+    std::sort(rows.begin(), rows.end(), [&key, desc](int a, int b) {
+        int64_t ka = key(a);
+        int64_t kb = key(b);
+        if (ka!=kb)
+            return desc ? ka > kb : ka < kb;
+        return desc ? a > b : a < b;
+    } );
+    return rows;
+}
+
+// ------------------------------------ TransactionQueryWorker -------------------------------------------
+
+TransactionQueryWorker::TransactionQueryWorker(TransactionQueryThread * _owner) :
+    owner(_owner)
+{
+}
+
+void TransactionQueryWorker::onQuery(int64_t requestId, QString account, int64_t revision, QVector<WalletTransaction> transactions, TransactionQuery query) {
+    // Index is updated even for obsolete request, the sender will not send this revision again
+    AccountIndex & acc = indexes[account];
+    if (acc.revision != revision) {
+        QElapsedTimer timer;
+        timer.start();
+        acc.index = TransactionIndex( TransactionColumns::fromVector(transactions) );
+        acc.revision = revision;
+        qDebug() << "Transactions index for account " << account << " is built for " << transactions.size() << " records in " << timer.elapsed() << " ms";
+    }
+
+    if (owner->isObsolete(requestId))
+        return;
+
+    QVector<int> rows = acc.index.select(query);
+    const TransactionColumns & txs = acc.index.getTransactions();
+
+    const int total = rows.size();
+    const int from = std::min(std::max(0, query.offset), total);
+    const int to = int( std::min( int64_t(from) + std::max(0, query.number), int64_t(total) ) );
+
+    // Streaming the page by chunks. Newer request stops it.
+    int pos = from;
+    do {
+        const int chunkEnd = std::min(pos + TransactionQueryThread::RESULT_CHUNK, to);
+        TransactionColumns chunk;
+        chunk.reserve(chunkEnd-pos);
+        for (int i=pos; i<chunkEnd; i++)
+            chunk.append(txs, rows[i]);
+
+        if (owner->isObsolete(requestId))
+            return;
+
+        emit owner->sgResult(requestId, account, total, pos, chunk, chunkEnd>=to);
+        pos = chunkEnd;
+    } while (pos<to);
+}
+
+// ------------------------------------ TransactionQueryThread -------------------------------------------
+
+TransactionQueryThread::TransactionQueryThread() {
+    thread = new QThread();
+    thread->setObjectName("transactions query");
+
+    worker = new TransactionQueryWorker(this);
+    worker->moveToThread(thread);
+    connect( this, &TransactionQueryThread::sgQuery, worker, &TransactionQueryWorker::onQuery, Qt::QueuedConnection );
+
+    thread->start();
+}
+
+TransactionQueryThread::~TransactionQueryThread() {
+    lastRequestId.store(-1);
+    thread->quit();
+    thread->wait();
+
+    delete worker;
+    delete thread;
+}
+
+void TransactionQueryThread::query(int64_t requestId, const QString & account, int64_t revision, const QVector<WalletTransaction> & transactions, const TransactionQuery & query) {
+    lastRequestId.store(requestId);
+    emit sgQuery(requestId, account, revision, transactions, query);
+}
+
+}
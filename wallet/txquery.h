@@ -0,0 +1,115 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef MWC_QT_WALLET_TXQUERY_H
+#define MWC_QT_WALLET_TXQUERY_H
+
+#include <QObject>
+#include <QMap>
+#include <atomic>
+#include "wallet.h"
+
+class QThread;
+
+namespace wallet {
+
+// Secondary indexes over the transactions snapshot. Index is immutable, build it again for the new data.
+class TransactionIndex {
+public:
+    TransactionIndex() {}
+    explicit TransactionIndex(const TransactionColumns & transactions);
+
+    const TransactionColumns & getTransactions() const {return transactions;}
+
+    // Rows of all matching transactions, sorted as the query requests
+    QVector<int> select(const TransactionQuery & query) const;
+
+private:
+    // Rows that have a chance to match. The smallest index range is taken, the rest of conditions are checked by matches
+    QVector<int> candidates(const TransactionQuery & query) const;
+    bool matches(int row, const TransactionQuery & query) const;
+
+    TransactionColumns transactions;
+
+    QHash<QString, QVector<int>> byAddress;
+    QVector<int>                 byTxid;    // rows sorted by txid
+    QVector<QString>             txids;     // by row, lower case
+    QVector<int64_t>             amounts;   // by row, absolute value
+    QVector<int>                 byAmount;  // rows sorted by amount
+    QVector<int>                 byTime;    // rows sorted by creation time
+    QVector<int>                 confirmedRows;
+    QVector<int>                 unconfirmedRows;
+    QMap<uint, QVector<int>>     byType;    // by TRANSACTION_TYPE bit
+};
+
+class TransactionQueryThread;
+
+// Lives in the query thread. Keeps the index for every account until the data revision is changed.
+class TransactionQueryWorker : public QObject {
+    Q_OBJECT
+public:
+    TransactionQueryWorker(TransactionQueryThread * owner);
+    virtual ~TransactionQueryWorker() override {}
+
+public slots:
+    void onQuery(int64_t requestId, QString account, int64_t revision, QVector<WalletTransaction> transactions, TransactionQuery query);
+
+private:
+    struct AccountIndex {
+        int64_t revision = -1;
+        TransactionIndex index;
+    };
+
+    TransactionQueryThread * owner;
+    QMap<QString, AccountIndex> indexes;
+};
+
+// Transactions history search in a dedicated thread, GUI thread only sends the requests.
+// Only the latest request is processed, the queued and running older ones are dropped.
+class TransactionQueryThread : public QObject {
+    Q_OBJECT
+    friend class TransactionQueryWorker;
+public:
+    // Results are delivered by chunks of this size
+    static const int RESULT_CHUNK = 100;
+
+    TransactionQueryThread();
+    // Stop the thread, the running query is abandoned
+    virtual ~TransactionQueryThread() override;
+
+    TransactionQueryThread(const TransactionQueryThread & ) = delete;
+    TransactionQueryThread & operator=(const TransactionQueryThread & ) = delete;
+
+    // transactions - the account history for this revision. Can be empty if the same revision was sent before.
+    void query(int64_t requestId, const QString & account, int64_t revision, const QVector<WalletTransaction> & transactions, const TransactionQuery & query);
+
+signals:
+    // Emitted from the query thread
+    void sgResult(int64_t requestId, QString account, int total, int offset, TransactionColumns transactions, bool last);
+
+    // Data for the worker
+    void sgQuery(int64_t requestId, QString account, int64_t revision, QVector<WalletTransaction> transactions, TransactionQuery query);
+
+private:
+    bool isObsolete(int64_t requestId) const { return requestId != lastRequestId.load(); }
+
+private:
+    QThread * thread = nullptr;
+    TransactionQueryWorker * worker = nullptr;
+
+    std::atomic<int64_t> lastRequestId{-1};
+};
+
+}
+
+#endif //MWC_QT_WALLET_TXQUERY_H
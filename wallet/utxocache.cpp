@@ -0,0 +1,101 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "utxocache.h"
+
+namespace wallet {
+
+WalletOutputsDiff UtxoCache::applyPage(const QString & account, int64_t height, int offset, int number, const QVector<WalletOutput> & outputs) {
+    WalletOutputsDiff diff;
+    diff.account = account;
+    diff.height = height;
+    diff.offset = offset;
+    diff.number = number;
+
+    AccountOutputs & acc = accounts[account];
+
+    QSet<QString> pageCommitments;
+    for (int i=0; i<outputs.size(); i++) {
+        const WalletOutput & out = outputs[i];
+        pageCommitments.insert(out.outputCommitment);
+
+        auto it = acc.outputs.find(out.outputCommitment);
+        if (it == acc.outputs.end()) {
+            diff.added.push_back(out);
+            acc.outputs.insert(out.outputCommitment, out);
+        }
+        else if (!it.value().isSameState(out)) {
+            diff.changed.push_back(out);
+            it.value() = out;
+        }
+        acc.positions[out.outputCommitment] = offset + i;
+    }
+
+    // Was at this page, but not any more. Spent, or moved to another page because of that
+    for (auto it = acc.positions.begin(); it != acc.positions.end(); ) {
+        if (it.value() >= offset && it.value() < offset+number && !pageCommitments.contains(it.key())) {
+            diff.removed.push_back(it.key());
+            acc.outputs.remove(it.key());
+            it = acc.positions.erase(it);
+        }
+        else {
+            it++;
+        }
+    }
+
+    return diff;
+}
+
+void UtxoCache::setLastPage(const QString & account, int offset, int number) {
+    lastAccount = account;
+    lastOffset = offset;
+    lastNumber = number;
+}
+
+bool UtxoCache::getLastPage(QString & account, int & offset, int & number) const {
+    if (lastOffset<0)
+        return false;
+    account = lastAccount;
+    offset = lastOffset;
+    number = lastNumber;
+    return true;
+}
+
+void UtxoCache::resetLastPage() {
+    lastAccount = "";
+    lastOffset = -1;
+    lastNumber = 0;
+}
+
+const WalletOutput * UtxoCache::getOutput(const QString & account, const QString & commitment) const {
+    auto acc = accounts.find(account);
+    if (acc == accounts.end())
+        return nullptr;
+    auto it = acc.value().outputs.find(commitment);
+    if (it == acc.value().outputs.end())
+        return nullptr;
+    return &it.value();
+}
+
+int UtxoCache::getSize(const QString & account) const {
+    return accounts.value(account).outputs.size();
+}
+
+void UtxoCache::clear() {
+    accounts.clear();
+    lastAccount = "";
+    lastOffset = -1;
+    lastNumber = 0;
+}
+
+}
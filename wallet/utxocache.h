@@ -0,0 +1,61 @@
+// Copyright 2019 The MWC Developers
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef MWC_QT_WALLET_UTXOCACHE_H
+#define MWC_QT_WALLET_UTXOCACHE_H
+
+#include <QString>
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include "wallet.h"
+
+namespace wallet {
+
+// Outputs that was read from mwc713, per account, keyed by commitment. Pages of 'outputs' are applied
+// as they come, result is the difference with the previous state, so the views can update only
+// the changed rows. Outputs that was at the page position and not there any more are removed (spent).
+class UtxoCache {
+public:
+    // Apply the page [offset, offset+number) that was read from mwc713.
+    WalletOutputsDiff applyPage(const QString & account, int64_t height, int offset, int number, const QVector<WalletOutput> & outputs);
+
+    // Page that was requested the last time, it is the one that is refreshed on the wallet events.
+    void setLastPage(const QString & account, int offset, int number);
+    // Return false if no pages was requested
+    bool getLastPage(QString & account, int & offset, int & number) const;
+    // Nobody is looking at the outputs, nothing to refresh
+    void resetLastPage();
+
+    // Output by commitment, nullptr if it is not cached
+    const WalletOutput * getOutput(const QString & account, const QString & commitment) const;
+    int getSize(const QString & account) const;
+
+    void clear();
+
+private:
+    struct AccountOutputs {
+        QHash<QString, WalletOutput> outputs;
+        QHash<QString, int> positions; // position at the last read page
+    };
+
+    QMap<QString, AccountOutputs> accounts;
+
+    QString lastAccount;
+    int lastOffset = -1;
+    int lastNumber = 0;
+};
+
+}
+
+#endif //MWC_QT_WALLET_UTXOCACHE_H
@@ -158,10 +158,10 @@ void WalletTransaction::setData(int64_t _txIdx,
     uint    _transactionType,
     QString _txid,
     QString _address,
-    QString _creationTime,
+    int64_t _creationTimeMs,
     bool    _confirmed,
     int64_t _height,
-    QString _confirmationTime,
+    int64_t _confirmationTimeMs,
     int64_t    _coinNano,
     bool    _proof)
 {
@@ -169,31 +169,70 @@ void WalletTransaction::setData(int64_t _txIdx,
     transactionType = _transactionType;
     txid = _txid;
     address = _address;
-    creationTime = util::mwc713time2ThisTime(_creationTime);
+    creationTimeMs = _creationTimeMs;
     confirmed = _confirmed;
     height = _height;
-    confirmationTime = util::mwc713time2ThisTime(_confirmationTime);
+    confirmationTimeMs = _confirmationTimeMs;
     coinNano = _coinNano;
     proof = _proof;
 }
 
+void WalletTransaction::saveData(QDataStream & out) const {
+    out << int(0x7A33);
+    out << qint64(txIdx);
+    out << transactionType;
+    out << txid;
+    out << address;
+    out << qint64(creationTimeMs);
+    out << confirmed;
+    out << qint64(height);
+    out << qint64(confirmationTimeMs);
+    out << qint64(coinNano);
+    out << proof;
+}
+
+bool WalletTransaction::loadData(QDataStream & in) {
+    int id = 0;
+    in >> id;
+    if ( id!=0x7A33 ) // 0x7A31 had the times as strings, such cache is read from mwc713 again
+        return false;
+
+    qint64 idx = -1, h = 0, coins = 0, crTime = 0, confTime = 0;
+    in >> idx;
+    in >> transactionType;
+    in >> txid;
+    in >> address;
+    in >> crTime;
+    in >> confirmed;
+    in >> h;
+    in >> confTime;
+    in >> coins;
+    in >> proof;
+
+    txIdx = idx;
+    creationTimeMs = crTime;
+    height = h;
+    confirmationTimeMs = confTime;
+    coinNano = coins;
+    return in.status() == QDataStream::Ok;
+}
+
 // return transaction age (time interval from creation moment) in Seconds.
 int64_t WalletTransaction::calculateTransactionAge( const QDateTime & current ) const {
-    // Example: 2019-06-22 05:44:53
-    QDateTime setTime = QDateTime::fromString (creationTime, mwc::DATETIME_TEMPLATE_THIS );
-//    setTime.setOffsetFromUtc(0);
-    return setTime.secsTo(current);
+    if (creationTimeMs==0)
+        return 0;
+    return (current.toMSecsSinceEpoch() - creationTimeMs) / 1000;
 }
 
 
 
 void WalletOutput::setData(QString _outputCommitment,
-        QString     _MMRIndex,
-        QString     _blockHeight,
-        QString     _lockedUntil,
-        QString     _status,
+        int64_t     _MMRIndex,
+        int64_t     _blockHeight,
+        int64_t     _lockedUntil,
+        STATUS      _status,
         bool        _coinbase,
-        QString     _numOfConfirms,
+        int64_t     _numOfConfirms,
         int64_t     _valueNano,
         int64_t     _txIdx)
 {
@@ -208,6 +247,30 @@ void WalletOutput::setData(QString _outputCommitment,
     txIdx = _txIdx;
 }
 
+// static
+WalletOutput::STATUS WalletOutput::statusFromString(const QStringRef & str) {
+    if (str == QLatin1String("Unspent"))
+        return STATUS::UNSPENT;
+    if (str == QLatin1String("Unconfirmed"))
+        return STATUS::UNCONFIRMED;
+    if (str == QLatin1String("Locked"))
+        return STATUS::LOCKED;
+    if (str == QLatin1String("Spent"))
+        return STATUS::SPENT;
+    return STATUS::UNKNOWN;
+}
+
+// static
+QString WalletOutput::statusToString(STATUS status) {
+    switch (status) {
+        case STATUS::UNCONFIRMED: return "Unconfirmed";
+        case STATUS::UNSPENT:     return "Unspent";
+        case STATUS::LOCKED:      return "Locked";
+        case STATUS::SPENT:       return "Spent";
+        default:                  return "Unknown";
+    }
+}
+
 void WalletUtxoSignature::setData(int64_t _coinNano, // Output amount
         QString _messageHash,
         QString _pubKeyCompressed,
@@ -228,4 +291,316 @@ Wallet::~Wallet()
 {
 }
 
+// ------------------------------------ TransactionColumns -------------------------------------------
+
+int64_t TransactionColumns::Row::txIdx() const { return c->d->txIdx[r]; }
+uint    TransactionColumns::Row::transactionType() const { return c->d->transactionType[r]; }
+
+QString TransactionColumns::Row::txid() const {
+    const QUuid & id = c->d->txid[r];
+    if (id.isNull())
+        return c->d->otherTxid.value(r);
+    return id.toString().mid(1, 36); // No braces
+}
+
+QString TransactionColumns::Row::address() const {
+    int idx = c->d->address[r];
+    return idx<0 ? QString() : c->d->addressPool[idx];
+}
+
+int64_t TransactionColumns::Row::creationTimeMs() const { return c->d->creationTime[r]; }
+QString TransactionColumns::Row::creationTime() const { return util::ms2ThisTime( creationTimeMs() ); }
+bool    TransactionColumns::Row::confirmed() const { return (c->d->flags[r] & CONFIRMED) != 0; }
+int64_t TransactionColumns::Row::height() const { return c->d->height[r]; }
+int64_t TransactionColumns::Row::confirmationTimeMs() const { return c->d->confirmationTime[r]; }
+QString TransactionColumns::Row::confirmationTime() const { return util::ms2ThisTime( confirmationTimeMs() ); }
+int64_t TransactionColumns::Row::coinNano() const { return c->d->coinNano[r]; }
+bool    TransactionColumns::Row::proof() const { return (c->d->flags[r] & PROOF) != 0; }
+
+bool TransactionColumns::Row::canBeCancelled() const {
+    return (transactionType() & WalletTransaction::TRANSACTION_TYPE::CANCELLED)==0 && !confirmed();
+}
+
+WalletTransaction TransactionColumns::Row::toTransaction() const {
+    WalletTransaction res;
+    res.txIdx = txIdx();
+    res.transactionType = transactionType();
+    res.txid = txid();
+    res.address = address();
+    res.creationTimeMs = creationTimeMs();
+    res.confirmed = confirmed();
+    res.height = height();
+    res.confirmationTimeMs = confirmationTimeMs();
+    res.coinNano = coinNano();
+    res.proof = proof();
+    return res;
+}
+
+TransactionColumns::TransactionColumns() :
+    d(new Data)
+{
+}
+
+TransactionColumns TransactionColumns::fromVector(const QVector<WalletTransaction> & transactions) {
+    TransactionColumns res;
+    res.reserve(transactions.size());
+    for (const auto & tx : transactions)
+        res.append(tx);
+    return res;
+}
+
+int TransactionColumns::size() const {
+    return d->txIdx.size();
+}
+
+QVector<WalletTransaction> TransactionColumns::toVector() const {
+    QVector<WalletTransaction> res;
+    int sz = size();
+    res.reserve(sz);
+    for (int i=0; i<sz; i++)
+        res.push_back( at(i) );
+    return res;
+}
+
+void TransactionColumns::reserve(int size) {
+    d->txIdx.reserve(size);
+    d->transactionType.reserve(size);
+    d->txid.reserve(size);
+    d->address.reserve(size);
+    d->creationTime.reserve(size);
+    d->height.reserve(size);
+    d->confirmationTime.reserve(size);
+    d->coinNano.reserve(size);
+    d->flags.reserve(size);
+}
+
+void TransactionColumns::append(const WalletTransaction & tx) {
+    Data * data = d.data(); // detach once
+    int row = data->txIdx.size();
+
+    data->txIdx.push_back(tx.txIdx);
+    data->transactionType.push_back(tx.transactionType);
+
+    // mwc713 txid is uuid without braces. Something else is kept as it is
+    QUuid id(tx.txid);
+    if (id.isNull() || id.toString().mid(1,36) != tx.txid) {
+        id = QUuid();
+        if (!tx.txid.isEmpty())
+            data->otherTxid.insert(row, tx.txid);
+    }
+    data->txid.push_back(id);
+
+    int addrIdx = -1;
+    if (!tx.address.isEmpty()) {
+        auto it = data->addressIndex.find(tx.address);
+        if (it == data->addressIndex.end()) {
+            addrIdx = data->addressPool.size();
+            data->addressPool.push_back(tx.address);
+            data->addressIndex.insert(tx.address, addrIdx);
+        }
+        else {
+            addrIdx = it.value();
+        }
+    }
+    data->address.push_back(addrIdx);
+
+    data->creationTime.push_back(tx.creationTimeMs);
+    data->height.push_back(tx.height);
+    data->confirmationTime.push_back(tx.confirmationTimeMs);
+    data->coinNano.push_back(tx.coinNano);
+    data->flags.push_back( quint8( (tx.confirmed ? CONFIRMED : 0) | (tx.proof ? PROOF : 0) ) );
+}
+
+void TransactionColumns::append(const TransactionColumns & source, int row) {
+    Data * data = d.data(); // detach once
+    const Data * src = source.d.constData();
+    int newRow = data->txIdx.size();
+
+    data->txIdx.push_back(src->txIdx[row]);
+    data->transactionType.push_back(src->transactionType[row]);
+    data->txid.push_back(src->txid[row]);
+    if (src->otherTxid.contains(row))
+        data->otherTxid.insert(newRow, src->otherTxid.value(row));
+
+    int addrIdx = -1;
+    if (src->address[row]>=0) {
+        const QString & addr = src->addressPool[ src->address[row] ];
+        auto it = data->addressIndex.find(addr);
+        if (it == data->addressIndex.end()) {
+            addrIdx = data->addressPool.size();
+            data->addressPool.push_back(addr);
+            data->addressIndex.insert(addr, addrIdx);
+        }
+        else {
+            addrIdx = it.value();
+        }
+    }
+    data->address.push_back(addrIdx);
+
+    data->creationTime.push_back(src->creationTime[row]);
+    data->height.push_back(src->height[row]);
+    data->confirmationTime.push_back(src->confirmationTime[row]);
+    data->coinNano.push_back(src->coinNano[row]);
+    data->flags.push_back(src->flags[row]);
+}
+
+int TransactionColumns::getAddressCount() const {
+    return d->addressPool.size();
+}
+
+// ------------------------------------ TransactionQuery -------------------------------------------
+
+bool TransactionQuery::hasFilters() const {
+    return !address.isEmpty() || !txidPrefix.isEmpty() || minAmountNano>0 || maxAmountNano>=0 ||
+            confirmed!=CONFIRMED::ANY || typeMask!=0 || fromTimeMs>0 || toTimeMs>0;
+}
+
+static bool isAmount(const QString & str, int64_t & nano) {
+    if (str.isEmpty())
+        return false;
+    for (QChar ch : str) {
+        if ( !ch.isDigit() && ch!='.' )
+            return false;
+    }
+    QPair<bool,int64_t> res = util::one2nano(str);
+    nano = res.second;
+    return res.first;
+}
+
+static int64_t dateToMs(const QString & str, int addDays) {
+    QDate date = QDate::fromString(str, "yyyy-MM-dd");
+    if (!date.isValid())
+        return 0;
+    return QDateTime(date.addDays(addDays)).toMSecsSinceEpoch();
+}
+
+TransactionQuery TransactionQuery::fromSearchText(const QString & text) {
+    TransactionQuery query;
+
+    const QStringList terms = text.split(' ', QString::SkipEmptyParts);
+    for (const QString & term : terms) {
+        QString t = term.toLower();
+        int64_t n1 = 0, n2 = 0;
+
+        if (t=="send" || t=="sent")
+            query.typeMask |= WalletTransaction::TRANSACTION_TYPE::SEND;
+        else if (t=="receive" || t=="received")
+            query.typeMask |= WalletTransaction::TRANSACTION_TYPE::RECEIVE;
+        else if (t=="cancelled" || t=="canceled")
+            query.typeMask |= WalletTransaction::TRANSACTION_TYPE::CANCELLED;
+        else if (t=="confirmed")
+            query.confirmed = CONFIRMED::YES;
+        else if (t=="unconfirmed")
+            query.confirmed = CONFIRMED::NO;
+        else if (t.startsWith("from:"))
+            query.fromTimeMs = dateToMs(t.mid(5), 0);
+        else if (t.startsWith("to:"))
+            query.toTimeMs = dateToMs(t.mid(3), 1);
+        else if (t.startsWith('>') && isAmount(t.mid(1), n1))
+            query.minAmountNano = n1;
+        else if (t.startsWith('<') && isAmount(t.mid(1), n1))
+            query.maxAmountNano = n1;
+        else if (t.count('-')==1 && isAmount(t.section('-',0,0), n1) && isAmount(t.section('-',1,1), n2)) {
+            query.minAmountNano = std::min(n1,n2);
+            query.maxAmountNano = std::max(n1,n2);
+        }
+        else {
+            bool txid = t.length()>=4;
+            for ( int i=0; txid && i<t.length(); i++ ) {
+                ushort ch = t[i].unicode();
+                txid = (ch>='0' && ch<='9') || (ch>='a' && ch<='f') || ch=='-';
+            }
+            if (txid)
+                query.txidPrefix = t;
+            else
+                query.address = term; // Address is case sensitive
+        }
+    }
+    return query;
+}
+
+// ------------------------------------ OutputColumns -------------------------------------------
+
+QString OutputColumns::Row::outputCommitment() const {
+    if (c->d->otherCommitment.contains(r))
+        return c->d->otherCommitment.value(r);
+    return QString::fromLatin1( c->d->commitment.mid(r*COMMITMENT_SIZE, COMMITMENT_SIZE).toHex() );
+}
+
+int64_t OutputColumns::Row::MMRIndex() const { return c->d->MMRIndex[r]; }
+int64_t OutputColumns::Row::blockHeight() const { return c->d->blockHeight[r]; }
+int64_t OutputColumns::Row::lockedUntil() const { return c->d->lockedUntil[r]; }
+WalletOutput::STATUS OutputColumns::Row::status() const { return WalletOutput::STATUS(c->d->status[r]); }
+bool    OutputColumns::Row::coinbase() const { return c->d->coinbase[r]; }
+int64_t OutputColumns::Row::numOfConfirms() const { return c->d->numOfConfirms[r]; }
+int64_t OutputColumns::Row::valueNano() const { return c->d->valueNano[r]; }
+int64_t OutputColumns::Row::txIdx() const { return c->d->txIdx[r]; }
+
+WalletOutput OutputColumns::Row::toOutput() const {
+    WalletOutput res;
+    res.setData( outputCommitment(), MMRIndex(), blockHeight(), lockedUntil(), status(), coinbase(),
+            numOfConfirms(), valueNano(), txIdx() );
+    return res;
+}
+
+OutputColumns::OutputColumns() :
+    d(new Data)
+{
+}
+
+OutputColumns OutputColumns::fromVector(const QVector<WalletOutput> & outputs) {
+    OutputColumns res;
+    res.reserve(outputs.size());
+    for (const auto & out : outputs)
+        res.append(out);
+    return res;
+}
+
+int OutputColumns::size() const {
+    return d->txIdx.size();
+}
+
+QVector<WalletOutput> OutputColumns::toVector() const {
+    QVector<WalletOutput> res;
+    int sz = size();
+    res.reserve(sz);
+    for (int i=0; i<sz; i++)
+        res.push_back( at(i) );
+    return res;
+}
+
+void OutputColumns::reserve(int size) {
+    d->commitment.reserve(size*COMMITMENT_SIZE);
+    d->MMRIndex.reserve(size);
+    d->blockHeight.reserve(size);
+    d->lockedUntil.reserve(size);
+    d->status.reserve(size);
+    d->coinbase.reserve(size);
+    d->numOfConfirms.reserve(size);
+    d->valueNano.reserve(size);
+    d->txIdx.reserve(size);
+}
+
+void OutputColumns::append(const WalletOutput & out) {
+    Data * data = d.data(); // detach once
+    int row = data->txIdx.size();
+
+    // Commitment is 66 hex symbols. Something else is kept as it is
+    QByteArray commit = QByteArray::fromHex( out.outputCommitment.toLatin1() );
+    if (commit.size() != COMMITMENT_SIZE || QString::fromLatin1(commit.toHex()) != out.outputCommitment) {
+        data->otherCommitment.insert(row, out.outputCommitment);
+        commit = QByteArray(COMMITMENT_SIZE, '\0');
+    }
+    data->commitment.append(commit);
+
+    data->MMRIndex.push_back(out.MMRIndex);
+    data->blockHeight.push_back(out.blockHeight);
+    data->lockedUntil.push_back(out.lockedUntil);
+    data->status.push_back( quint8(out.status) );
+    data->coinbase.push_back(out.coinbase);
+    data->numOfConfirms.push_back(out.numOfConfirms);
+    data->valueNano.push_back(out.valueNano);
+    data->txIdx.push_back(out.txIdx);
+}
+
 }
@@ -20,8 +20,16 @@
 #include "../core/mwcexception.h"
 #include "../util/ioutils.h"
 #include "../util/stringutils.h"
+#include "tasktiming.h"
 #include <QDateTime>
 #include <QObject>
+#include <QSharedData>
+#include <QSharedDataPointer>
+#include <QHash>
+#include <QUuid>
+#include <QByteArray>
+#include <QStringList>
+#include <climits>
 
 namespace core {
 class AppContext;
@@ -141,26 +149,54 @@ public:
 };
 
 struct WalletOutput {
+    enum class STATUS { UNKNOWN, UNCONFIRMED, UNSPENT, LOCKED, SPENT };
 
-    QString     outputCommitment;
-    QString    MMRIndex;
-    QString    blockHeight;
-    QString    lockedUntil;
-    QString    status;
+    QString    outputCommitment;
+    int64_t    MMRIndex = -1;    // -1 if not in the chain yet
+    int64_t    blockHeight = -1; // -1 if not in the chain yet
+    int64_t    lockedUntil = 0;
+    STATUS     status = STATUS::UNKNOWN;
     bool       coinbase = false;
-    QString    numOfConfirms;
+    int64_t    numOfConfirms = 0;
     int64_t    valueNano = 0L;
-    int64_t    txIdx;
+    int64_t    txIdx = -1;
 
     void setData(QString outputCommitment,
-            QString     MMRIndex,
-            QString     blockHeight,
-            QString     lockedUntil,
-            QString     status,
+            int64_t     MMRIndex,
+            int64_t     blockHeight,
+            int64_t     lockedUntil,
+            STATUS      status,
             bool        coinbase,
-            QString     numOfConfirms,
+            int64_t     numOfConfirms,
             int64_t     valueNano,
             int64_t     txIdx);
+
+    // mwc713 status name: Unconfirmed, Unspent, Locked, Spent
+    static STATUS statusFromString(const QStringRef & str);
+    static QString statusToString(STATUS status);
+
+    // Empty string for not defined numbers (-1)
+    static QString numberToString(int64_t n) { return n<0 ? QString() : QString::number(n); }
+
+    // Output state that can be changed by the chain or by the wallet
+    bool isSameState(const WalletOutput & other) const {
+        return status==other.status && numOfConfirms==other.numOfConfirms && blockHeight==other.blockHeight &&
+               MMRIndex==other.MMRIndex && lockedUntil==other.lockedUntil && txIdx==other.txIdx && valueNano==other.valueNano;
+    }
+};
+
+// Changes of the outputs page since the previous read. Outputs are identified by commitment
+struct WalletOutputsDiff {
+    QString account;
+    int64_t height = 0;
+    int offset = 0;  // Page that was read
+    int number = 0;
+
+    QVector<WalletOutput> added;
+    QStringList removed;
+    QVector<WalletOutput> changed;
+
+    bool isEmpty() const {return added.isEmpty() && removed.isEmpty() && changed.isEmpty();}
 };
 
 struct WalletTransaction {
@@ -170,10 +206,10 @@ struct WalletTransaction {
     uint    transactionType = TRANSACTION_TYPE::NONE;
     QString txid;
     QString address;
-    QString creationTime;
+    int64_t creationTimeMs = 0; // epoch msec, 0 if not defined
     bool    confirmed = false;
     int64_t height = 0;
-    QString confirmationTime;
+    int64_t confirmationTimeMs = 0; // epoch msec, 0 if not defined
     int64_t coinNano = 0; // Net diffrence
     bool    proof=false;
 
@@ -181,10 +217,10 @@ struct WalletTransaction {
         uint    transactionType,
         QString txid,
         QString address,
-        QString creationTime,
+        int64_t creationTimeMs,
         bool    confirmed,
         int64_t height,
-        QString confirmationTime,
+        int64_t confirmationTimeMs,
         int64_t    coinNano,
         bool    proof);
 
@@ -195,12 +231,30 @@ struct WalletTransaction {
     // return transaction age (time interval from creation moment) in Seconds.
     int64_t calculateTransactionAge( const QDateTime & current ) const;
 
+    // Times in this wallet display format
+    QString getCreationTime() const { return util::ms2ThisTime(creationTimeMs); }
+    QString getConfirmationTime() const { return util::ms2ThisTime(confirmationTimeMs); }
+
     // mark transaction as cancelled
     void cancelled() {
         transactionType |= TRANSACTION_TYPE::CANCELLED;
     }
 
-    QString getTypeAsStr() const {
+    // Confirmed or cancelled transaction will never change
+    bool isFinal() const { return confirmed || (transactionType & TRANSACTION_TYPE::CANCELLED)!=0; }
+
+    bool isSame(const WalletTransaction & other) const {
+        return txIdx==other.txIdx && transactionType==other.transactionType && txid==other.txid && address==other.address &&
+               creationTimeMs==other.creationTimeMs && confirmed==other.confirmed && height==other.height &&
+               confirmationTimeMs==other.confirmationTimeMs && coinNano==other.coinNano && proof==other.proof;
+    }
+
+    void saveData(QDataStream & out) const;
+    bool loadData(QDataStream & in);
+
+    QString getTypeAsStr() const { return typeToString(transactionType); }
+
+    static QString typeToString(uint transactionType) {
         QString res;
 
         if ( transactionType & TRANSACTION_TYPE::SEND )
@@ -223,10 +277,169 @@ struct WalletTransaction {
         return expandStrR( QString::number(txIdx), 3) +
                 expandStrR(nano2one(coinNano), 8) +
                 expandStrR( string2shortStrR(txid, 12), 12) +
-                " " + creationTime;
+                " " + getCreationTime();
     }
 };
 
+// Transactions stored by columns. Addresses are interned, txids are 16 byte uuids, times are epoch milliseconds.
+// The container is implicitly shared: copy is a pointer copy, so it is cheap to pass it by queued signals.
+// Emitted data is a snapshot, the receivers are only reading it.
+class TransactionColumns {
+public:
+    // Read only view of a single row, valid while the container is alive
+    class Row {
+    public:
+        Row(const TransactionColumns * columns, int row) : c(columns), r(row) {}
+
+        int64_t txIdx() const;
+        uint    transactionType() const;
+        QString txid() const;
+        QString address() const;
+        int64_t creationTimeMs() const;
+        QString creationTime() const; // Display string
+        bool    confirmed() const;
+        int64_t height() const;
+        int64_t confirmationTimeMs() const;
+        QString confirmationTime() const; // Display string
+        int64_t coinNano() const;
+        bool    proof() const;
+
+        bool canBeCancelled() const;
+
+        WalletTransaction toTransaction() const;
+    private:
+        const TransactionColumns * c;
+        int r;
+    };
+
+    TransactionColumns();
+    static TransactionColumns fromVector(const QVector<WalletTransaction> & transactions);
+
+    int size() const;
+    bool isEmpty() const {return size()==0;}
+
+    Row operator[](int row) const { return Row(this, row); }
+    WalletTransaction at(int row) const { return Row(this, row).toTransaction(); }
+    QVector<WalletTransaction> toVector() const;
+
+    void reserve(int size);
+    void append(const WalletTransaction & transaction);
+    // Append the row from another container without conversion
+    void append(const TransactionColumns & source, int row);
+
+    // Number of different addresses, for diagnostic
+    int getAddressCount() const;
+
+private:
+    enum FLAGS { CONFIRMED=1, PROOF=2 };
+
+    struct Data : public QSharedData {
+        QVector<int64_t> txIdx;
+        QVector<uint>    transactionType;
+        QVector<QUuid>   txid;
+        QHash<int, QString> otherTxid; // txids that are not uuids, by row
+        QVector<int>     address;      // index at addressPool
+        QVector<int64_t> creationTime;
+        QVector<int64_t> height;
+        QVector<int64_t> confirmationTime;
+        QVector<int64_t> coinNano;
+        QVector<quint8>  flags;
+
+        QStringList      addressPool;
+        QHash<QString, int> addressIndex;
+    };
+
+    QSharedDataPointer<Data> d;
+};
+
+// Outputs stored by columns. Commitments are kept as 33 bytes binary.
+// Implicitly shared snapshot, the same as TransactionColumns.
+class OutputColumns {
+public:
+    // Read only view of a single row, valid while the container is alive
+    class Row {
+    public:
+        Row(const OutputColumns * columns, int row) : c(columns), r(row) {}
+
+        QString outputCommitment() const;
+        int64_t MMRIndex() const;
+        int64_t blockHeight() const;
+        int64_t lockedUntil() const;
+        WalletOutput::STATUS status() const;
+        bool    coinbase() const;
+        int64_t numOfConfirms() const;
+        int64_t valueNano() const;
+        int64_t txIdx() const;
+
+        WalletOutput toOutput() const;
+    private:
+        const OutputColumns * c;
+        int r;
+    };
+
+    OutputColumns();
+    static OutputColumns fromVector(const QVector<WalletOutput> & outputs);
+
+    int size() const;
+    bool isEmpty() const {return size()==0;}
+
+    Row operator[](int row) const { return Row(this, row); }
+    WalletOutput at(int row) const { return Row(this, row).toOutput(); }
+    QVector<WalletOutput> toVector() const;
+
+    void reserve(int size);
+    void append(const WalletOutput & output);
+
+    static const int COMMITMENT_SIZE = 33;
+
+private:
+    struct Data : public QSharedData {
+        QByteArray       commitment;  // COMMITMENT_SIZE bytes per row
+        QHash<int, QString> otherCommitment; // commitments that are not 33 bytes hex, by row
+        QVector<int64_t> MMRIndex;
+        QVector<int64_t> blockHeight;
+        QVector<int64_t> lockedUntil;
+        QVector<quint8>  status;
+        QVector<bool>    coinbase;
+        QVector<int64_t> numOfConfirms;
+        QVector<int64_t> valueNano;
+        QVector<int64_t> txIdx;
+    };
+
+    QSharedDataPointer<Data> d;
+};
+
+// Search over the transactions history. Empty fields don't filter anything.
+struct TransactionQuery {
+    enum class CONFIRMED { ANY, YES, NO };
+    enum class SORT { INDEX, TIME, AMOUNT };
+
+    QString address;      // Exact match
+    QString txidPrefix;   // Lower case
+    int64_t minAmountNano = 0; // Amount is the absolute net difference
+    int64_t maxAmountNano = -1; // -1 - no limit
+    CONFIRMED confirmed = CONFIRMED::ANY;
+    uint    typeMask = 0; // WalletTransaction::TRANSACTION_TYPE bits that must be set
+    int64_t fromTimeMs = 0; // Creation time [from, to). 0 - no limit
+    int64_t toTimeMs = 0;
+
+    SORT    sort = SORT::INDEX;
+    bool    descending = true; // Newest first
+
+    // Page of the result
+    int     offset = 0;
+    int     number = INT_MAX;
+
+    bool hasFilters() const;
+
+    // Text from the search box. Space separated terms:
+    //   send, receive, cancelled, confirmed, unconfirmed - type and state
+    //   >N, <N, N-M - amount range in MWC
+    //   from:yyyy-MM-dd, to:yyyy-MM-dd - creation date (local time, 'to' day is included)
+    //   hex symbols and '-' - txid prefix; anything else - address
+    static TransactionQuery fromSearchText(const QString & text);
+};
+
 struct WalletUtxoSignature {
     int64_t coinNano; // Output amount
     QString messageHash;
@@ -253,9 +466,10 @@ public:
     // Return true if wallet is running
     virtual bool isRunning() = 0;
 
-    // Check if wallet need to be initialized or not. Will run standalone app, wait for exit and return the result
-    // Call might take few seconds
-    virtual bool checkWalletInitialized() = 0;
+    // Check if wallet need to be initialized or not. Will run standalone app, result come when it exit.
+    // Probe that is already running is reused.
+    // Check signal: onWalletInitialized(bool initialized)
+    virtual void checkWalletInitialized() = 0;
 
     enum STARTED_MODE { OFFLINE, NORMAL, INIT, RECOVER, GET_NEXTKEY, RECEIVE_SLATE };
     virtual STARTED_MODE getStartedMode() = 0;
@@ -287,7 +501,8 @@ public:
     virtual void loginWithPassword(QString password)   = 0;
 
     // Exit from the wallet. Expected that state machine will switch to Init state
-    // syncCall - stop NOW. Caller suppose to understand what he is doing
+    // syncCall - stop without waiting for the queued tasks. Caller suppose to understand what he is doing
+    // mwc713 exits in the background, the next start waits for it
     virtual void logout(bool syncCall) = 0;
 
     // Confirm that user write the passphase
@@ -420,25 +635,42 @@ public:
     virtual void sendTo( const wallet::AccountInfo &account, int64_t coinNano, const QString & address, QString message, int inputConfirmationNumber, int changeOutputs )  = 0;
     // Check signal:  onSend
 
+    // Read requests return the request id that can be used with cancelRequest.
+    // Newer request of the same kind replaces the older one if it is not started yet.
+
     // Get total number of Outputs
     // Check Signal: onOutputCount(int number)
-    virtual void getOutputCount(QString account)  = 0;
+    virtual int64_t getOutputCount(QString account)  = 0;
 
     // Show outputs for the wallet
-    // Check Signal: onOutputs( QString account, int64_t height, QVector<WalletOutput> outputs)
-    virtual void getOutputs(QString account, int offset, int number)  = 0;
+    // Check Signal: onOutputs( QString account, int64_t height, OutputColumns outputs)
+    virtual int64_t getOutputs(QString account, int offset, int number)  = 0;
+    // Outputs page is closed, wallet events don't need to refresh it any more
+    virtual void releaseOutputs() = 0;
 
     // Get total number of Transactions
     // Check Signal: onTransactionCount(int number)
-    virtual void getTransactionCount(QString account)  = 0;
+    virtual int64_t getTransactionCount(QString account)  = 0;
 
     // Show all transactions for current account
-    // Check Signal: onTransactions( QString account, int64_t height, QVector<WalletTransaction> Transactions)
-    virtual void getTransactions(QString account, int offset, int number)  = 0;
+    // Check Signal: onTransactions( QString account, int64_t height, TransactionColumns Transactions)
+    virtual int64_t getTransactions(QString account, int offset, int number)  = 0;
 
     // Read all transactions for all accounts. Might tale time...
-    // Check Signal: onAllTransactions( QVector<WalletTransaction> Transactions)
-    virtual void getAllTransactions()  = 0;
+    // Check Signal: onAllTransactions( TransactionColumns Transactions)
+    virtual int64_t getAllTransactions()  = 0;
+
+    // Search the account transactions history. Not final transactions are refreshed first, then
+    // the query runs over the cached history in the background thread.
+    // Check Signal: onTransactionQueryResult( int64_t requestId, QString account, int total, int offset, TransactionColumns transactions, bool last )
+    virtual int64_t queryTransactions(QString account, TransactionQuery query) = 0;
+
+    // Cancel the read request if it is not started yet. Result signal will not be emitted.
+    // Return true if request was cancelled
+    virtual bool cancelRequest(int64_t requestId) = 0;
+
+    // Diagnostics: queue wait, mwc713, processing and UI time histograms for every task type
+    virtual TaskTimingStats getTaskTimingStats() const = 0;
 
 
     // ----------- HODL
@@ -454,6 +686,9 @@ signals:
     // Config was updated
     void onConfigUpdate();
 
+    // Result of checkWalletInitialized. false if the wallet need to be initialized or the check failed
+    void onWalletInitialized(bool initialized);
+
     // Get next key result
     void onGetNextKeyResult( bool success, QString identifier, QString publicKey, QString errorMessage, QString btcaddress, QString airDropAccPassword);
 
@@ -513,13 +748,18 @@ signals:
 
     // Transactions
     void onTransactionCount(QString account, int number);
-    void onTransactions( QString account, int64_t height, QVector<WalletTransaction> Transactions);
+    void onTransactions( QString account, int64_t height, TransactionColumns Transactions);
     void onCancelTransacton( bool success, int64_t trIdx, QString errMessage );
 
-    void onAllTransactions( QVector<WalletTransaction> Transactions);
+    void onAllTransactions( TransactionColumns Transactions);
+
+    // Query results come by chunks. total - number of all matching transactions, offset - position of the chunk at the result
+    void onTransactionQueryResult( int64_t requestId, QString account, int total, int offset, TransactionColumns transactions, bool last );
 
     void onOutputCount(QString account, int number);
-    void onOutputs( QString account, int64_t height, QVector<WalletOutput> Transactions);
+    void onOutputs( QString account, int64_t height, OutputColumns outputs);
+    // Outputs that was changed since the last read of the same page. Emitted before onOutputs
+    void onOutputsChanged( WalletOutputsDiff diff );
 
     void onCheckResult(bool ok, QString errors );
 
@@ -543,5 +783,9 @@ signals:
 
 Q_DECLARE_METATYPE(wallet::WalletTransaction);
 Q_DECLARE_METATYPE(wallet::WalletOutput);
+Q_DECLARE_METATYPE(wallet::WalletOutputsDiff);
+Q_DECLARE_METATYPE(wallet::TransactionColumns);
+Q_DECLARE_METATYPE(wallet::OutputColumns);
+Q_DECLARE_METATYPE(wallet::TransactionQuery);
 
 #endif // MWCWALLET_H
@@ -153,7 +153,7 @@ QString Outputs::currentSelectedAccount() {
 }
 
 
-void Outputs::setOutputsData(QString account, int64_t height, const QVector<wallet::WalletOutput> & outp ) {
+void Outputs::setOutputsData(QString account, int64_t height, const wallet::OutputColumns & outp ) {
     Q_UNUSED(height)
 
     qDebug() << "Outputs::setOutputsData for account=" << account << " outp zs=" << outp.size();
@@ -167,30 +167,84 @@ void Outputs::setOutputsData(QString account, int64_t height, const QVector<wall
         return;
     }
 
-    outputs = outp;
+    // The same page that was already updated by the diff. Rebuild only if the rows order is different.
+    bool inSync = account == shownAccount && currentPagePosition == shownPosition && outp.size() == outputs.size();
+    for ( int i=0; inSync && i<outp.size(); i++ )
+        inSync = outp[i].outputCommitment() == outputs[i].outputCommitment;
 
+    // Page is small, the window keeps it as rows to apply the diffs
+    outputs = outp.toVector();
+
+    if (!inSync)
+        showOutputs();
+
+    ui->prevBtn->setEnabled( buttonState.first );
+    ui->nextBtn->setEnabled( buttonState.second );
+}
+
+void Outputs::applyOutputsDiff(const wallet::WalletOutputsDiff & diff) {
+    if ( diff.account != shownAccount || diff.offset != shownPosition || diff.offset != currentPagePosition )
+        return; // Different page, setOutputsData will rebuild the table
+
+    qDebug() << "Outputs::applyOutputsDiff added=" << diff.added.size() << " removed=" << diff.removed.size() << " changed=" << diff.changed.size();
+
+    for ( const QString & commit : diff.removed ) {
+        for ( int i=0; i<outputs.size(); i++ ) {
+            if (outputs[i].outputCommitment == commit) {
+                outputs.remove(i);
+                ui->outputsTable->removeDataRow(i);
+                break;
+            }
+        }
+    }
+
+    QVector<wallet::WalletOutput> updates = diff.changed;
+    updates += diff.added;
+    for ( const auto & out : updates ) {
+        int row = -1;
+        for ( int i=0; i<outputs.size(); i++ ) {
+            if (outputs[i].outputCommitment == out.outputCommitment) {
+                row = i;
+                break;
+            }
+        }
+
+        if (row>=0) {
+            outputs[row] = out;
+            ui->outputsTable->updateRow(row, outputRow(out));
+        }
+        else {
+            outputs.push_back(out);
+            ui->outputsTable->appendRow(outputRow(out));
+        }
+    }
+}
+
+QVector<QString> Outputs::outputRow(const wallet::WalletOutput & out) const {
+    return QVector<QString>{
+                 QString::number( out.txIdx+1 ),
+                // out.status, // Status allways 'unspent', so no reasons to print it.
+                 util::nano2one(out.valueNano),
+                 QString::number(out.numOfConfirms),
+                 out.coinbase ? "Yes":"No",
+                 out.outputCommitment,
+                 wallet::WalletOutput::numberToString(out.MMRIndex),
+                 wallet::WalletOutput::numberToString(out.lockedUntil)
+             };
+}
+
+void Outputs::showOutputs() {
     int rowNum = outputs.size();
 
     ui->outputsTable->clearData();
 
     qDebug() << "updating output table for " << rowNum << " rows";
     for ( int i=0; i<rowNum; i++ ) {
-        auto & out = outputs[i];
-
-        ui->outputsTable->appendRow( QVector<QString>{
-                                         QString::number( out.txIdx+1 ),
-                                        // out.status, // Status allways 'unspent', so no reasons to print it.
-                                         util::nano2one(out.valueNano),
-                                         out.numOfConfirms,
-                                         out.coinbase ? "Yes":"No",
-                                         out.outputCommitment,
-                                         out.MMRIndex,
-                                         out.lockedUntil
-                                     } );
+        ui->outputsTable->appendRow( outputRow(outputs[i]) );
     }
 
-    ui->prevBtn->setEnabled( buttonState.first );
-    ui->nextBtn->setEnabled( buttonState.second );
+    shownAccount = currentSelectedAccount();
+    shownPosition = currentPagePosition;
 }
 
 void wnd::Outputs::on_refreshButton_clicked()
@@ -214,6 +268,9 @@ void Outputs::requestOutputs(QString account) {
     updatePages(-1, -1, -1);
 
     ui->outputsTable->clearData();
+    outputs.clear();
+    shownAccount = "";
+    shownPosition = -1;
     state->requestOutputCount(account);
 }
 
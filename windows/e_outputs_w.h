@@ -37,7 +37,9 @@ public:
     ~Outputs();
 
     void setOutputCount(QString account, int count);
-    void setOutputsData(QString account, int64_t height, const QVector<wallet::WalletOutput> & outp );
+    void setOutputsData(QString account, int64_t height, const wallet::OutputColumns & outp );
+    // Update only the rows that was changed at the shown page
+    void applyOutputsDiff(const wallet::WalletOutputsDiff & diff);
 
     // return selected account
     QString updateWalletBalance();
@@ -64,6 +66,9 @@ private:
 
     int calcPageSize() const;
 
+    QVector<QString> outputRow(const wallet::WalletOutput & out) const;
+    void showOutputs();
+
 private:
     Ui::Outputs *ui;
     state::Outputs * state;
@@ -73,6 +78,10 @@ private:
     int currentPagePosition = INT_MAX; // position at the paging...
     int totalOutputs = 0;
 
+    // Page that the table has now. Diffs are applicable to it only
+    QString shownAccount;
+    int shownPosition = -1;
+
     QPair<bool,bool> buttonState = QPair<bool,bool>(false, false);
 };
 
@@ -83,6 +83,11 @@ int Transactions::calcPageSize() const {
 
 
 void Transactions::setTransactionCount(QString account, int count) {
+    if (queryMode) {
+        qDebug() << "Transactions::setTransactionCount ignored because of search mode";
+        return;
+    }
+
     // Init arrays and request the data...
     currentPagePosition = 0; // position at the paging...
     totalTransactions = count;
@@ -102,6 +107,12 @@ void Transactions::setTransactionCount(QString account, int count) {
 
 void Transactions::on_prevBtn_clicked()
 {
+    if (queryMode) {
+        if (currentPagePosition > 0)
+            requestQuery( currentSelectedAccount(), std::max( 0, currentPagePosition-calcPageSize() ) );
+        return;
+    }
+
     if (currentPagePosition > 0) {
         int pageSize = calcPageSize();
         currentPagePosition = std::max( 0, currentPagePosition-pageSize );
@@ -113,6 +124,12 @@ void Transactions::on_prevBtn_clicked()
 
 void Transactions::on_nextBtn_clicked()
 {
+    if (queryMode) {
+        if (currentPagePosition + transactions.size() < totalTransactions )
+            requestQuery( currentSelectedAccount(), currentPagePosition+calcPageSize() );
+        return;
+    }
+
     if (currentPagePosition + transactions.size() < totalTransactions ) {
         int pageSize = calcPageSize();
         currentPagePosition = std::min( totalTransactions-pageSize, currentPagePosition+pageSize );
@@ -151,7 +168,11 @@ QString Transactions::currentSelectedAccount() {
     return "";
 }
 
-void Transactions::setTransactionData(QString account, int64_t height, const QVector<wallet::WalletTransaction> & trans) {
+void Transactions::setTransactionData(QString account, int64_t height, const wallet::TransactionColumns & trans) {
+    if (queryMode) {
+        qDebug() << "Transactions::setTransactionData ignored because of search mode";
+        return;
+    }
 
     ui->progressFrame->hide();
     ui->transactionTable->show();
@@ -180,38 +201,79 @@ void Transactions::setTransactionData(QString account, int64_t height, const QVe
 
     transactions = trans;
 
-    QDateTime current = QDateTime::currentDateTime();
+    int64_t currentMs = QDateTime::currentMSecsSinceEpoch();
 
     ui->transactionTable->clearData();
 
-    for ( int idx = transactions.size()-1; idx>=0; idx--) {
-        const wallet::WalletTransaction trans = transactions[idx];
+    for ( int idx = transactions.size()-1; idx>=0; idx--)
+        appendTransactionRow( transactions[idx], currentMs );
 
-        double selection = 0.0;
+    ui->prevBtn->setEnabled( buttonState.first );
+    ui->nextBtn->setEnabled( buttonState.second );
+
+    updateButtons();
+}
 
-        if ( trans.canBeCancelled() ) {
-            int64_t age = trans.calculateTransactionAge(current);
-            // 1 hours is a 1.0
-            selection = age > 60 * 60 ?
-                1.0 : (double(age) / double(60 * 60));
+void Transactions::setTransactionQueryData(int64_t requestId, QString account, int total, int offset, const wallet::TransactionColumns & trans, bool last) {
+    if (!queryMode || requestId != queryRequestId || account != currentSelectedAccount()) {
+        qDebug() << "Transactions::setTransactionQueryData ignored obsolete result";
+        return;
+    }
+
+    if (queryFirstChunk) {
+        queryFirstChunk = false;
+
+        // Result shrank since the previous page, the position is past the end. Showing the last page instead
+        if (offset>=total && total>0 && last && trans.size()==0) {
+            requestQuery( account, std::max(0, total-calcPageSize()) );
+            return;
         }
 
-        ui->transactionTable->appendRow( QVector<QString>{
-                QString::number(  trans.txIdx+1 ),
-                trans.getTypeAsStr(),
-                trans.txid,
-                trans.address,
-                trans.creationTime,
-                util::nano2one(trans.coinNano),
-                (trans.confirmed ? "YES":"NO"),
-                trans.height<=0 ? "" : QString::number(trans.height)
-        }, selection );
+        // First chunk of the page
+        currentPagePosition = offset;
+        ui->progressFrame->hide();
+        ui->transactionTable->show();
+        ui->transactionTable->clearData();
+
+        transactions = wallet::TransactionColumns();
+        totalTransactions = total;
+        buttonState = updatePages(currentPagePosition, totalTransactions, calcPageSize());
     }
 
-    ui->prevBtn->setEnabled( buttonState.first );
-    ui->nextBtn->setEnabled( buttonState.second );
+    // Results are sorted already, showing them in the same order
+    int64_t currentMs = QDateTime::currentMSecsSinceEpoch();
+    for ( int idx = 0; idx<trans.size(); idx++ ) {
+        transactions.append(trans, idx);
+        appendTransactionRow( trans[idx], currentMs );
+    }
 
-    updateButtons();
+    if (last) {
+        ui->prevBtn->setEnabled( buttonState.first );
+        ui->nextBtn->setEnabled( buttonState.second );
+        updateButtons();
+    }
+}
+
+void Transactions::appendTransactionRow(const wallet::TransactionColumns::Row & trans, int64_t currentMs) {
+    double selection = 0.0;
+
+    if ( trans.canBeCancelled() ) {
+        int64_t age = trans.creationTimeMs()==0 ? 0 : (currentMs - trans.creationTimeMs()) / 1000;
+        // 1 hours is a 1.0
+        selection = age > 60 * 60 ?
+            1.0 : (double(age) / double(60 * 60));
+    }
+
+    ui->transactionTable->appendRow( QVector<QString>{
+            QString::number(  trans.txIdx()+1 ),
+            wallet::WalletTransaction::typeToString( trans.transactionType() ),
+            trans.txid(),
+            trans.address(),
+            trans.creationTime(),
+            util::nano2one(trans.coinNano()),
+            (trans.confirmed() ? "YES":"NO"),
+            trans.height()<=0 ? "" : QString::number(trans.height())
+    }, selection );
 }
 
 void Transactions::showExportProofResults(bool success, QString fn, QString msg ) {
@@ -250,6 +312,10 @@ void Transactions::showVerifyProofResults(bool success, QString fn, QString msg
 
 
 void Transactions::requestTransactions(QString account) {
+    if (queryMode) {
+        requestQuery(account, 0);
+        return;
+    }
 
     ui->progressFrame->show();
 
@@ -264,20 +330,47 @@ void Transactions::requestTransactions(QString account) {
     updateButtons();
 }
 
-// return null if nothing was selected
-wallet::WalletTransaction * Transactions::getSelectedTransaction() {
+void Transactions::requestQuery(QString account, int position) {
+    ui->progressFrame->show();
+    ui->transactionTable->hide();
+    ui->transactionTable->clearData();
+    transactions = wallet::TransactionColumns();
+    updatePages(-1, -1, -1);
+
+    currentPagePosition = position;
+    query.offset = position;
+    query.number = calcPageSize();
+    queryRequestId = state->queryTransactions(account, query);
+    queryFirstChunk = true;
+
+    updateButtons();
+}
+
+void Transactions::on_searchEdit_returnPressed()
+{
+    query = wallet::TransactionQuery::fromSearchText( ui->searchEdit->text() );
+    queryMode = query.hasFilters();
+    queryRequestId = -1;
+    requestTransactions( currentSelectedAccount() );
+}
+
+// return false if nothing was selected
+bool Transactions::getSelectedTransaction(wallet::WalletTransaction & transaction) {
     int row = ui->transactionTable->getSelectedRow();
     if (row<0 || row>=transactions.size())
-        return nullptr;
+        return false;
 
-    return &transactions[ transactions.size()-1-row ];
+    // Pages are shown from the newest, search results are in the query order
+    transaction = transactions.at( queryMode ? row : transactions.size()-1-row );
+    return true;
 }
 
 void Transactions::updateButtons() {
-    wallet::WalletTransaction * selected = Transactions::getSelectedTransaction();
+    wallet::WalletTransaction selected;
+    bool hasSelected = Transactions::getSelectedTransaction(selected);
 
-    ui->generateProofButton->setEnabled( selected!=nullptr && selected->proof );
-    ui->deleteButton->setEnabled( selected!=nullptr && selected->canBeCancelled() );
+    ui->generateProofButton->setEnabled( hasSelected && selected.proof );
+    ui->deleteButton->setEnabled( hasSelected && selected.canBeCancelled() );
 }
 
 
@@ -308,9 +401,10 @@ void Transactions::on_generateProofButton_clicked()
 {
     state::TimeoutLockObject to( state );
 
-    wallet::WalletTransaction * selected = Transactions::getSelectedTransaction();
+    wallet::WalletTransaction selected;
+    bool hasSelected = Transactions::getSelectedTransaction(selected);
 
-    if (! ( selected!=nullptr && selected->proof ) ) {
+    if (! ( hasSelected && selected.proof ) ) {
         control::MessageBox::messageText(this, "Need info",
                               "Please select qualify transaction to generate a proof.");
         return;
@@ -330,7 +424,7 @@ void Transactions::on_generateProofButton_clicked()
     QFileInfo flInfo(fileName);
     state->updateProofFilesPath(flInfo.path());
 
-    state->generateMwcBoxTransactionProof( selected->txIdx, fileName );
+    state->generateMwcBoxTransactionProof( selected.txIdx, fileName );
 }
 
 void Transactions::on_transactionTable_itemSelectionChanged()
@@ -343,12 +437,13 @@ void Transactions::on_transactionTable_cellDoubleClicked(int row, int column)
     Q_UNUSED(row);
     Q_UNUSED(column);
     state::TimeoutLockObject to( state );
-    wallet::WalletTransaction * selected = Transactions::getSelectedTransaction();
+    wallet::WalletTransaction selected;
+    bool hasSelected = Transactions::getSelectedTransaction(selected);
 
-    if (selected==nullptr)
+    if (!hasSelected)
         return;
 
-    dlg::ShowTransactionDlg showTransDlg(this, *selected);
+    dlg::ShowTransactionDlg showTransDlg(this, selected);
     showTransDlg.exec();
 }
 
@@ -364,17 +459,18 @@ void Transactions::on_accountComboBox_activated(int index)
 void Transactions::on_deleteButton_clicked()
 {
     state::TimeoutLockObject to( state );
-    wallet::WalletTransaction * selected = Transactions::getSelectedTransaction();
+    wallet::WalletTransaction selected;
+    bool hasSelected = Transactions::getSelectedTransaction(selected);
 
-    if (! ( selected!=nullptr && !selected->confirmed ) ) {
+    if (! ( hasSelected && !selected.confirmed ) ) {
         control::MessageBox::messageText(this, "Need info",
                               "Please select qualify transaction to cancel.");
         return;
     }
     if ( control::MessageBox::questionText(this, "Transaction cancellation",
-            "Are you sure you want to cancel transaction #" + QString::number(selected->txIdx+1) +
-                               ", TXID " + selected->txid, "No", "Yes", true, false) == control::MessageBox::RETURN_CODE::BTN2 ) {
-        state->cancelTransaction(*selected);
+            "Are you sure you want to cancel transaction #" + QString::number(selected.txIdx+1) +
+                               ", TXID " + selected.txid, "No", "Yes", true, false) == control::MessageBox::RETURN_CODE::BTN2 ) {
+        state->cancelTransaction(selected);
     }
 }
 
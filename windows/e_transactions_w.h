@@ -37,7 +37,8 @@ public:
     ~Transactions();
 
     void setTransactionCount(QString account, int number);
-    void setTransactionData(QString account, int64_t height, const QVector<wallet::WalletTransaction> & transactions);
+    void setTransactionData(QString account, int64_t height, const wallet::TransactionColumns & transactions);
+    void setTransactionQueryData(int64_t requestId, QString account, int total, int offset, const wallet::TransactionColumns & transactions, bool last);
 
     void showExportProofResults(bool success, QString fn, QString msg );
     void showVerifyProofResults(bool success, QString fn, QString msg );
@@ -58,13 +59,18 @@ private slots:
     void on_deleteButton_clicked();
     void on_prevBtn_clicked();
     void on_nextBtn_clicked();
+    void on_searchEdit_returnPressed();
 
 
 private:
-    // return null if nothing was selected
-    wallet::WalletTransaction * getSelectedTransaction();
+    // return false if nothing was selected
+    bool getSelectedTransaction(wallet::WalletTransaction & transaction);
 
     void requestTransactions(QString account);
+    // Search results page that start from position
+    void requestQuery(QString account, int position);
+
+    void appendTransactionRow(const wallet::TransactionColumns::Row & trans, int64_t currentMs);
 
     void updateButtons();
 
@@ -83,12 +89,18 @@ private:
     Ui::Transactions *ui;
     state::Transactions * state;
     QVector<wallet::AccountInfo> accountInfo;
-    QVector<wallet::WalletTransaction> transactions;
+    wallet::TransactionColumns transactions;
     wallet::WalletConfig  walletConfig;
 
     int currentPagePosition = 0; // position at the paging...
     int totalTransactions = 0;
 
+    // Search mode, the table shows the query results page in the query order
+    bool queryMode = false;
+    wallet::TransactionQuery query;
+    int64_t queryRequestId = -1; // results for other requests are ignored
+    bool queryFirstChunk = false; // next result chunk starts the page
+
     QPair<bool,bool> buttonState = QPair<bool,bool>(false, false);
 };
 
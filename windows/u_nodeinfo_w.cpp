@@ -21,6 +21,7 @@
 #include <QScrollBar>
 #include "../state/timeoutlock.h"
 #include "../dialogs/u_mwcnodelogs.h"
+#include "../dialogs/u_tasktimingdlg.h"
 
 namespace wnd {
 
@@ -158,6 +159,14 @@ void NodeInfo::on_showLogsButton_clicked()
     logsDlg.exec();
 }
 
+void NodeInfo::on_taskTimingButton_clicked()
+{
+    state::TimeoutLockObject to( state );
+
+    dlg::TaskTimingDlg timingDlg(this, state->getWallet() );
+    timingDlg.exec();
+}
+
 void NodeInfo::on_changeNodeButton_clicked()
 {
     state::TimeoutLockObject to( state );
@@ -49,6 +49,7 @@ private slots:
     void onShowNodeConnectionError(QString errorMessage);
     void on_showLogsButton_clicked();
     void on_changeNodeButton_clicked();
+    void on_taskTimingButton_clicked();
 
 private:
 signals: